@@ -0,0 +1,180 @@
+# ----------------------------------------------------------------------
+#
+# File: bench_report.py
+#
+# Last edited: 16.10.2026
+#
+# Copyright (c) 2026 ETH Zurich and University of Bologna
+#
+# Authors:
+# - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+#
+# ----------------------------------------------------------------------
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the License); you may
+# not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an AS IS BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+"""Converts the report of the sensorhub acquisition benchmark into JSON for regression tracking.
+
+The firmware prints the report with printk when CONFIG_SENSOR_HUB_BENCH is set (see src_NRF/bench.h). On native_sim
+the script runs the process itself, otherwise pass the captured console output. The RAM and flash footprint is taken
+from the symbols of the application library, without the emulators and replacements of the native_sim build.
+"""
+
+import argparse
+import json
+import re
+import subprocess
+import sys
+import tempfile
+
+BENCH_LINE = re.compile(r"(BENCH_\w+)((?: \S+)*)")
+
+# Objects of src_NRF/sim, not part of the firmware on the board
+SIM_OBJECT = re.compile(r"^(emul_\w+|\w+_sim)\.c\.obj$")
+
+# Symbol types of nm, initialized data occupies flash and RAM
+FLASH_TYPES = set("TtWwRrVv")
+DATA_TYPES = set("DdGg")
+RAM_TYPES = set("BbCSs")
+
+
+def run(exe, timeout):
+    # A fresh working directory keeps the flash file, and with it the saved configuration, of earlier runs away
+    with tempfile.TemporaryDirectory() as cwd:
+        result = subprocess.run([exe, "--no-rt", "--flash_rm"],
+                                cwd=cwd,
+                                capture_output=True,
+                                text=True,
+                                errors="replace",
+                                timeout=timeout)
+    return result.stdout.splitlines()
+
+
+def parse(lines):
+    report = {"cycles": None, "elapsed_ms": 0, "timing_hz": 0, "stages": {}, "i2c": {}, "tasks": {}}
+    done = False
+
+    for line in lines:
+        match = BENCH_LINE.search(line)
+        if match is None:
+            continue
+
+        kind, fields = match.group(1), match.group(2).split()
+        if kind == "BENCH_RUN":
+            report["cycles"], report["elapsed_ms"], report["timing_hz"] = (int(x) for x in fields)
+        elif kind == "BENCH_STAGE":
+            count, mean_cycles, mean_us, p99_us, max_us = (int(x) for x in fields[1:])
+            if count:
+                report["stages"][fields[0]] = {
+                    "count": count,
+                    "mean_cycles": mean_cycles,
+                    "mean_us": mean_us,
+                    "p99_us": p99_us,
+                    "max_us": max_us,
+                }
+        elif kind == "BENCH_I2C":
+            transfers, nacks, written, read = (int(x) for x in fields[1:])
+            report["i2c"][fields[0]] = {
+                "transfers": transfers,
+                "nacks": nacks,
+                "bytes_written": written,
+                "bytes_read": read,
+            }
+        elif kind == "BENCH_TASK":
+            runs, wakeups, overruns = (int(x) for x in fields[1:])
+            report["tasks"][fields[0]] = {"runs": runs, "wakeups": wakeups, "overruns": overruns}
+        elif kind == "BENCH_OUTPUT":
+            records, size, tx_bytes = (int(x) for x in fields)
+            report["output"] = {"records": records, "bytes": size, "tx_bytes": tx_bytes}
+        elif kind == "BENCH_END":
+            done = True
+            break
+
+    if not done or report["cycles"] is None:
+        raise ValueError("No complete benchmark report found")
+
+    # Normalize to one acquisition cycle, the numbers tracked across builds
+    cycles = max(report["cycles"], 1)
+    for stage in report["stages"].values():
+        stage["cycles_per_cycle"] = stage["count"] * stage["mean_cycles"] // cycles
+    for device in report["i2c"].values():
+        device["transfers_per_cycle"] = round(device["transfers"] / cycles, 2)
+        device["bytes_per_cycle"] = round((device["bytes_written"] + device["bytes_read"]) / cycles, 2)
+    report["wakeups_per_cycle"] = round(sum(task["wakeups"] for task in report["tasks"].values()) / cycles, 2)
+    output = report.get("output")
+    if output:
+        output["bytes_per_record"] = round(output["bytes"] / max(output["records"], 1), 2)
+
+    return report
+
+
+def footprint(lib, nm):
+    result = subprocess.run([nm, "--print-size", lib], capture_output=True, text=True, check=True)
+    flash = ram = 0
+    skip = False
+
+    for line in result.stdout.splitlines():
+        if line.endswith(":"):
+            skip = SIM_OBJECT.match(line[:-1]) is not None
+            continue
+
+        fields = line.split()
+        if skip or len(fields) != 4:
+            continue
+
+        size, kind = int(fields[1], 16), fields[2]
+        if kind in FLASH_TYPES:
+            flash += size
+        elif kind in DATA_TYPES:
+            flash += size
+            ram += size
+        elif kind in RAM_TYPES:
+            ram += size
+
+    return {"flash": flash, "ram": ram}
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert the sensorhub benchmark report to JSON")
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("--run", type=str, help="native_sim executable to run")
+    source.add_argument("--log", type=str, help="Captured console output")
+    parser.add_argument("--lib", type=str, help="Application library for the footprint, e.g. build/app/libapp.a")
+    parser.add_argument("--nm", type=str, default="nm", help="nm of the toolchain")
+    parser.add_argument("--timeout", type=int, default=600, help="Limit of the run in s")
+    parser.add_argument("output", type=str, help="Output JSON file")
+    args = parser.parse_args()
+
+    if args.run:
+        lines = run(args.run, args.timeout)
+    else:
+        with open(args.log, "r", errors="replace") as f:
+            lines = f.read().splitlines()
+
+    try:
+        report = parse(lines)
+    except ValueError as e:
+        sys.exit(f"Error: {e}")
+    if args.lib:
+        report["footprint"] = footprint(args.lib, args.nm)
+
+    with open(args.output, "w") as f:
+        json.dump(report, f, indent=2)
+
+    print(f"Wrote {report['cycles']} cycles to {args.output}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,92 @@
+# ----------------------------------------------------------------------
+#
+# File: record_schema.py
+#
+# Last edited: 16.10.2026
+#
+# Copyright (c) 2026 ETH Zurich and University of Bologna
+#
+# Authors:
+# - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+#
+# ----------------------------------------------------------------------
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the License); you may
+# not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an AS IS BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+"""Writes the host schema serial_to_db/record_schema.py from the channel table of the sensorhub firmware.
+
+The build runs src_NRF/record_schema.py.in through the C preprocessor, which expands src_NRF/channels.h for the
+sensors enabled in src_NRF/config.h into a single CHANNELS line. This script writes the module with one channel per
+line. With --check it fails if the committed serial_to_db/record_schema.py differs from the generated one, so a change
+of the channel table or the enable flags cannot leave the host schema behind.
+"""
+
+import argparse
+import ast
+import difflib
+import json
+import sys
+
+DOCSTRING = ('"""Record channels (field, type, column, unit, decimals) of the sensorhub firmware.\n'
+             '\n'
+             'Generated from src_NRF/channels.h by scripts/record_schema.py, refresh with west build -t record_schema_update.\n'
+             '"""\n')
+
+
+def parse(text):
+    """Returns the CHANNELS list of the preprocessed template."""
+    for node in ast.parse(text).body:
+        if isinstance(node, ast.Assign) and [target.id for target in node.targets] == ["CHANNELS"]:
+            return ast.literal_eval(node.value)
+    raise ValueError("no CHANNELS in the preprocessed template")
+
+
+def render(channels):
+    """Formats the channels as a Python module, one tuple per line."""
+    lines = [DOCSTRING, "CHANNELS = ["]
+    for field, kind, column, unit, decimals in channels:
+        values = [json.dumps(field), json.dumps(kind), json.dumps(column), json.dumps(unit), str(decimals)]
+        lines.append(f"    ({', '.join(values)}),")
+    lines.append("]")
+    return "\n".join(lines) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate the host record schema of the sensorhub")
+    parser.add_argument("input", type=str, help="Preprocessed src_NRF/record_schema.py.in")
+    parser.add_argument("output", type=str, help="Output Python module")
+    parser.add_argument("--check", type=str, help="Committed module that has to match the output")
+    args = parser.parse_args()
+
+    with open(args.input, "r") as f:
+        try:
+            schema = render(parse(f.read()))
+        except (SyntaxError, ValueError) as e:
+            sys.exit(f"Error: {e}")
+
+    with open(args.output, "w") as f:
+        f.write(schema)
+
+    if args.check:
+        with open(args.check, "r") as f:
+            committed = f.read()
+        if committed != schema:
+            diff = difflib.unified_diff(committed.splitlines(True), schema.splitlines(True), args.check, args.output)
+            sys.stderr.writelines(diff)
+            sys.exit(f"Error: {args.check} is out of date, copy {args.output} over it")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,112 @@
+# ----------------------------------------------------------------------
+#
+# File: trace2perfetto.py
+#
+# Last edited: 16.10.2026
+#
+# Copyright (c) 2026 ETH Zurich and University of Bologna
+#
+# Authors:
+# - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+#
+# ----------------------------------------------------------------------
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the License); you may
+# not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an AS IS BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Converts the tracepoint dumps of the sensorhub firmware into a Chrome trace file.
+
+The firmware prints the trace buffer with printk when TRACE_ENABLED is set (see src_NRF/trace.h). Capture the
+console output, e.g. with `cat /dev/ttyACM0 > trace.log`, and open the generated JSON file in https://ui.perfetto.dev.
+Every event gets its own track, log lines between the dumps are ignored.
+"""
+
+import argparse
+import json
+import re
+
+TRACE_DUMP = re.compile(r"TRACE_DUMP (\d+) (\d+) (\d+) (\d+) (\d+)")
+TRACE_NAME = re.compile(r"TRACE_NAME (\d+) (\w+)")
+TRACE_ENTRY = re.compile(r"TRACE (\d+) (\d+) (\d+) (\d+)")
+
+# Phases of trace_phase_t
+PHASES = {0: "i", 1: "B", 2: "E"}
+
+
+def parse(lines):
+    names = {}
+    events = []
+    dump = None
+
+    for line in lines:
+        match = TRACE_DUMP.search(line)
+        if match:
+            hz, _, lost, now, uptime = (int(x) for x in match.groups())
+            if lost:
+                print(f"Warning: {lost} entries were overwritten before the dump at {uptime} ms")
+            dump = (hz, now, uptime)
+            continue
+
+        match = TRACE_NAME.search(line)
+        if match:
+            names[int(match.group(1))] = match.group(2)
+            continue
+
+        match = TRACE_ENTRY.search(line)
+        if match is None or dump is None:
+            continue
+
+        cycles, event, phase, arg = (int(x) for x in match.groups())
+        hz, now, uptime = dump
+
+        # Place the entry relative to the uptime of the dump, the modulo unwraps the 32 bit cycle counter
+        age = ((now - cycles) & 0xFFFFFFFF) * 1e6 / hz
+        entry = {
+            "name": names.get(event, str(event)),
+            "ph": PHASES.get(phase, "i"),
+            "ts": uptime * 1e3 - age,
+            "pid": 0,
+            "tid": event,
+            "args": {
+                "arg": arg
+            },
+        }
+        if entry["ph"] == "i":
+            entry["s"] = "t"
+        events.append(entry)
+
+    # Name the tracks after the events
+    for event, name in names.items():
+        events.append({"name": "thread_name", "ph": "M", "pid": 0, "tid": event, "args": {"name": name}})
+    events.append({"name": "process_name", "ph": "M", "pid": 0, "args": {"name": "sensorhub"}})
+
+    return events
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert sensorhub trace dumps to the Chrome trace format")
+    parser.add_argument("input", type=str, help="Captured console output")
+    parser.add_argument("output", type=str, help="Output JSON file")
+    args = parser.parse_args()
+
+    with open(args.input, "r", errors="replace") as f:
+        events = parse(f)
+
+    with open(args.output, "w") as f:
+        json.dump({"traceEvents": events, "displayTimeUnit": "ms"}, f)
+
+    print(f"Wrote {len(events)} events to {args.output}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,176 @@
+"""Decoder for the binary COBS-framed record protocol of the sensorhub firmware.
+
+Frames are COBS encoded and delimited by 0x00 bytes. A decoded frame contains a
+little-endian header (version, type, sequence number), the payload and a
+CRC-16/CCITT-FALSE over header and payload. See src_NRF/proto.h.
+"""
+
+import binascii
+import math
+import struct
+from typing import Dict, List, NamedTuple, Tuple
+
+import record_schema
+import tscodec
+
+PROTO_VERSION = 2
+
+PROTO_TYPE_RECORD = 0x01
+PROTO_TYPE_BACKLOG = 0x02
+PROTO_TYPE_RECORD_BLOCK = 0x03
+PROTO_TYPE_BACKLOG_BLOCK = 0x04
+PROTO_TYPE_STATS = 0x05
+PROTO_TYPE_SCHEMA = 0x06
+PROTO_TYPE_REPLY = 0x07
+
+HEADER = struct.Struct("<BBH")
+CRC = struct.Struct("<H")
+
+# Header of PROTO_TYPE_SCHEMA: firmware hash, layout hash and channel count, see src_NRF/proto.h
+SCHEMA_HEADER = struct.Struct("<IIB")
+
+# Channel types in record_type_t order and their struct format
+TYPES = ("u16", "u32", "f32")
+_FORMAT = {"u16": "H", "u32": "I", "f32": "f"}
+
+# Values of a failed sensor, see RECORD_MISSING_* in src_NRF/record.h. Floats are NaN
+MISSING = {"H": 0xFFFF, "I": 0xFFFFFFFF}
+
+# Payload of PROTO_TYPE_STATS, a stage count followed by the latency summary of every stage
+STATS_STAGE = struct.Struct("<BIIIII")
+
+# Stages in latency_stage_t order, see src_NRF/latency.h
+LATENCY_STAGES: List[str] = [
+    f"{sensor}_{stage}"
+    for sensor in ("SCD41", "SGP41", "ILPS28QSW", "BME688", "BH1730FVC", "AS7331")
+    for stage in ("START", "WAIT", "READ")
+] + ["RECORD", "OUTPUT"]
+
+
+class Frame(NamedTuple):
+    version: int
+    type: int
+    seq: int
+    payload: bytes
+
+
+class Channel(NamedTuple):
+    id: int
+    type: str
+    decimals: int
+    column: str
+    unit: str
+
+
+class Schema:
+    """Record layout of one firmware, from a PROTO_TYPE_SCHEMA frame or the generated record_schema.py."""
+
+    def __init__(self, channels: List[Channel], firmware: int = 0, layout: int = 0) -> None:
+        self.channels = channels
+        self.firmware = firmware
+        self.layout = layout
+        # Payload of PROTO_TYPE_RECORD, sensor_values_t packed in declaration order
+        self.record = struct.Struct("<" + "".join(_FORMAT[channel.type] for channel in channels))
+        self.fields = [channel.column for channel in channels]
+        self.kinds = tscodec.channel_kinds([channel.type for channel in channels])
+
+
+# Layout of the default firmware configuration, used until the device sent its schema
+DEFAULT_SCHEMA = Schema(
+    [
+        Channel(index, kind, decimals, column, unit)
+        for index, (_, kind, column, unit, decimals) in enumerate(record_schema.CHANNELS)
+    ]
+)
+
+
+def cobs_decode(data: bytes) -> bytes:
+    """Decode a COBS encoded block without delimiters."""
+    out = bytearray()
+    idx = 0
+    while idx < len(data):
+        code = data[idx]
+        if code == 0:
+            raise ValueError("unexpected zero byte in COBS data")
+        end = idx + code
+        if end > len(data):
+            raise ValueError("truncated COBS block")
+        out += data[idx + 1 : end]
+        idx = end
+        if code != 0xFF and idx < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def decode_frame(data: bytes) -> Frame:
+    """Decode and verify one frame, with or without the enclosing delimiters."""
+    frame = cobs_decode(data.strip(b"\x00"))
+    if len(frame) < HEADER.size + CRC.size:
+        raise ValueError(f"frame too short ({len(frame)} bytes)")
+
+    (crc,) = CRC.unpack_from(frame, len(frame) - CRC.size)
+    if binascii.crc_hqx(frame[: -CRC.size], 0xFFFF) != crc:
+        raise ValueError("CRC mismatch")
+
+    version, frame_type, seq = HEADER.unpack_from(frame)
+    if version != PROTO_VERSION:
+        raise ValueError(f"unsupported protocol version {version}")
+    return Frame(version, frame_type, seq, frame[HEADER.size : -CRC.size])
+
+
+def decode_record(payload: bytes, schema: Schema = DEFAULT_SCHEMA) -> Tuple[float, ...]:
+    """Unpack a PROTO_TYPE_RECORD or PROTO_TYPE_BACKLOG payload into values in CSV field order."""
+    if len(payload) != schema.record.size:
+        raise ValueError(f"expected {schema.record.size} byte record, got {len(payload)}")
+    return tuple(float(value) for value in schema.record.unpack(payload))
+
+
+def is_missing(index: int, value: float, schema: Schema = DEFAULT_SCHEMA) -> bool:
+    """Check whether a decoded record value is the missing marker of a failed sensor."""
+    kind = schema.record.format[1 + index]
+    if kind == "f":
+        return math.isnan(value)
+    return index > 0 and value == MISSING[kind]
+
+
+def decode_schema(payload: bytes) -> Schema:
+    """Unpack a PROTO_TYPE_SCHEMA payload into the record layout it describes."""
+    if len(payload) < SCHEMA_HEADER.size:
+        raise ValueError(f"invalid schema payload of {len(payload)} bytes")
+    firmware, layout, count = SCHEMA_HEADER.unpack_from(payload)
+    if binascii.crc32(payload[SCHEMA_HEADER.size :]) != layout:
+        raise ValueError("schema layout hash mismatch")
+
+    channels: List[Channel] = []
+    offset = SCHEMA_HEADER.size
+    try:
+        for _ in range(count):
+            channel_id, fmt = payload[offset], payload[offset + 1]
+            column_end = payload.index(0, offset + 2)
+            unit_end = payload.index(0, column_end + 1)
+            channels.append(
+                Channel(
+                    channel_id,
+                    TYPES[fmt >> 4],
+                    fmt & 0x0F,
+                    payload[offset + 2 : column_end].decode(),
+                    payload[column_end + 1 : unit_end].decode(),
+                )
+            )
+            offset = unit_end + 1
+    except (IndexError, ValueError) as exc:
+        raise ValueError(f"truncated schema: {exc}") from exc
+    if not channels or channels[0].column != "Timestamp":
+        raise ValueError("schema does not start with the timestamp")
+    return Schema(channels, firmware, layout)
+
+
+def decode_stats(payload: bytes) -> Dict[str, Dict[str, int]]:
+    """Unpack a PROTO_TYPE_STATS payload into the latency summary in us, keyed by stage name."""
+    if not payload or len(payload) != 1 + payload[0] * STATS_STAGE.size:
+        raise ValueError(f"invalid stats payload of {len(payload)} bytes")
+    stats: Dict[str, Dict[str, int]] = {}
+    for stage, count, min_us, mean_us, p99_us, max_us in STATS_STAGE.iter_unpack(payload[1:]):
+        name = LATENCY_STAGES[stage] if stage < len(LATENCY_STAGES) else f"STAGE_{stage}"
+        stats[name] = {"count": count, "min_us": min_us, "mean_us": mean_us, "p99_us": p99_us, "max_us": max_us}
+    return stats
@@ -0,0 +1,30 @@
+"""Record channels (field, type, column, unit, decimals) of the sensorhub firmware.
+
+Generated from src_NRF/channels.h by scripts/record_schema.py, refresh with west build -t record_schema_update.
+"""
+
+CHANNELS = [
+    ("timestamp", "u32", "Timestamp", "ms", 0),
+    ("scd41_co2", "u16", "SCD41_CO2", "ppm", 0),
+    ("scd41_temperature", "f32", "SCD41_Temperature", "degC", 3),
+    ("scd41_humidity", "f32", "SCD41_Humidity", "%RH", 3),
+    ("sgp41_voc", "u16", "SGP41_VOC", "ticks", 0),
+    ("sgp41_nox", "u16", "SGP41_NOX", "ticks", 0),
+    ("ilps28qsw_pressure", "f32", "ILPS28QSW_Pressure", "hPa", 4),
+    ("ilps28qsw_temperature", "f32", "ILPS28QSW_Temperature", "degC", 2),
+    ("bme688_temperature", "f32", "BME688_Temperature", "degC", 2),
+    ("bme688_pressure", "f32", "BME688_Pressure", "kPa", 3),
+    ("bme688_humidity", "f32", "BME688_Humidity", "%RH", 3),
+    ("bme688_gas_resistance", "f32", "BME688_Gas_Resistance", "Ohm", 0),
+    ("bh1730_visible", "u16", "BH1730FVC_Visible", "counts", 0),
+    ("bh1730_ir", "u16", "BH1730FVC_IR", "counts", 0),
+    ("bh1730_lux", "u32", "BH1730FVC_Lux", "lx", 0),
+    ("as7331_temp", "f32", "AS7331_Temperature", "degC", 2),
+    ("as7331_uva", "u16", "AS7331_UVA", "counts", 0),
+    ("as7331_uvb", "u16", "AS7331_UVB", "counts", 0),
+    ("as7331_uvc", "u16", "AS7331_UVC", "counts", 0),
+    ("max77654_vsys", "u16", "MAX77654_VSYS", "mV", 0),
+    ("max77654_vbat", "u16", "MAX77654_VBAT", "mV", 0),
+    ("max77654_charge", "u32", "MAX77654_Charge", "uC", 0),
+    ("max77654_energy", "u32", "MAX77654_Energy", "uJ", 0),
+]
@@ -1,6 +1,6 @@
 #!/usr/bin/env python3
 
-"""Stream CSV sensor readings from a serial port directly to InfluxDB."""
+"""Stream CSV or binary sensor readings from a serial port directly to InfluxDB."""
 
 import argparse
 import csv
@@ -8,8 +8,8 @@ import logging
 import signal
 import sys
 import time
-from datetime import datetime, timezone
-from typing import Dict, List
+from datetime import datetime, timedelta, timezone
+from typing import Dict, List, Optional, Tuple
 
 import serial
 import configparser
@@ -18,6 +18,9 @@ from pathlib import Path
 import influxdb_client
 from influxdb_client.client.write_api import SYNCHRONOUS
 
+import protocol
+import tscodec
+
 # Load ./config.ini using global path
 _ini_path = Path(__file__).resolve().parent / "config.ini"
 if _ini_path.exists():
@@ -31,28 +34,8 @@ if _ini_path.exists():
 else:
     raise RuntimeError("Configuration file ./config.ini not found!")
 
-# CSV field order, as specified in the sensorhub firmware
-FIELD_ORDER: List[str] = [
-    "Timestamp",
-    "SCD41_CO2",
-    "SCD41_Temperature",
-    "SCD41_Humidity",
-    "SGP41_VOC",
-    "SGP41_NOX",
-    "ILPS28QSW_Pressure",
-    "ILPS28QSW_Temperature",
-    "BME688_Temperature",
-    "BME688_Pressure",
-    "BME688_Humidity",
-    "BME688_Gas_Resistance",
-    "BH1730FVC_Visible",
-    "BH1730FVC_IR",
-    "BH1730FVC_Lux",
-    "AS7331_Temperature",
-    "AS7331_UVA",
-    "AS7331_UVB",
-    "AS7331_UVC",
-]
+# CSV field order of the default firmware configuration, replaced by the header or schema the device sends
+FIELD_ORDER: List[str] = protocol.DEFAULT_SCHEMA.fields
 
 
 def _graceful_shutdown(signum: int, frame) -> None:
@@ -61,22 +44,31 @@ def _graceful_shutdown(signum: int, frame) -> None:
     sys.exit(0)
 
 
-def parse_csv_line(line: str) -> Dict[str, float]:
-    """Convert a CSV line into a dict keyed by FIELD_ORDER."""
+def parse_csv_header(line: str) -> Optional[List[str]]:
+    """Return the columns if the line is the CSV header the device sends on connect, None otherwise."""
+    columns = [column.strip() for column in line.split(",")]
+    return columns if columns[0] == "Timestamp" else None
+
+
+def parse_csv_line(line: str, fields: List[str] = FIELD_ORDER) -> Dict[str, float]:
+    """Convert a CSV line into a dict keyed by the header fields."""
     reader = csv.reader([line], skipinitialspace=True)
     try:
         row = next(reader)
     except StopIteration as exc:
         raise ValueError("empty line") from exc
 
-    if len(row) != len(FIELD_ORDER):
-        raise ValueError(f"expected {len(FIELD_ORDER)} values, got {len(row)}")
+    if len(row) != len(fields):
+        raise ValueError(f"expected {len(fields)} values, got {len(row)}")
 
     parsed: Dict[str, float] = {}
-    for key, raw_value in zip(FIELD_ORDER, row):
+    for key, raw_value in zip(fields, row):
         value = raw_value.strip()
         if not value:
-            raise ValueError(f"missing value for {key}")
+            # Empty fields belong to a failed sensor, the point is written without them
+            if key == "Timestamp":
+                raise ValueError(f"missing value for {key}")
+            continue
         if key == "Timestamp":
             parsed[key] = float(int(float(value)))
             continue
@@ -84,8 +76,35 @@ def parse_csv_line(line: str) -> Dict[str, float]:
     return parsed
 
 
-def build_point(measurement: str, values: Dict[str, float]) -> dict:
-    """Create an InfluxDB point dictionary from sensor values."""
+def parse_frame(
+    data: bytes, last_seq: Optional[int], schema: protocol.Schema = protocol.DEFAULT_SCHEMA
+) -> Tuple[protocol.Frame, List[Dict[str, float]]]:
+    """Convert a binary frame into dicts keyed by the fields of the schema.
+
+    Returns the frame and its records, oldest first. Frames that carry no record return an empty list.
+    """
+    frame = protocol.decode_frame(data)
+    if last_seq is not None and frame.seq != (last_seq + 1) & 0xFFFF:
+        logging.warning("Lost %d frame(s)", (frame.seq - last_seq - 1) & 0xFFFF)
+    if frame.type in (protocol.PROTO_TYPE_RECORD, protocol.PROTO_TYPE_BACKLOG):
+        rows = [protocol.decode_record(frame.payload, schema)]
+    elif frame.type in (protocol.PROTO_TYPE_RECORD_BLOCK, protocol.PROTO_TYPE_BACKLOG_BLOCK):
+        rows = tscodec.decode_block(frame.payload, schema.kinds)
+    else:
+        rows = []
+    # Fields of a failed sensor are dropped like empty CSV fields
+    return frame, [
+        {
+            key: value
+            for index, (key, value) in enumerate(zip(schema.fields, row))
+            if not protocol.is_missing(index, value, schema)
+        }
+        for row in rows
+    ]
+
+
+def build_point(measurement: str, values: Dict[str, float], timestamp: Optional[datetime] = None) -> dict:
+    """Create an InfluxDB point dictionary from sensor values, stamped with the current time by default."""
     fields = {}
     
     # Add all fields except Timestamp
@@ -99,7 +118,7 @@ def build_point(measurement: str, values: Dict[str, float]) -> dict:
     
     return {
         "measurement": measurement,
-        "time": datetime.now(timezone.utc),
+        "time": timestamp if timestamp is not None else datetime.now(timezone.utc),
         "fields": fields
     }
 
@@ -131,16 +150,145 @@ def run(args: argparse.Namespace) -> None:
         # Flush any existing input
         ser.reset_input_buffer()
 
+        # Runtime configuration commands, the replies are logged as they arrive with the records
+        for command in args.command:
+            logging.info("Sending command: %s", command)
+            ser.write(f"{command}\n".encode())
+
+        def write_point(values: Dict[str, float], timestamp: Optional[datetime] = None) -> None:
+            # Build InfluxDB point
+            point = build_point(measurement, values, timestamp)
+            # Write point to InfluxDB
+            try:
+                write_api.write(bucket=bucket, org=org, record=point)
+                logging.debug("Written point to InfluxDB")
+            except Exception as exc:
+                logging.error("Failed to write to InfluxDB: %s", exc)
+
+        def write_stats(payload: bytes) -> None:
+            # Latency summary of the acquisition stages, one point per stage
+            try:
+                stats = protocol.decode_stats(payload)
+            except ValueError as exc:
+                logging.warning("Discarding stats frame: %s", exc)
+                return
+            now = datetime.now(timezone.utc)
+            points = [
+                {"measurement": f"{measurement}_latency", "tags": {"stage": stage}, "time": now, "fields": fields}
+                for stage, fields in stats.items()
+                if fields["count"]
+            ]
+            try:
+                write_api.write(bucket=bucket, org=org, record=points)
+            except Exception as exc:
+                logging.error("Failed to write latency to InfluxDB: %s", exc)
+            slowest = max(stats.items(), key=lambda item: item[1]["p99_us"])
+            logging.info("Latency summary received, slowest stage %s (p99 %d us)", slowest[0], slowest[1]["p99_us"])
+
+        def write_relative(records: List[Dict[str, float]], ref_ms: float, ref_time: datetime) -> int:
+            # The device timestamps are uptime in ms, records from before a device reset cannot be placed
+            skipped = 0
+            for values in records:
+                age_ms = ref_ms - values["Timestamp"]
+                if age_ms < 0:
+                    skipped += 1
+                    continue
+                write_point(values, ref_time - timedelta(milliseconds=age_ms))
+            return skipped
+
         with ser:
+            # ------------- BINARY LOOP -------------
+            if args.binary:
+                pending = bytearray()
+                last_seq: Optional[int] = None
+                # Records from the flash log of the device, held back until a live record relates
+                # the device uptime to the wall clock
+                backlog: List[Dict[str, float]] = []
+                # Layout of the connected firmware, the device sends its schema when the port is opened
+                schema = protocol.DEFAULT_SCHEMA
+                while True:
+                    # Read up to and including the next frame delimiter
+                    try:
+                        chunk = ser.read_until(b"\x00")
+                    except (serial.SerialException, OSError) as exc:
+                        logging.error("Serial port error: %s", exc)
+                        sys.exit(1)
+                    if not chunk:
+                        time.sleep(args.idle_sleep)
+                        continue
+                    pending += chunk
+                    if not chunk.endswith(b"\x00"):
+                        continue
+
+                    data = bytes(pending[:-1])
+                    pending.clear()
+                    if not data:
+                        continue
+
+                    # Text on the port (e.g. log messages) fails the CRC check and is dropped
+                    try:
+                        frame, records = parse_frame(data, last_seq, schema)
+                    except ValueError as exc:
+                        logging.debug("Discarding invalid frame: %s", exc)
+                        continue
+                    last_seq = frame.seq
+                    if frame.type == protocol.PROTO_TYPE_SCHEMA:
+                        try:
+                            received = protocol.decode_schema(frame.payload)
+                        except ValueError as exc:
+                            logging.warning("Discarding schema frame: %s", exc)
+                            continue
+                        if received.layout != schema.layout or received.firmware != schema.firmware:
+                            logging.info(
+                                "Schema of firmware %08x received, layout %08x with %d channels",
+                                received.firmware,
+                                received.layout,
+                                len(received.channels),
+                            )
+                        schema = received
+                        continue
+                    if frame.type == protocol.PROTO_TYPE_STATS:
+                        write_stats(frame.payload)
+                        continue
+                    if frame.type == protocol.PROTO_TYPE_REPLY:
+                        for line in frame.payload.decode(errors="replace").splitlines():
+                            logging.info("Device: %s", line)
+                        continue
+                    if not records:
+                        continue
+
+                    if frame.type in (protocol.PROTO_TYPE_BACKLOG, protocol.PROTO_TYPE_BACKLOG_BLOCK):
+                        backlog.extend(records)
+                        continue
+
+                    # The newest live record was sent just now
+                    now = datetime.now(timezone.utc)
+                    live_ms = records[-1]["Timestamp"]
+                    if backlog:
+                        skipped = write_relative(backlog, live_ms, now)
+                        logging.info("Wrote %d backlog records", len(backlog) - skipped)
+                        if skipped:
+                            logging.warning("Skipped %d backlog records recorded before a device reset", skipped)
+                        backlog.clear()
+                    write_relative(records, live_ms, now)
+
             # Keep reading until we find a valid CSV line with correct field count
+            # The device sends its CSV header when the port is opened and periodically, the default field order only
+            # applies until the first header
+            fields = FIELD_ORDER
             if args.skip_header:
                 logging.info("Skipping until first valid CSV line is found...")
                 while True:
                     raw = ser.readline().decode(errors="ignore").strip()
-                    if not raw:
+                    if not raw or raw.startswith("#"):
                         continue
+                    header = parse_csv_header(raw)
+                    if header:
+                        fields = header
+                        logging.info("Found CSV header with %d columns, starting data collection", len(fields))
+                        break
                     try:
-                        parse_csv_line(raw)
+                        parse_csv_line(raw, fields)
                         logging.info("Found first valid CSV line, starting data collection")
                         break
                     except ValueError:
@@ -164,20 +312,25 @@ def run(args: argparse.Namespace) -> None:
                 # [DEBUG] Log the full CSV line for troubleshooting
                 logging.debug("CSV line: %s", raw)
 
+                # Replies to commands are sent as comment lines
+                if raw.startswith("#"):
+                    logging.info("Device: %s", raw[1:].strip())
+                    continue
+
+                header = parse_csv_header(raw)
+                if header:
+                    if header != fields:
+                        logging.info("CSV header with %d columns received", len(header))
+                    fields = header
+                    continue
+
                 # Parse CSV line
                 try:
-                    values = parse_csv_line(raw)
+                    values = parse_csv_line(raw, fields)
                 except ValueError as exc:
                     logging.warning("Discarding malformed line: %s", exc)
                     continue
-                # Build InfluxDB point
-                point = build_point(measurement, values)
-                # Write point to InfluxDB
-                try:
-                    write_api.write(bucket=bucket, org=org, record=point)
-                    logging.debug("Written point to InfluxDB")
-                except Exception as exc:
-                    logging.error("Failed to write to InfluxDB: %s", exc)
+                write_point(values)
     finally:
         # Close the InfluxDB client created above
         try:
@@ -193,7 +346,18 @@ def build_arg_parser() -> argparse.ArgumentParser:
     parser.add_argument("serial_port", help="Serial device to read from, e.g. /dev/ttyUSB0")
     parser.add_argument("--baudrate", type=int, default=115200, help="Serial port baud rate")
     parser.add_argument("--serial-timeout", type=float, default=1.0, help="Serial read timeout in seconds")
-    parser.add_argument("--skip-header", action="store_true", help="Skip the first header line")
+    parser.add_argument(
+        "--skip-header", action="store_true", help="Skip lines until the first CSV header or valid CSV line"
+    )
+    parser.add_argument(
+        "--binary", action="store_true", help="Decode COBS-framed binary records instead of CSV lines"
+    )
+    parser.add_argument(
+        "--command",
+        action="append",
+        default=[],
+        help="Runtime configuration command sent on connect, e.g. 'config set sampling_time 10000', repeatable",
+    )
     parser.add_argument("--idle-sleep", type=float, default=0.1, help="Sleep duration when no data is available")
     
     parser.add_argument(
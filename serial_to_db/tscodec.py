@@ -0,0 +1,102 @@
+"""Decoder for the time-series compressed record blocks of the sensorhub firmware.
+
+Mirrors src_NRF/tscodec.c, see src_NRF/tscodec.h for the block format.
+"""
+
+import struct
+from typing import List, Sequence, Tuple
+
+import record_schema
+
+# Channel kinds in the declaration order of sensor_values_t, the timestamp is handled separately
+_INT = 0
+_FLOAT = 1
+
+
+def channel_kinds(types: Sequence[str]) -> Tuple[int, ...]:
+    """Channel kinds of the record channel types ("u16", "u32" or "f32"), including the timestamp."""
+    return tuple(_FLOAT if kind == "f32" else _INT for kind in types[1:])
+
+
+# Layout of the default firmware configuration, used until the device sent its schema
+CHANNELS = channel_kinds([channel[1] for channel in record_schema.CHANNELS])
+
+HEADER = struct.Struct("<H")
+_U32 = 0xFFFFFFFF
+
+
+class _Bits:
+    def __init__(self, data: bytes, bit: int) -> None:
+        self.data = data
+        self.bit = bit
+
+    def get(self, n: int) -> int:
+        if self.bit + n > len(self.data) * 8:
+            raise ValueError("truncated block")
+        value = 0
+        for _ in range(n):
+            value = (value << 1) | ((self.data[self.bit >> 3] >> (7 - (self.bit & 7))) & 1)
+            self.bit += 1
+        return value
+
+    def varint(self) -> int:
+        value = 0
+        for shift in range(0, 35, 7):
+            group = self.get(8)
+            value |= (group & 0x7F) << shift
+            if not group & 0x80:
+                break
+        return value & _U32
+
+
+def _zigzag(value: int) -> int:
+    return (value >> 1) ^ -(value & 1)
+
+
+def decode_block(block: bytes, channels: Sequence[int] = CHANNELS) -> List[Tuple[float, ...]]:
+    """Decode a block into records with values in CSV field order, channels as of channel_kinds()."""
+    if len(block) < HEADER.size:
+        raise ValueError("block too short")
+    (count,) = HEADER.unpack_from(block)
+    bits = _Bits(block, HEADER.size * 8)
+
+    timestamp = 0
+    delta = 0
+    values = [0] * len(channels)
+    leading = [0] * len(channels)
+    trailing = [0] * len(channels)
+    records = []
+
+    for index in range(count):
+        if index == 0:
+            timestamp = bits.get(32)
+        else:
+            if index == 1:
+                delta = _zigzag(bits.varint())
+            else:
+                for width in (0, 7, 9, 12):
+                    if bits.get(1) == 0:
+                        break
+                else:
+                    width = 32
+                delta += _zigzag(bits.get(width)) if width else 0
+            timestamp = (timestamp + delta) & _U32
+
+        record = [float(timestamp)]
+        for ch, kind in enumerate(channels):
+            if kind == _INT:
+                if bits.get(1):
+                    values[ch] = (values[ch] + _zigzag(bits.varint())) & _U32
+                record.append(float(values[ch]))
+                continue
+
+            if bits.get(1):
+                if bits.get(1):
+                    leading[ch] = bits.get(5)
+                    trailing[ch] = 32 - leading[ch] - (bits.get(5) + 1)
+                length = 32 - leading[ch] - trailing[ch]
+                values[ch] ^= bits.get(length) << trailing[ch]
+            (value,) = struct.unpack("<f", struct.pack("<I", values[ch]))
+            record.append(value)
+        records.append(tuple(record))
+    return records
@@ -0,0 +1,167 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: adapt.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#include <math.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+
+#include "adapt.h"
+#include "config.h"
+#include "fmt.h"
+
+static adapt_channel_t *adapt_channels[ADAPT_MAX_CHANNELS];
+static size_t adapt_count = 0;
+
+static float adapt_value(const sensor_values_t *values, const adapt_channel_t *channel) {
+  const uint8_t *field = (const uint8_t *)values + channel->offset;
+  uint16_t u16;
+  uint32_t u32;
+  float f32;
+
+  switch (channel->kind) {
+  case ADAPT_U16:
+    memcpy(&u16, field, sizeof(u16));
+    return u16;
+  case ADAPT_U32:
+    memcpy(&u32, field, sizeof(u32));
+    return u32;
+  default:
+    memcpy(&f32, field, sizeof(f32));
+    return f32;
+  }
+}
+
+/**
+ * @brief Starts the channels of a sensor with the given period and adds them to the `adapt` shell command.
+ *
+ */
+void adapt_init(adapt_channel_t *channels, size_t count, uint32_t period_ms) {
+  for (size_t i = 0; i < count; i++) {
+    adapt_channel_t *channel = &channels[i];
+
+    channel->valid = false;
+    channel->period_ms = CLAMP(period_ms, channel->min_ms, channel->max_ms);
+
+    __ASSERT(adapt_count < ADAPT_MAX_CHANNELS, "Increase ADAPT_MAX_CHANNELS");
+    if (adapt_count < ADAPT_MAX_CHANNELS) {
+      adapt_channels[adapt_count++] = channel;
+    }
+  }
+}
+
+/**
+ * @brief Returns the period of a sensor, the shortest period of its channels.
+ *
+ */
+uint32_t adapt_period(const adapt_channel_t *channels, size_t count) {
+  uint32_t period_ms = UINT32_MAX;
+
+  for (size_t i = 0; i < count; i++) {
+    period_ms = MIN(period_ms, channels[i].period_ms);
+  }
+  return period_ms;
+}
+
+/**
+ * @brief Adds a new sample of a sensor to its channels.
+ *
+ * The mean and mean deviation are smoothed like the estimator in predict.c, so a single outlier raises the deviation
+ * only by a quarter of its error.
+ *
+ * @param channels Channels of the sensor
+ * @param count Number of channels
+ * @param values Record holding the new sample
+ * @param now_ms Time of the sample
+ * @return New period of the sensor in ms
+ */
+uint32_t adapt_update(adapt_channel_t *channels, size_t count, const sensor_values_t *values, uint32_t now_ms) {
+  for (size_t i = 0; i < count; i++) {
+    adapt_channel_t *channel = &channels[i];
+    float value = adapt_value(values, channel);
+
+    if (!isfinite(value)) {
+      continue;
+    }
+    if (!channel->valid) {
+      channel->last = value;
+      channel->mean = value;
+      channel->mdev = 0.0f;
+      channel->last_ms = now_ms;
+      channel->valid = true;
+      continue;
+    }
+
+    uint32_t elapsed_ms = MAX(now_ms - channel->last_ms, 1);
+    float error = value - channel->mean;
+
+    channel->last_rate = fabsf(value - channel->last) * 1000.0f / elapsed_ms;
+    channel->mean += error / 4;
+    channel->mdev += (fabsf(error) - channel->mdev) / 4;
+    channel->last = value;
+    channel->last_ms = now_ms;
+    channel->samples++;
+
+    if (channel->last_rate > channel->rate || channel->mdev > channel->dev) {
+      channel->period_ms = channel->min_ms;
+      channel->active++;
+    } else {
+      channel->period_ms = MIN(channel->period_ms * 2, channel->max_ms);
+    }
+  }
+  return adapt_period(channels, count);
+}
+
+#if defined(CONFIG_SHELL)
+static int cmd_adapt(const struct shell *sh, size_t argc, char **argv) {
+  ARG_UNUSED(argc);
+  ARG_UNUSED(argv);
+
+  shell_print(sh, "%-22s %8s %8s %8s %10s %10s %10s %10s %7s", "Channel", "Period", "Min", "Max", "Rate [/s]",
+              "Threshold", "Deviation", "Threshold", "Active");
+  for (size_t i = 0; i < adapt_count; i++) {
+    const adapt_channel_t *channel = adapt_channels[i];
+    uint32_t active_pct = channel->samples ? channel->active * 100 / channel->samples : 0;
+    const float values[] = {channel->last_rate, channel->rate, channel->mdev, channel->dev};
+    char text[ARRAY_SIZE(values)][FMT_FIXED_MAX_LEN + 1];
+
+    // fmt_fixed() instead of %f, the float printf is not part of the default build
+    for (size_t j = 0; j < ARRAY_SIZE(values); j++) {
+      fmt_fixed_str(text[j], values[j], 3);
+    }
+    shell_print(sh, "%-22s %8u %8u %8u %10s %10s %10s %10s %5u %%", channel->name, channel->period_ms,
+                channel->min_ms, channel->max_ms, text[0], text[1], text[2], text[3], active_pct);
+  }
+  return 0;
+}
+
+SHELL_CMD_REGISTER(adapt, NULL, "Print the sampling period and the activity of the adaptive channels", cmd_adapt);
+#endif
@@ -0,0 +1,85 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: adapt.h
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef ADAPT_H
+#define ADAPT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "record.h"
+
+/*
+ * Adaptive sampling
+ *
+ * Every watched channel of a sensor chooses its own sampling period from its recent dynamics. A channel is active
+ * when its rate of change since the previous sample or its mean deviation from the smoothed value exceeds the
+ * thresholds of the channel. An active channel drops to its shortest period, a stable one doubles its period after
+ * every sample up to its longest period. A sensor is sampled with the shortest period of its channels.
+ */
+
+typedef enum {
+  ADAPT_U16,
+  ADAPT_U32,
+  ADAPT_F32,
+} adapt_kind_t;
+
+typedef struct {
+  const char *name;
+  uint16_t offset; // Field of sensor_values_t
+  uint8_t kind;
+  float rate;      // Change per second that counts as activity
+  float dev;       // Mean deviation that counts as activity
+  uint32_t min_ms; // Period while the channel is active
+  uint32_t max_ms; // Period the stable channel backs off to
+
+  // State
+  bool valid;
+  float last;
+  float mean;
+  float mdev;
+  float last_rate; // Rate of change at the last sample, per second
+  uint32_t last_ms;
+  uint32_t period_ms;
+
+  // Statistics
+  uint32_t samples;
+  uint32_t active; // Samples that found the channel active
+} adapt_channel_t;
+
+// Bounds are given as rate, deviation, shortest and longest period, see ADAPT_* in config.h
+#define ADAPT_CHANNEL_INIT(...) {__VA_ARGS__}
+#define ADAPT_CHANNEL(field, kind, bounds) ADAPT_CHANNEL_INIT(#field, offsetof(sensor_values_t, field), kind, bounds)
+
+void adapt_init(adapt_channel_t *channels, size_t count, uint32_t period_ms);
+uint32_t adapt_update(adapt_channel_t *channels, size_t count, const sensor_values_t *values, uint32_t now_ms);
+uint32_t adapt_period(const adapt_channel_t *channels, size_t count);
+
+#endif /* ADAPT_H */
@@ -0,0 +1,186 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: bench.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <errno.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+#include "bench.h"
+#include "fmt.h"
+#include "latency.h"
+#include "proto.h"
+#include "tscodec.h"
+#include "uart_tx.h"
+
+#if defined(CONFIG_EMUL)
+#include "emul_sensor.h"
+#endif
+#if defined(CONFIG_ARCH_POSIX)
+#include "posix_board_if.h"
+#endif
+
+#if BENCH_ENABLED
+
+static uint32_t bench_cycles = 0;
+static uint32_t bench_bytes = 0;
+static int64_t bench_start_ms = 0;
+
+// Scratch buffer of the encoded records, the bytes are only counted
+static uint8_t bench_frame[OUTPUT_TX_BUFFER_SIZE];
+
+#if OUTPUT_FORMAT == OUTPUT_FORMAT_BINARY && OUTPUT_COMPRESS
+static uint8_t bench_block[PROTO_MAX_PAYLOAD];
+static tscodec_t bench_enc;
+
+// Size of the frame output_flush() sends for the collected block
+static size_t bench_flush(void) {
+  size_t len;
+
+  if (bench_enc.count == 0) {
+    return 0;
+  }
+  len = tscodec_finish(&bench_enc);
+  len = proto_frame(PROTO_TYPE_RECORD_BLOCK, bench_block, len, bench_frame);
+  tscodec_init(&bench_enc, bench_block, sizeof(bench_block));
+  return len;
+}
+#else
+static size_t bench_flush(void) { return 0; }
+#endif
+
+/**
+ * @brief Returns the bytes output_emit() sends for a record.
+ *
+ * Compressed records are collected in blocks of OUTPUT_BATCH_SIZE, the size of a block is counted when it is full.
+ */
+static size_t bench_encode(const sensor_values_t *record) {
+#if OUTPUT_FORMAT == OUTPUT_FORMAT_BINARY && OUTPUT_COMPRESS
+  size_t len = 0;
+
+  if (tscodec_encode(&bench_enc, record) == -ENOSPC) {
+    len = bench_flush();
+    tscodec_encode(&bench_enc, record);
+  }
+  if (bench_enc.count >= OUTPUT_BATCH_SIZE) {
+    len += bench_flush();
+  }
+  return len;
+#elif OUTPUT_FORMAT == OUTPUT_FORMAT_BINARY
+  uint8_t payload[PROTO_RECORD_SIZE];
+
+  return proto_frame(PROTO_TYPE_RECORD, payload, proto_pack_record(record, payload), bench_frame);
+#elif OUTPUT_CSV_FIXED_POINT
+  return fmt_record_csv((char *)bench_frame, record);
+#else
+  return MIN(fmt_record_printf((char *)bench_frame, sizeof(bench_frame), record), sizeof(bench_frame) - 1);
+#endif
+}
+
+/**
+ * @brief Clears the counters, called right before the scheduler releases the first period.
+ *
+ */
+void bench_start(void) {
+  bench_cycles = 0;
+  bench_bytes = 0;
+  bench_start_ms = k_uptime_get();
+#if OUTPUT_FORMAT == OUTPUT_FORMAT_BINARY && OUTPUT_COMPRESS
+  tscodec_init(&bench_enc, bench_block, sizeof(bench_block));
+#endif
+  latency_reset();
+#if defined(CONFIG_EMUL)
+  emul_i2c_stats_reset();
+#endif
+}
+
+/**
+ * @brief Accounts a record, called by the record task once per cycle.
+ *
+ * @return Whether BENCH_CYCLES records have been emitted and the acquisition can stop
+ */
+bool bench_record(const sensor_values_t *record) {
+  if (bench_cycles >= BENCH_CYCLES) {
+    return true;
+  }
+  bench_bytes += bench_encode(record);
+  bench_cycles++;
+  return bench_cycles >= BENCH_CYCLES;
+}
+
+/**
+ * @brief Prints the report of the stopped acquisition.
+ *
+ *   BENCH_RUN cycles elapsed_ms timing_hz
+ *   BENCH_STAGE stage count mean_cycles mean_us p99_us max_us
+ *   BENCH_I2C device transfers nacks bytes_written bytes_read
+ *   BENCH_TASK task runs wakeups overruns
+ *   BENCH_OUTPUT records bytes tx_bytes
+ *   BENCH_END
+ *
+ * @param tasks Scheduled tasks, must be stopped
+ * @param count Number of tasks
+ */
+void bench_report(sched_task_t *const *tasks, size_t count) {
+  bench_bytes += bench_flush();
+
+  printk("BENCH_RUN %u %u %u\n", bench_cycles, (uint32_t)(k_uptime_get() - bench_start_ms),
+         (uint32_t)timing_freq_get());
+#if LATENCY_ENABLED
+  latency_summary_t summary;
+
+  for (size_t i = 0; i < LATENCY_STAGE_COUNT; i++) {
+    latency_summarize(i, &summary);
+    printk("BENCH_STAGE %s %u %u %u %u %u\n", latency_name(i), summary.count, summary.mean_cycles, summary.mean_us,
+           summary.p99_us, summary.max_us);
+  }
+#endif
+#if defined(CONFIG_EMUL)
+  size_t devices;
+  const emul_i2c_stats_t *i2c = emul_i2c_stats(&devices);
+
+  for (size_t i = 0; i < devices; i++) {
+    printk("BENCH_I2C %s %u %u %u %u\n", i2c[i].target->dev->name, i2c[i].transfers, i2c[i].nacks,
+           i2c[i].bytes_written, i2c[i].bytes_read);
+  }
+#endif
+  for (size_t i = 0; i < count; i++) {
+    const sched_stats_t *stats = &tasks[i]->stats;
+
+    printk("BENCH_TASK %s %u %u %u\n", tasks[i]->name, stats->runs, stats->wakeups, stats->overruns);
+  }
+  printk("BENCH_OUTPUT %u %u %u\n", bench_cycles, bench_bytes, uart_tx_stats()->bytes);
+  printk("BENCH_END\n");
+
+#if defined(CONFIG_ARCH_POSIX)
+  posix_exit(0);
+#endif
+}
+
+#endif
@@ -0,0 +1,63 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: bench.h
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "config.h"
+#include "record.h"
+#include "sched.h"
+
+/*
+ * Acquisition benchmark
+ *
+ * Runs BENCH_CYCLES records of the regular acquisition and prints a report for regression tracking. A cycle is one
+ * record period. The report covers:
+ *  - the timing counter cycles and durations of every stage, see latency.h
+ *  - the I2C transfers, NACKs and payload bytes of every device, only on the emulators, see sim/emul_sensor.h
+ *  - the wakeups of the scheduled tasks per cycle, runs plus the ready polls
+ *  - the bytes per record in the configured OUTPUT_FORMAT, encoded as the output thread sends them to a host
+ *
+ * The report is printed with printk as lines starting with BENCH, scripts/bench_report.py converts them to JSON and
+ * adds the RAM and flash footprint of the application. On native_sim the process exits after the report.
+ */
+
+#if BENCH_ENABLED
+void bench_start(void);
+bool bench_record(const sensor_values_t *record);
+void bench_report(sched_task_t *const *tasks, size_t count);
+#else
+static inline void bench_start(void) {}
+static inline bool bench_record(const sensor_values_t *record) { return false; }
+static inline void bench_report(sched_task_t *const *tasks, size_t count) {}
+#endif
+
+#endif /* BENCH_H */
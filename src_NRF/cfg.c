@@ -0,0 +1,378 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: cfg.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/atomic.h>
+
+#include <zephyr/logging/log.h>
+
+#include "cfg.h"
+#include "config.h"
+
+#include "bh1730fvc_sensor.h"
+
+LOG_MODULE_REGISTER(cfg, LOG_LEVEL_INF);
+
+#define CFG_SUBTREE "cfg"
+
+typedef struct {
+  const char *unit;
+  uint32_t def;
+  uint32_t min;
+  uint32_t max;
+  const uint32_t *allowed; // Valid values if not NULL, min and max are ignored
+  size_t allowed_count;
+} cfg_param_t;
+
+#define CFG_PARAM_NAME(id, name) #name,
+static const char *const cfg_names[] = {CFG_PARAMS(CFG_PARAM_NAME)};
+#undef CFG_PARAM_NAME
+
+// Settings supported by the sensors, see the configure_*() functions
+static const uint32_t bh1730_gains[] = {1, 2, 64, 128};
+static const uint32_t ilps28qsw_odrs[] = {1, 4, 10, 25, 50, 75, 100, 200};
+static const uint32_t ilps28qsw_avgs[] = {4, 8, 16, 32, 64, 128, 256, 512};
+
+#define CFG_ALLOWED(list) .allowed = list, .allowed_count = ARRAY_SIZE(list)
+
+static const cfg_param_t cfg_params[CFG_COUNT] = {
+    [CFG_SAMPLING_TIME] = {.unit = "ms", .def = SAMPLING_TIME, .min = SAMPLING_TIME_MIN, .max = SAMPLING_TIME_MAX},
+    [CFG_BH1730_GAIN] = {.unit = "x", .def = BH1730_GAIN, CFG_ALLOWED(bh1730_gains)},
+    [CFG_BH1730_INT] = {.unit = "ITIME", .def = BH1730_INT, .min = 0, .max = UINT8_MAX},
+    [CFG_AS7331_GAIN] = {.unit = "2^(11-n)", .def = AS7331_GAIN, .min = 0, .max = 11},
+    [CFG_AS7331_TIME] = {.unit = "2^n ms", .def = AS7331_TIME, .min = 0, .max = 15},
+    [CFG_ILPS28QSW_ODR] = {.unit = "Hz", .def = ILPS28QSW_ODR, CFG_ALLOWED(ilps28qsw_odrs)},
+    [CFG_ILPS28QSW_AVG] = {.unit = "samples", .def = ILPS28QSW_AVG, CFG_ALLOWED(ilps28qsw_avgs)},
+};
+
+static uint32_t cfg_values[CFG_COUNT];
+
+// One bit per parameter, set on a change and cleared by the task applying it
+static atomic_t cfg_changed = ATOMIC_INIT(0);
+
+static bool cfg_valid(cfg_id_t id, uint32_t value) {
+  const cfg_param_t *param = &cfg_params[id];
+
+  if (param->allowed == NULL) {
+    return value >= param->min && value <= param->max;
+  }
+  for (size_t i = 0; i < param->allowed_count; i++) {
+    if (param->allowed[i] == value) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static int cfg_find(const char *name) {
+  for (size_t i = 0; i < CFG_COUNT; i++) {
+    if (strcmp(name, cfg_names[i]) == 0) {
+      return i;
+    }
+  }
+  return -ENOENT;
+}
+
+static int cfg_settings_set(const char *key, size_t len, settings_read_cb read_cb, void *cb_arg) {
+  const char *next;
+  uint32_t value;
+  int rc;
+
+  for (size_t i = 0; i < CFG_COUNT; i++) {
+    if (!settings_name_steq(key, cfg_names[i], &next) || next) {
+      continue;
+    }
+    if (len != sizeof(value)) {
+      return -EINVAL;
+    }
+    rc = read_cb(cb_arg, &value, sizeof(value));
+    if (rc < 0) {
+      return rc;
+    }
+    // Values stored by an older firmware may no longer be supported
+    if (!cfg_valid(i, value)) {
+      LOG_WRN("Ignoring stored %s %u", cfg_names[i], value);
+      return 0;
+    }
+    cfg_values[i] = value;
+    return 0;
+  }
+  return -ENOENT;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(cfg, CFG_SUBTREE, NULL, cfg_settings_set, NULL, NULL);
+
+/**
+ * @brief Loads the stored configuration, parameters that were never saved keep their default.
+ *
+ * Must be called before the sensors are configured.
+ */
+int cfg_init(void) {
+  int rc;
+
+  for (size_t i = 0; i < CFG_COUNT; i++) {
+    cfg_values[i] = cfg_params[i].def;
+  }
+
+  rc = settings_subsys_init();
+  if (rc == 0) {
+    rc = settings_load_subtree(CFG_SUBTREE);
+  }
+  if (rc != 0) {
+    LOG_WRN("Error %d loading the stored configuration, using defaults", rc);
+  }
+
+  for (size_t i = 0; i < CFG_COUNT; i++) {
+    if (cfg_values[i] != cfg_params[i].def) {
+      LOG_INF(" - %-16s: %u %s (stored)", cfg_names[i], cfg_values[i], cfg_params[i].unit);
+    }
+  }
+
+  atomic_clear(&cfg_changed);
+  return rc;
+}
+
+uint32_t cfg_get(cfg_id_t id) { return cfg_values[id]; }
+
+/**
+ * @brief Changes a parameter, the owning task applies it at the start of its next period.
+ *
+ * @return 0 on success, -EINVAL if the value is not supported
+ */
+int cfg_set(cfg_id_t id, uint32_t value) {
+  if (!cfg_valid(id, value)) {
+    return -EINVAL;
+  }
+  cfg_values[id] = value;
+  atomic_set_bit(&cfg_changed, id);
+  return 0;
+}
+
+/**
+ * @brief Clears the change flags of the parameters in mask.
+ *
+ * @param mask Bits of cfg_id_t
+ * @return true if any of them changed since the last call
+ */
+bool cfg_take(uint32_t mask) { return (atomic_and(&cfg_changed, ~mask) & mask) != 0; }
+
+/**
+ * @brief Stores all parameters on the settings_storage partition.
+ *
+ */
+int cfg_save(void) {
+  char key[32];
+  int rc;
+
+  for (size_t i = 0; i < CFG_COUNT; i++) {
+    snprintk(key, sizeof(key), CFG_SUBTREE "/%s", cfg_names[i]);
+    rc = settings_save_one(key, &cfg_values[i], sizeof(cfg_values[i]));
+    if (rc != 0) {
+      LOG_ERR("Error %d storing %s", rc, key);
+      return rc;
+    }
+  }
+  return 0;
+}
+
+/**
+ * @brief Restores the defaults and removes the stored values.
+ *
+ */
+void cfg_reset(void) {
+  char key[32];
+
+  for (size_t i = 0; i < CFG_COUNT; i++) {
+    cfg_set(i, cfg_params[i].def);
+    snprintk(key, sizeof(key), CFG_SUBTREE "/%s", cfg_names[i]);
+    settings_delete(key);
+  }
+}
+
+/**
+ * @brief Executes a command line received from the host on the CDC ACM port, see output.c.
+ *
+ * Accepts the syntax of the `config` shell command: `config`, `config set <name> <value>`, `config save` and
+ * `config reset`. The reply lists one parameter per line for `config`, otherwise it is a single line starting with
+ * "ok" or "error".
+ *
+ * @param line Command without line ending, modified while parsing
+ * @param reply Buffer for the reply, always terminated
+ * @param size Size of the reply buffer
+ * @return 0 on success, negative on error
+ */
+int cfg_command(char *line, char *reply, size_t size) {
+  char *save;
+  const char *cmd = strtok_r(line, " \t", &save);
+  const char *sub = strtok_r(NULL, " \t", &save);
+
+  if (cmd == NULL || strcmp(cmd, "config") != 0) {
+    snprintk(reply, size, "error unknown command\n");
+    return -ENOENT;
+  }
+
+  if (sub == NULL) {
+    size_t len = 0;
+
+    reply[0] = '\0';
+    for (size_t i = 0; i < CFG_COUNT; i++) {
+      int n = snprintk(reply + len, size - len, "%s %u %s\n", cfg_names[i], cfg_values[i], cfg_params[i].unit);
+
+      if (n < 0 || (size_t)n >= size - len) {
+        break;
+      }
+      len += n;
+    }
+    return 0;
+  }
+
+  if (strcmp(sub, "set") == 0) {
+    const char *name = strtok_r(NULL, " \t", &save);
+    const char *arg = strtok_r(NULL, " \t", &save);
+    int id = name ? cfg_find(name) : -ENOENT;
+    char *end;
+
+    if (id < 0 || arg == NULL) {
+      snprintk(reply, size, "error unknown parameter\n");
+      return -ENOENT;
+    }
+    unsigned long value = strtoul(arg, &end, 0);
+    if (*end != '\0' || cfg_set(id, value) != 0) {
+      snprintk(reply, size, "error invalid %s\n", cfg_names[id]);
+      return -EINVAL;
+    }
+    snprintk(reply, size, "ok %s %u %s\n", cfg_names[id], cfg_values[id], cfg_params[id].unit);
+    return 0;
+  }
+
+  if (strcmp(sub, "save") == 0) {
+    int rc = cfg_save();
+
+    if (rc != 0) {
+      snprintk(reply, size, "error %d saving\n", rc);
+      return rc;
+    }
+    snprintk(reply, size, "ok saved\n");
+    return 0;
+  }
+
+  if (strcmp(sub, "reset") == 0) {
+    cfg_reset();
+    snprintk(reply, size, "ok defaults restored\n");
+    return 0;
+  }
+
+  snprintk(reply, size, "error unknown command\n");
+  return -ENOENT;
+}
+
+#if defined(CONFIG_SHELL)
+static void cfg_print_allowed(const struct shell *sh, cfg_id_t id) {
+  const cfg_param_t *param = &cfg_params[id];
+
+  if (param->allowed == NULL) {
+    shell_fprintf(sh, SHELL_NORMAL, "%u - %u", param->min, param->max);
+    return;
+  }
+  for (size_t i = 0; i < param->allowed_count; i++) {
+    shell_fprintf(sh, SHELL_NORMAL, i ? ", %u" : "%u", param->allowed[i]);
+  }
+}
+
+static int cmd_config(const struct shell *sh, size_t argc, char **argv) {
+  ARG_UNUSED(argc);
+  ARG_UNUSED(argv);
+
+  for (size_t i = 0; i < CFG_COUNT; i++) {
+    shell_fprintf(sh, SHELL_NORMAL, "%-16s %8u %-9s (", cfg_names[i], cfg_values[i], cfg_params[i].unit);
+    cfg_print_allowed(sh, i);
+    shell_fprintf(sh, SHELL_NORMAL, ")\n");
+  }
+  return 0;
+}
+
+static int cmd_config_set(const struct shell *sh, size_t argc, char **argv) {
+  ARG_UNUSED(argc);
+
+  int id = cfg_find(argv[1]);
+  char *end;
+
+  if (id < 0) {
+    shell_error(sh, "Unknown parameter %s", argv[1]);
+    return -ENOENT;
+  }
+
+  unsigned long value = strtoul(argv[2], &end, 0);
+  if (*end != '\0' || cfg_set(id, value) != 0) {
+    shell_fprintf(sh, SHELL_ERROR, "Invalid %s, supported: ", cfg_names[id]);
+    cfg_print_allowed(sh, id);
+    shell_fprintf(sh, SHELL_ERROR, "\n");
+    return -EINVAL;
+  }
+
+  shell_print(sh, "%s = %u %s, applied with the next period", cfg_names[id], cfg_values[id], cfg_params[id].unit);
+  return 0;
+}
+
+static int cmd_config_save(const struct shell *sh, size_t argc, char **argv) {
+  ARG_UNUSED(argc);
+  ARG_UNUSED(argv);
+
+  int rc = cfg_save();
+
+  if (rc != 0) {
+    shell_error(sh, "Error %d saving the configuration", rc);
+    return rc;
+  }
+  shell_print(sh, "Configuration saved");
+  return 0;
+}
+
+static int cmd_config_reset(const struct shell *sh, size_t argc, char **argv) {
+  ARG_UNUSED(argc);
+  ARG_UNUSED(argv);
+
+  cfg_reset();
+  shell_print(sh, "Defaults restored");
+  return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(config_cmds,
+                               SHELL_CMD_ARG(set, NULL, "Change a parameter: set <name> <value>", cmd_config_set, 3, 0),
+                               SHELL_CMD(save, NULL, "Store the configuration in flash", cmd_config_save),
+                               SHELL_CMD(reset, NULL, "Restore and store the defaults", cmd_config_reset),
+                               SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(config, &config_cmds, "Print the runtime configuration", cmd_config);
+#endif
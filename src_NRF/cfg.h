@@ -0,0 +1,71 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: cfg.h
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef CFG_H
+#define CFG_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Runtime configuration
+ *
+ * The parameters below can be changed with the `config` shell command while the acquisition is running and stored
+ * on the settings_storage partition with `config save`. The defaults are taken from config.h.
+ *
+ * The same commands are accepted as text lines on the CDC ACM port of the records, so a deployed hub can be retuned
+ * by the host without a debugger, see cfg_command().
+ *
+ * Every change sets a flag that is taken by the task owning the parameter, so a sensor is reconfigured on its own
+ * bus thread between two conversions and never while a conversion is in flight.
+ */
+
+#define CFG_PARAMS(X)                                                                                                  \
+  X(SAMPLING_TIME, sampling_time)                                                                                      \
+  X(BH1730_GAIN, bh1730_gain)                                                                                          \
+  X(BH1730_INT, bh1730_int)                                                                                            \
+  X(AS7331_GAIN, as7331_gain)                                                                                          \
+  X(AS7331_TIME, as7331_time)                                                                                          \
+  X(ILPS28QSW_ODR, ilps28qsw_odr)                                                                                      \
+  X(ILPS28QSW_AVG, ilps28qsw_avg)
+
+#define CFG_PARAM_ID(id, name) CFG_##id,
+typedef enum { CFG_PARAMS(CFG_PARAM_ID) CFG_COUNT } cfg_id_t;
+#undef CFG_PARAM_ID
+
+int cfg_init(void);
+uint32_t cfg_get(cfg_id_t id);
+int cfg_set(cfg_id_t id, uint32_t value);
+bool cfg_take(uint32_t mask);
+int cfg_save(void);
+void cfg_reset(void);
+int cfg_command(char *line, char *reply, size_t size);
+
+#endif /* CFG_H */
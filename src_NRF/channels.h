@@ -0,0 +1,129 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: channels.h
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef CHANNELS_H
+#define CHANNELS_H
+
+#include "config.h"
+
+/*
+ * Record channels
+ *
+ * Every field of the record is declared once in RECORD_CHANNELS as X(field, type, column, unit, decimals), in the
+ * order of sensor_values_t, the CSV columns and the wire format:
+ *
+ *   field     Member of sensor_values_t
+ *   type      u16, u32 or f32
+ *   column    CSV column, also the name of the field on the host
+ *   unit      Unit of the value
+ *   decimals  Decimals of a float in the fixed-point CSV output, the resolution of the sensor
+ *
+ * The struct, the CSV header and formatters, the binary packing, tscodec and the Python schema of serial_to_db are
+ * generated from this table. The channels of a sensor disabled in config.h are left out, so the sensor costs neither
+ * record nor wire bytes.
+ *
+ * The header is also expanded by the C preprocessor into record_schema.py and must only contain macros.
+ */
+
+#define RECORD_CHANNELS(X)                                                                                             \
+  X(timestamp, u32, "Timestamp", "ms", 0)                                                                              \
+  RECORD_CHANNELS_SCD41(X)                                                                                             \
+  RECORD_CHANNELS_SGP41(X)                                                                                             \
+  RECORD_CHANNELS_ILPS28QSW(X)                                                                                         \
+  RECORD_CHANNELS_BME688(X)                                                                                            \
+  RECORD_CHANNELS_BH1730FVC(X)                                                                                         \
+  RECORD_CHANNELS_AS7331(X)                                                                                            \
+  RECORD_CHANNELS_MAX77654(X)
+
+#if SCD41_ENABLED
+#define RECORD_CHANNELS_SCD41(X)                                                                                       \
+  X(scd41_co2, u16, "SCD41_CO2", "ppm", 0)                                                                             \
+  X(scd41_temperature, f32, "SCD41_Temperature", "degC", 3)                                                            \
+  X(scd41_humidity, f32, "SCD41_Humidity", "%RH", 3)
+#else
+#define RECORD_CHANNELS_SCD41(X)
+#endif
+
+#if SGP41_ENABLED
+#define RECORD_CHANNELS_SGP41(X)                                                                                       \
+  X(sgp41_voc, u16, "SGP41_VOC", "ticks", 0)                                                                           \
+  X(sgp41_nox, u16, "SGP41_NOX", "ticks", 0)
+#else
+#define RECORD_CHANNELS_SGP41(X)
+#endif
+
+#if ILPS28QSW_ENABLED
+#define RECORD_CHANNELS_ILPS28QSW(X)                                                                                   \
+  X(ilps28qsw_pressure, f32, "ILPS28QSW_Pressure", "hPa", 4)                                                           \
+  X(ilps28qsw_temperature, f32, "ILPS28QSW_Temperature", "degC", 2)
+#else
+#define RECORD_CHANNELS_ILPS28QSW(X)
+#endif
+
+#if BME688_ENABLED
+#define RECORD_CHANNELS_BME688(X)                                                                                      \
+  X(bme688_temperature, f32, "BME688_Temperature", "degC", 2)                                                          \
+  X(bme688_pressure, f32, "BME688_Pressure", "kPa", 3)                                                                 \
+  X(bme688_humidity, f32, "BME688_Humidity", "%RH", 3)                                                                 \
+  X(bme688_gas_resistance, f32, "BME688_Gas_Resistance", "Ohm", 0)
+#else
+#define RECORD_CHANNELS_BME688(X)
+#endif
+
+#if BH1730FVC_ENABLED
+#define RECORD_CHANNELS_BH1730FVC(X)                                                                                   \
+  X(bh1730_visible, u16, "BH1730FVC_Visible", "counts", 0)                                                             \
+  X(bh1730_ir, u16, "BH1730FVC_IR", "counts", 0)                                                                       \
+  X(bh1730_lux, u32, "BH1730FVC_Lux", "lx", 0)
+#else
+#define RECORD_CHANNELS_BH1730FVC(X)
+#endif
+
+#if AS7331_ENABLED
+#define RECORD_CHANNELS_AS7331(X)                                                                                      \
+  X(as7331_temp, f32, "AS7331_Temperature", "degC", 2)                                                                 \
+  X(as7331_uva, u16, "AS7331_UVA", "counts", 0)                                                                        \
+  X(as7331_uvb, u16, "AS7331_UVB", "counts", 0)                                                                        \
+  X(as7331_uvc, u16, "AS7331_UVC", "counts", 0)
+#else
+#define RECORD_CHANNELS_AS7331(X)
+#endif
+
+// Supply and energy per record, see energy.h
+#if ENERGY_ENABLED
+#define RECORD_CHANNELS_MAX77654(X)                                                                                    \
+  X(max77654_vsys, u16, "MAX77654_VSYS", "mV", 0)                                                                      \
+  X(max77654_vbat, u16, "MAX77654_VBAT", "mV", 0)                                                                      \
+  X(max77654_charge, u32, "MAX77654_Charge", "uC", 0)                                                                  \
+  X(max77654_energy, u32, "MAX77654_Energy", "uJ", 0)
+#else
+#define RECORD_CHANNELS_MAX77654(X)
+#endif
+
+#endif /* CHANNELS_H */
@@ -3,7 +3,7 @@
  *
  * File: config.h
  *
- * Last edited: 30.10.2025
+ * Last edited: 16.10.2026
  *
  * Copyright (c) 2025 ETH Zurich and University of Bologna
  *
@@ -27,6 +27,167 @@
  */
 
 #define SPACES ""
-#define SAMPLING_TIME 5000 // 5s
+#define SAMPLING_TIME 5000     // 5s, default of the runtime parameter sampling_time, see cfg.h
+#define SAMPLING_TIME_MIN 1000 // Range accepted at runtime in ms
+#define SAMPLING_TIME_MAX 3600000
+
+// Populated sensors, a disabled sensor is compiled out with its driver, bus traffic and record channels, see channels.h
+#define SCD41_ENABLED 1
+#define SGP41_ENABLED 1
+#define ILPS28QSW_ENABLED 1
+#define BME688_ENABLED 1
+#define BH1730FVC_ENABLED 1
+#define AS7331_ENABLED 1
+
+// Sampling periods of the individual sensors in ms, 0 follows the runtime sampling time
+#define ACQ_PERIOD_INTERVAL 0xFFFFFFFF       // Output interval of a continuously converting sensor, see sensor.h
+#define SCD41_PERIOD 0                       // Periodic measurement mode delivers a new sample every 5s
+#define SGP41_PERIOD 0
+#define ILPS28QSW_PERIOD ACQ_PERIOD_INTERVAL // One sample per period of the configured ODR
+#define BME688_PERIOD 0                      // Forced mode with gas heater
+#define BH1730_PERIOD ACQ_PERIOD_INTERVAL    // One sample per configured integration time
+#define AS7331_PERIOD 0                      // At least the conversion time (2^AS7331_TIME ms)
+#define RECORD_PERIOD 0                      // Output of the CSV record
+#define SCD41_RETRY_TIME 100                 // Poll interval while waiting for SCD41 data in ms
+#define SCD41_INTERVAL 5000                  // Sample interval of the periodic measurement mode in ms
+
+// Adaptive sampling, see adapt.h. The periods above are used with ADAPT_ENABLED 0, otherwise every sensor follows
+// its channels below, bounded by the fastest rate of its configuration (ODR, integration or conversion time).
+// The record is emitted with the period of the fastest sensor, but not faster than SAMPLING_TIME_MIN.
+#define ADAPT_ENABLED 1
+#define ADAPT_MAX_CHANNELS 8
+
+// Channel bounds: rate of change per second, mean deviation, shortest and longest period in ms
+#define ADAPT_SCD41_CO2 2.0f, 10.0f, 5000, 60000           // ppm
+#define ADAPT_SGP41_VOC 20.0f, 50.0f, 1000, 60000          // SRAW ticks
+#define ADAPT_ILPS28QSW_PRESSURE 0.02f, 0.01f, 1000, 60000 // hPa, door openings are a few Pa
+#define ADAPT_BME688_TEMPERATURE 0.05f, 0.1f, 5000, 60000  // °C
+#define ADAPT_BME688_HUMIDITY 0.2f, 0.5f, 5000, 60000      // %RH
+#define ADAPT_BH1730_LUX 10.0f, 20.0f, 1000, 60000         // lx
+#define ADAPT_AS7331_UVA 5.0f, 10.0f, 5000, 60000          // counts
+
+// Default sensor settings, can be changed at runtime, see cfg.h
+#define BH1730_GAIN 64             // 1, 2, 64 or 128
+#define BH1730_INT BH1730_INT_50MS // ITIME register value
+#define AS7331_GAIN 10             // ADCGain = 2^(11-gain), 0 - 11
+#define AS7331_TIME 11             // Conversion time 2^time ms, 0 - 15
+#define ILPS28QSW_ODR 4            // 1, 4, 10, 25, 50, 75, 100 or 200 Hz
+#define ILPS28QSW_AVG 16           // 4 - 512 samples averaged per output
+
+// Split-phase acquisition, the first ready check happens after the expected conversion time
+#define BME688_CONVERSION_TIME 200 // TPH conversion and gas heater duration
+#define ACQ_POLL_TIME 10           // Interval of the following ready checks in ms
+#define BME688_STACK_SIZE 2048
+#define BME688_PRIORITY 6
+
+// Ready time prediction, see predict.h
+#define ACQ_PREDICT 1             // Sleep until shortly before the learned ready time instead of the conversion time
+#define PREDICT_GUARD 1           // Wake up this many mean deviations before the expected ready time
+#define PREDICT_GUARD_MIN_US 1000 // and at least this much earlier
+#define PREDICT_MAX_MODELS 8
+
+// Power gating of the shield sensors between samples, see gating.h
+#define GATING_ENABLED 1
+#define SENSOR_SETTLE_TIME 100    // From switching on the supply and bus until the sensors respond in ms
+#define GATING_MIN_OFF_TIME 10000 // Shortest time a gated sensor stays off in ms
+
+// Device runtime power management of the I2C controllers, GPIO expanders and USB, see devpm.h
+#if defined(CONFIG_PM_DEVICE_RUNTIME)
+#define DEVPM_ENABLED 1
+#else
+#define DEVPM_ENABLED 0
+#endif
+#define DEVPM_MAX_DEVICES 8
+
+// Acquisition over the Zephyr sensor drivers with RTIO, see sensor_rtio.h. Needs the nodes of sensors.overlay
+#if defined(CONFIG_SENSOR_HUB_RTIO)
+#define SENSOR_RTIO 1
+#else
+#define SENSOR_RTIO 0
+#endif
+#define SENSOR_RTIO_BUFFERS 8 // Samples in flight, at most one per sensor
+
+// Fault isolation, see health.h. A sensor times out after twice its expected ready time plus the margin
+#define ACQ_TIMEOUT_MARGIN 50     // ms
+#define HEALTH_RETRY_TIME 1000    // Backoff after the first failure in ms, doubles with every further failure
+#define HEALTH_RETRY_MAX 300000   // Longest backoff, also the retry interval of a failed sensor
+#define HEALTH_RECOVER_AFTER 3    // Power cycle the sensor after this many consecutive failures
+#define HEALTH_RECOVER_ATTEMPTS 3 // Power cycles before the sensor is considered failed
+#define HEALTH_MAX_SENSORS 8
+
+// Output format of the records
+#define OUTPUT_FORMAT_CSV 0    // Human readable CSV line per record
+#define OUTPUT_FORMAT_BINARY 1 // COBS framed binary records, see proto.h
+#define OUTPUT_FORMAT OUTPUT_FORMAT_CSV
+#define OUTPUT_COMPRESS 1         // Binary format only, send each batch and the backlog as compressed blocks
+#define OUTPUT_CSV_FIXED_POINT 1  // CSV format only, integer formatter instead of printf("%f")
+#define OUTPUT_SCHEMA_INTERVAL 60 // Resend the schema frame or CSV header every n records, 0 to only send on connect
+#define OUTPUT_COMMAND_SIZE 64    // Longest command line received from the host, see cfg_command()
+#define OUTPUT_REPLY_SIZE 256     // Longest reply to a command
+
+// The printf CSV formatter and its benchmark need the float printf
+#if defined(CONFIG_SENSOR_HUB_FLOAT_PRINTF)
+#define FLOAT_PRINTF_ENABLED 1
+#else
+#define FLOAT_PRINTF_ENABLED 0
+#endif
+
+// Compare the cycles per record of the printf and fixed-point CSV formatter at startup
+#define FMT_BENCHMARK 0
+#define FMT_BENCHMARK_RUNS 100
+
+#if (FMT_BENCHMARK || !OUTPUT_CSV_FIXED_POINT) && !FLOAT_PRINTF_ENABLED
+#error "FMT_BENCHMARK and OUTPUT_CSV_FIXED_POINT=0 need CONFIG_SENSOR_HUB_FLOAT_PRINTF"
+#endif
+
+// Output thread, records are queued in a ring so a stalled USB host does not block the acquisition
+#define OUTPUT_RING_SIZE 16                      // Records, must be a power of two
+#define OUTPUT_RING_POLICY RING_POLICY_OVERWRITE // RING_POLICY_DROP keeps the oldest records instead
+#define OUTPUT_BATCH_SIZE 1                      // Records written per wakeup of the output thread
+#define OUTPUT_FLUSH_TIME SAMPLING_TIME          // Maximum time an incomplete batch is held back in ms
+#define OUTPUT_STACK_SIZE 4096
+#define OUTPUT_PRIORITY 10 // Below the acquisition threads
+
+// Interrupt-driven transmission on the CDC ACM port
+#define OUTPUT_TX_BUFFERS 4                     // Transmit buffers in flight
+#define OUTPUT_TX_BUFFER_SIZE PROTO_MAX_ENCODED // Holds one frame or CSV line
+#define OUTPUT_TX_TIMEOUT 1000                  // Wait for a free buffer before dropping the output in ms
+#define UART_TX_QUEUE_DEPTH OUTPUT_TX_BUFFERS
+
+// Flash log of the records on the sample_log partition while no host is connected
+#define FLOG_ENABLED 1
+#define FLOG_BLOCK_SIZE 4064 // Compressed block per flash write, fills one 4 KiB page including the FCB headers
+#define FLOG_MAX_SECTORS 112 // Sectors of the sample_log partition
+
+// Tracepoints, see trace.h
+#define TRACE_ENABLED 0
+#define TRACE_BUFFER_SIZE 1024 // Entries of 8 bytes, must be a power of two
+#define TRACE_DUMP_INTERVAL 4  // Dump every n records, 0 to disable. DWT wraps after 33s at 128MHz
+#define TRACE_GPIO 0           // Also toggle the debug signal 2 on every event
+
+// Latency histograms of the acquisition stages, see latency.h
+#define LATENCY_ENABLED 1
+#define LATENCY_SUMMARY_INTERVAL 60 // Log and send the summary every n records, 0 to disable
+
+// Acquisition benchmark, see bench.h
+#if defined(CONFIG_SENSOR_HUB_BENCH)
+#define BENCH_ENABLED 1
+#define BENCH_CYCLES CONFIG_SENSOR_HUB_BENCH_CYCLES // Records until the report
+#else
+#define BENCH_ENABLED 0
+#define BENCH_CYCLES 0
+#endif
+
+// Energy meter on the MAX77654 fuel measurements, see energy.h
+#define ENERGY_ENABLED 1
+#define ENERGY_SAMPLE_PERIOD 250                    // PMIC measurement interval in ms
+#define ENERGY_DISCHARGE_RANGE MAX77654_BATT_I_8MA2 // Full scale of the discharge current measurement
+#define ENERGY_FAST_CHARGE_UA 7500                  // Fast-charge current of the PMIC, reference of BATT_I_CHG
+#define ENERGY_MAX_WINDOWS 8
+
+// Scheduler
+#define SCHED_STACK_SIZE 4096
+#define SCHED_PRIORITY 5
+#define SCHED_STATS_INTERVAL 60 // Log jitter statistics every n records, 0 to disable
 
 #define NO_ERROR 0
@@ -0,0 +1,341 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: devpm.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <errno.h>
+
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/kernel.h>
+#include <zephyr/pm/device.h>
+#include <zephyr/pm/device_runtime.h>
+#include <zephyr/shell/shell.h>
+
+#include <zephyr/logging/log.h>
+
+#include "config.h"
+#include "devpm.h"
+
+LOG_MODULE_REGISTER(devpm, LOG_LEVEL_INF);
+
+typedef enum {
+  DEVPM_MODE_RUNTIME, // Suspended by device runtime PM while no reference is held
+  DEVPM_MODE_HOST,    // Suspended by the USB host
+  DEVPM_MODE_NONE,    // Kept out of runtime PM or no PM support in the driver, always active
+} devpm_mode_t;
+
+static const char *const devpm_mode_names[] = {
+    [DEVPM_MODE_RUNTIME] = "runtime",
+    [DEVPM_MODE_HOST] = "host",
+    [DEVPM_MODE_NONE] = "none",
+};
+
+typedef struct {
+  const char *name;
+  const struct device *dev;
+  devpm_mode_t mode;
+
+  uint32_t usage; // References taken with devpm_get()
+  bool suspended;
+  int64_t since_ticks; // Last change of the state
+  uint64_t active_ticks;
+  uint64_t suspended_ticks;
+  uint32_t resumes;
+} devpm_entry_t;
+
+#define DEVPM_GPIO_SPEC(label, unused) GPIO_DT_SPEC_GET_OR(DT_NODELABEL(label), gpios, {0}),
+
+// Whether the expander of a line sits on the I2C controller behind an alias
+#define DEVPM_GPIO_ON_BUS(label, alias)                                                                                \
+  COND_CODE_1(DT_NODE_EXISTS(DT_NODELABEL(label)),                                                                     \
+              (DT_SAME_NODE(DT_BUS(DT_GPIO_CTLR(DT_NODELABEL(label), gpios)), DT_ALIAS(alias))), (0)) ||
+
+// Lines on the GPIO expanders, several lines share a controller
+#define DEVPM_GPIO_EXT(fn, arg)                                                                                        \
+  fn(gpio_ext_i2c_scd41_en, arg)                                                                                       \
+  fn(gpio_ext_i2c_sgp41_en, arg)                                                                                       \
+  fn(gpio_ext_i2c_as7331_en, arg)                                                                                      \
+  fn(gpio_ext_as7331_ready, arg)                                                                                       \
+  fn(gpio_ext_ilps28qsw_int, arg)                                                                                      \
+  fn(gpio_ext_hm0360_clk_en, arg)
+
+static const struct gpio_dt_spec devpm_gpio_ext[] = {DEVPM_GPIO_EXT(DEVPM_GPIO_SPEC, 0)};
+
+// Whether one of the expanders sits on the I2C controller behind an alias
+#define DEVPM_GPIO_EXT_ON_BUS(alias) (DEVPM_GPIO_EXT(DEVPM_GPIO_ON_BUS, alias) 0)
+
+static struct k_spinlock devpm_lock;
+static devpm_entry_t devpm_entries[DEVPM_MAX_DEVICES];
+static size_t devpm_count = 0;
+static devpm_entry_t *devpm_usb = NULL;
+
+/**
+ * @brief Moves the time since the last change to the counter of the current state.
+ *
+ * Must be called with devpm_lock held.
+ */
+static void devpm_account(devpm_entry_t *entry, int64_t now) {
+  if (entry->suspended) {
+    entry->suspended_ticks += now - entry->since_ticks;
+  } else {
+    entry->active_ticks += now - entry->since_ticks;
+  }
+  entry->since_ticks = now;
+}
+
+/**
+ * @brief Changes the state of a device and counts the resumes.
+ *
+ * Must be called with devpm_lock held.
+ */
+static void devpm_set_state(devpm_entry_t *entry, bool suspended) {
+  if (entry->suspended == suspended) {
+    return;
+  }
+  devpm_account(entry, k_uptime_ticks());
+  entry->suspended = suspended;
+  if (!suspended) {
+    entry->resumes++;
+  }
+}
+
+static devpm_entry_t *devpm_find(const struct device *dev) {
+  for (size_t i = 0; i < devpm_count; i++) {
+    if (devpm_entries[i].dev == dev) {
+      return &devpm_entries[i];
+    }
+  }
+  return NULL;
+}
+
+/**
+ * @brief Adds a device, with DEVPM_MODE_RUNTIME device runtime PM suspends it until the first reference.
+ *
+ */
+static devpm_entry_t *devpm_add(const char *name, const struct device *dev, devpm_mode_t mode) {
+  devpm_entry_t *entry = devpm_find(dev);
+
+  if (entry != NULL) {
+    return entry;
+  }
+  __ASSERT(devpm_count < DEVPM_MAX_DEVICES, "Increase DEVPM_MAX_DEVICES");
+  if (devpm_count >= DEVPM_MAX_DEVICES) {
+    return NULL;
+  }
+
+  if (mode == DEVPM_MODE_RUNTIME) {
+    int error = pm_device_runtime_enable(dev);
+
+    if (error == -ENOTSUP) {
+      mode = DEVPM_MODE_NONE;
+    } else if (error != 0) {
+      LOG_ERR("Error %d enabling runtime PM of %s", error, name);
+      mode = DEVPM_MODE_NONE;
+    }
+  }
+
+  entry = &devpm_entries[devpm_count++];
+  *entry = (devpm_entry_t){
+      .name = name,
+      .dev = dev,
+      .mode = mode,
+      .suspended = mode == DEVPM_MODE_RUNTIME,
+      .since_ticks = k_uptime_ticks(),
+  };
+  LOG_INF("%s: %s power management", name, devpm_mode_names[mode]);
+  return entry;
+}
+
+/**
+ * @brief Puts the I2C controllers under device runtime PM and starts the residency counters.
+ *
+ * A controller is only suspended while nothing may access it outside of devpm_get(), see devpm.h. Call after the
+ * drivers of the expanders were configured and before usb_enable().
+ */
+int devpm_init(void) {
+  const struct device *const i2ca = DEVICE_DT_GET(DT_ALIAS(i2ca));
+  const struct device *const i2cb = DEVICE_DT_GET(DT_ALIAS(i2cb));
+
+  devpm_add("i2ca", i2ca, DEVPM_MODE_RUNTIME);
+  devpm_add("i2cb", i2cb, DEVPM_MODE_RUNTIME);
+
+  // The expanders drive the enable lines and raise the data-ready interrupts at any time, they stay active
+  for (size_t i = 0; i < ARRAY_SIZE(devpm_gpio_ext); i++) {
+    if (devpm_gpio_ext[i].port != NULL) {
+      devpm_add(devpm_gpio_ext[i].port->name, devpm_gpio_ext[i].port, DEVPM_MODE_NONE);
+    }
+  }
+
+  // Held for good: the SDK power thread uses the PMIC on i2ca, the expander drivers and the sensei drivers transfer
+  // on their bus without taking a reference
+  devpm_get(i2ca);
+  if (SENSOR_RTIO || DEVPM_GPIO_EXT_ON_BUS(i2cb)) {
+    devpm_get(i2cb);
+  }
+
+  // Detached until the host configures the device
+  devpm_usb = devpm_add("usb", DEVICE_DT_GET(DT_PARENT(DT_COMPAT_GET_ANY_STATUS_OKAY(zephyr_cdc_acm_uart))),
+                        DEVPM_MODE_HOST);
+  if (devpm_usb != NULL) {
+    devpm_usb->suspended = true;
+  }
+  return NO_ERROR;
+}
+
+/**
+ * @brief Resumes a device if needed and holds it active until devpm_put().
+ *
+ * Devices without runtime PM are only counted.
+ */
+int devpm_get(const struct device *dev) {
+  int error = pm_device_runtime_get(dev);
+  devpm_entry_t *entry = devpm_find(dev);
+
+  if (error == 0 && entry != NULL) {
+    k_spinlock_key_t key = k_spin_lock(&devpm_lock);
+    if (entry->usage++ == 0 && entry->mode == DEVPM_MODE_RUNTIME) {
+      devpm_set_state(entry, false);
+    }
+    k_spin_unlock(&devpm_lock, key);
+  }
+  return error;
+}
+
+/**
+ * @brief Releases a reference taken with devpm_get(), the last one suspends the device.
+ *
+ */
+int devpm_put(const struct device *dev) {
+  devpm_entry_t *entry = devpm_find(dev);
+
+  if (entry != NULL) {
+    k_spinlock_key_t key = k_spin_lock(&devpm_lock);
+    if (entry->usage > 0 && --entry->usage == 0 && entry->mode == DEVPM_MODE_RUNTIME) {
+      devpm_set_state(entry, true);
+    }
+    k_spin_unlock(&devpm_lock, key);
+  }
+  return pm_device_runtime_put(dev);
+}
+
+/**
+ * @brief Follows the state of the USB controller, which is suspended by the host or detached without VBUS.
+ *
+ */
+void devpm_usb_status(enum usb_dc_status_code status, const uint8_t *param) {
+  ARG_UNUSED(param);
+
+  if (devpm_usb == NULL) {
+    return;
+  }
+
+  k_spinlock_key_t key = k_spin_lock(&devpm_lock);
+  switch (status) {
+  case USB_DC_SUSPEND:
+  case USB_DC_DISCONNECTED:
+    devpm_set_state(devpm_usb, true);
+    break;
+  case USB_DC_RESUME:
+  case USB_DC_CONNECTED:
+  case USB_DC_CONFIGURED:
+    devpm_set_state(devpm_usb, false);
+    break;
+  default:
+    break;
+  }
+  k_spin_unlock(&devpm_lock, key);
+}
+
+/**
+ * @brief Copies the counters of a device up to now.
+ *
+ */
+static void devpm_snapshot(size_t index, devpm_entry_t *entry) {
+  k_spinlock_key_t key = k_spin_lock(&devpm_lock);
+  devpm_account(&devpm_entries[index], k_uptime_ticks());
+  *entry = devpm_entries[index];
+  k_spin_unlock(&devpm_lock, key);
+}
+
+// Suspended share in 0.1 %
+static uint32_t devpm_suspended_permille(const devpm_entry_t *entry) {
+  uint64_t total = entry->active_ticks + entry->suspended_ticks;
+
+  return total ? (uint32_t)(entry->suspended_ticks * 1000 / total) : 0;
+}
+
+// State reported by the PM subsystem, the USB state is only known from the events
+static const char *devpm_state_name(const devpm_entry_t *entry) {
+  enum pm_device_state state;
+
+  if (entry->mode == DEVPM_MODE_RUNTIME && pm_device_state_get(entry->dev, &state) == 0) {
+    return pm_device_state_str(state);
+  }
+  return entry->suspended ? "suspended" : "active";
+}
+
+/**
+ * @brief Logs the time every device spent active and suspended.
+ *
+ */
+void devpm_log(void) {
+  devpm_entry_t entry;
+
+  for (size_t i = 0; i < devpm_count; i++) {
+    devpm_snapshot(i, &entry);
+
+    uint32_t permille = devpm_suspended_permille(&entry);
+    LOG_INF(" - %-10s %-7s %-9s : active %llu ms, suspended %llu ms (%u.%u %%), %u resumes", entry.name,
+            devpm_mode_names[entry.mode], devpm_state_name(&entry), k_ticks_to_ms_floor64(entry.active_ticks),
+            k_ticks_to_ms_floor64(entry.suspended_ticks), permille / 10, permille % 10, entry.resumes);
+  }
+}
+
+#if defined(CONFIG_SHELL)
+static int cmd_power(const struct shell *sh, size_t argc, char **argv) {
+  ARG_UNUSED(argc);
+  ARG_UNUSED(argv);
+
+  devpm_entry_t entry;
+
+  shell_print(sh, "%-10s %-8s %-10s %12s %12s %8s %8s", "Device", "PM", "State", "Active [ms]", "Susp. [ms]",
+              "Susp. %", "Resumes");
+  for (size_t i = 0; i < devpm_count; i++) {
+    devpm_snapshot(i, &entry);
+
+    uint32_t permille = devpm_suspended_permille(&entry);
+    shell_print(sh, "%-10s %-8s %-10s %12llu %12llu %6u.%u %8u", entry.name, devpm_mode_names[entry.mode],
+                devpm_state_name(&entry), k_ticks_to_ms_floor64(entry.active_ticks),
+                k_ticks_to_ms_floor64(entry.suspended_ticks), permille / 10, permille % 10, entry.resumes);
+  }
+  return 0;
+}
+
+SHELL_CMD_REGISTER(power, NULL, "Print the time the buses, GPIO expanders and USB spent active and suspended",
+                   cmd_power);
+#endif
@@ -0,0 +1,74 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: devpm.h
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef DEVPM_H
+#define DEVPM_H
+
+#include <stdint.h>
+
+#include <zephyr/device.h>
+#include <zephyr/usb/usb_device.h>
+
+#include "config.h"
+
+/*
+ * Device runtime power management
+ *
+ * The I2C controllers behind the i2ca and i2cb aliases are put under device runtime PM at startup and suspended while
+ * no transfer is in flight. Every transfer takes a reference with devpm_get(): the I2C helpers, see i2c_helpers.c,
+ * the BME688 fetch and the energy measurements. A controller that is also used where no reference can be taken is
+ * held for good: i2ca by the power thread of the SDK, a controller with a GPIO expander by the expander driver and
+ * i2cb by the sensei drivers with SENSOR_RTIO. A device whose driver has no PM support stays active.
+ *
+ * The GPIO expanders drive the enable lines of the sensors and raise the data-ready interrupts, they are kept out of
+ * runtime PM and only reported.
+ *
+ * The USB controller is suspended by the host, when the bus is idle or the cable is unplugged. Its state follows the
+ * status callback of the USB device stack, pass devpm_usb_status() to usb_enable().
+ *
+ * The time each device spends active and suspended is counted from the references and the USB events, type `power`
+ * in the console or see the log with the scheduler statistics.
+ */
+
+#if DEVPM_ENABLED
+int devpm_init(void);
+int devpm_get(const struct device *dev);
+int devpm_put(const struct device *dev);
+void devpm_log(void);
+#else
+static inline int devpm_init(void) { return 0; }
+static inline int devpm_get(const struct device *dev) { return 0; }
+static inline int devpm_put(const struct device *dev) { return 0; }
+static inline void devpm_log(void) {}
+#endif
+
+// Status callback of the USB device stack, only defined with DEVPM_ENABLED
+void devpm_usb_status(enum usb_dc_status_code status, const uint8_t *param);
+
+#endif /* DEVPM_H */
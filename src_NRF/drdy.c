@@ -0,0 +1,148 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: drdy.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <errno.h>
+
+#include <zephyr/device.h>
+#include <zephyr/kernel.h>
+
+#include <zephyr/drivers/gpio.h>
+
+#include <zephyr/logging/log.h>
+
+#include "config.h"
+#include "drdy.h"
+#include "trace.h"
+
+LOG_MODULE_REGISTER(drdy, LOG_LEVEL_INF);
+
+#define DRDY_GPIO_SPEC(label) GPIO_DT_SPEC_GET_OR(DT_NODELABEL(label), gpios, {0})
+
+typedef struct {
+  const char *name;
+  struct gpio_dt_spec spec;
+  struct gpio_callback cb;
+  struct k_poll_signal signal;
+  bool available;
+  sched_task_t *volatile task; // Woken by the interrupt, NULL if none
+} drdy_line_t;
+
+static drdy_line_t lines[DRDY_COUNT] = {
+    [DRDY_AS7331] = {.name = "AS7331", .spec = DRDY_GPIO_SPEC(gpio_ext_as7331_ready)},
+    [DRDY_ILPS28QSW] = {.name = "ILPS28QSW", .spec = DRDY_GPIO_SPEC(gpio_ext_ilps28qsw_int)},
+    [DRDY_ISM330DHCX] = {.name = "ISM330DHCX", .spec = DRDY_GPIO_SPEC(gpio_ism330dhcx_int1)},
+    [DRDY_LIS2DUXS12] = {.name = "LIS2DUXS12", .spec = DRDY_GPIO_SPEC(gpio_lis2duxs12_int1)},
+};
+
+static void drdy_isr(const struct device *port, struct gpio_callback *cb, gpio_port_pins_t pins) {
+  drdy_line_t *line = CONTAINER_OF(cb, drdy_line_t, cb);
+  sched_task_t *task = line->task;
+
+  k_poll_signal_raise(&line->signal, 0);
+  TRACE_INSTANT(DRDY, line - lines);
+  if (task != NULL) {
+    sched_task_wake(task);
+  }
+}
+
+/**
+ * @brief Configures all data-ready lines present in the devicetree as interrupt inputs.
+ *
+ * Lines whose GPIO controller does not support interrupts are only sampled by the ready checks of their sensor.
+ *
+ * @return 0 on success, negative on error
+ */
+int drdy_init(void) {
+  for (size_t i = DRDY_NONE + 1; i < DRDY_COUNT; i++) {
+    drdy_line_t *line = &lines[i];
+    k_poll_signal_init(&line->signal);
+
+    if (line->spec.port == NULL) {
+      LOG_DBG(" - %s data-ready line not present", line->name);
+      continue;
+    }
+
+    if (!gpio_is_ready_dt(&line->spec)) {
+      LOG_ERR(" * %s data-ready GPIO not ready", line->name);
+      return -ENODEV;
+    }
+
+    int error = gpio_pin_configure_dt(&line->spec, GPIO_INPUT);
+    if (error) {
+      LOG_ERR(" * Error %d configuring %s data-ready GPIO", error, line->name);
+      return error;
+    }
+    line->available = true;
+
+    gpio_init_callback(&line->cb, drdy_isr, BIT(line->spec.pin));
+    error = gpio_add_callback_dt(&line->spec, &line->cb);
+    if (error == 0) {
+      error = gpio_pin_interrupt_configure_dt(&line->spec, GPIO_INT_EDGE_TO_ACTIVE);
+    }
+    if (error) {
+      LOG_WRN(" * %s data-ready interrupt not supported (%d), polling the pin instead", line->name, error);
+      gpio_remove_callback_dt(&line->spec, &line->cb);
+    }
+  }
+
+  return 0;
+}
+
+bool drdy_available(drdy_src_t src) { return lines[src].available; }
+
+/**
+ * @brief Discards a pending event, call before triggering a new conversion.
+ *
+ */
+void drdy_arm(drdy_src_t src) { k_poll_signal_reset(&lines[src].signal); }
+
+/**
+ * @brief Returns whether the data of a line is ready without blocking.
+ *
+ * The pin level is checked as well, as an edge may have been missed while the line was already active.
+ */
+bool drdy_pending(drdy_src_t src) {
+  drdy_line_t *line = &lines[src];
+  unsigned int signaled;
+  int result;
+
+  if (!line->available) {
+    return false;
+  }
+
+  k_poll_signal_check(&line->signal, &signaled, &result);
+  return signaled || (gpio_pin_get_dt(&line->spec) == 1);
+}
+
+/**
+ * @brief Binds the task that is woken by the interrupt of a line.
+ *
+ * Bind while the task waits for the conversion and unbind with NULL once the data was read, see sched_task_wake().
+ */
+void drdy_bind(drdy_src_t src, sched_task_t *task) { lines[src].task = task; }
@@ -0,0 +1,63 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: drdy.h
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef DRDY_H
+#define DRDY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "sched.h"
+
+/**
+ * @brief Data-ready lines of the sensors.
+ *
+ * A line is only used if its devicetree node label exists. The sensor has to route its data-ready signal to the pin.
+ * The interrupt of a line wakes the task bound to it, so the ready check runs as soon as the data is available
+ * instead of at the next poll. The ISM330DHCX and LIS2DUXS12 lines are configured but not bound yet, as these sensors
+ * are not sampled by the acquisition.
+ */
+typedef enum {
+  DRDY_NONE,       // Sensor without data-ready line
+  DRDY_AS7331,     // gpio_ext_as7331_ready
+  DRDY_ILPS28QSW,  // gpio_ext_ilps28qsw_int
+  DRDY_ISM330DHCX, // gpio_ism330dhcx_int1
+  DRDY_LIS2DUXS12, // gpio_lis2duxs12_int1
+  DRDY_COUNT,
+} drdy_src_t;
+
+int drdy_init(void);
+
+bool drdy_available(drdy_src_t src);
+
+void drdy_arm(drdy_src_t src);
+bool drdy_pending(drdy_src_t src);
+void drdy_bind(drdy_src_t src, sched_task_t *task);
+
+#endif /* DRDY_H */
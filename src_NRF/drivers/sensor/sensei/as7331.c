@@ -0,0 +1,174 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: as7331.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#define DT_DRV_COMPAT sensei_as7331
+
+#include <zephyr/logging/log.h>
+
+#include "as7331_reg.h"
+#include "sensei_sensor_common.h"
+
+LOG_MODULE_DECLARE(sensei_sensor, CONFIG_SENSEI_SENSORS_LOG_LEVEL);
+
+// One-shot conversions in command mode, the READY line goes high at the end of the conversion
+struct as7331_data {
+  struct sensei_sensor_data common;
+  as7331_t ctx;
+  uint8_t gain; // ADCGain = 2^(11-gain), initialized from the devicetree
+  uint8_t time; // Conversion time of 2^time ms
+};
+
+static const sensei_sensor_channel_t as7331_channels[] = {
+    {SENSOR_CHAN_DIE_TEMP, 8},
+    {SENSEI_SENSOR_CHAN_UVA, 16},
+    {SENSEI_SENSOR_CHAN_UVB, 16},
+    {SENSEI_SENSOR_CHAN_UVC, 16},
+};
+
+static int as7331_configure(const struct device *dev, uint8_t gain, uint8_t time) {
+  struct as7331_data *data = dev->data;
+
+  // Break time 8 us x 255, standby disabled, 1.024 MHz conversion clock
+  int rc = as7331_set_configuration_mode(&data->ctx);
+  if (rc == 0) {
+    rc = as7331_init(&data->ctx, AS7331_CMD_MODE, AS7331_1024, 0x00, 255, gain, time);
+  }
+  if (rc == 0) {
+    rc = as7331_set_measurement_mode(&data->ctx);
+  }
+  if (rc) {
+    return rc;
+  }
+
+  data->gain = gain;
+  data->time = time;
+  LOG_DBG("%s gain %u, conversion time %u ms", dev->name, gain, 1U << time);
+  return 0;
+}
+
+static int as7331_dev_init(const struct device *dev) {
+  const struct sensei_sensor_config *config = dev->config;
+  struct as7331_data *data = dev->data;
+
+  data->ctx.ctx.read_reg = sensei_sensor_read_reg;
+  data->ctx.ctx.write_reg = sensei_sensor_write_reg;
+  data->ctx.ctx.handle = (void *)&config->i2c;
+
+  // The reset only takes effect while the sensor is powered up, it has to be powered up again afterwards
+  int rc = as7331_power_up(&data->ctx);
+  if (rc == 0) {
+    rc = as7331_reset(&data->ctx);
+  }
+  if (rc == 0) {
+    rc = as7331_power_up(&data->ctx);
+  }
+  if (rc) {
+    return rc;
+  }
+
+  // The configuration applied through the attributes is kept across a reinitialization
+  return as7331_configure(dev, data->gain, data->time);
+}
+
+static int as7331_start(const struct device *dev) {
+  struct as7331_data *data = dev->data;
+
+  return as7331_start_measurement(&data->ctx);
+}
+
+static int as7331_ready(const struct device *dev, bool *ready) {
+  struct as7331_data *data = dev->data;
+  as7331_reg_osrstat_t status;
+
+  int rc = as7331_get_status(&data->ctx, &status);
+  if (rc) {
+    return rc;
+  }
+  *ready = status.ndata;
+  return 0;
+}
+
+static int as7331_read(const struct device *dev, float *values) {
+  struct as7331_data *data = dev->data;
+  uint16_t all[4]; // Temperature, UVA, UVB, UVC
+
+  int rc = as7331_read_all(&data->ctx, all);
+  if (rc) {
+    return rc;
+  }
+
+  values[0] = all[0] * 0.05f - 66.9f;
+  values[1] = all[1];
+  values[2] = all[2];
+  values[3] = all[3];
+  return 0;
+}
+
+static uint32_t as7331_conversion_us(const struct device *dev) {
+  struct as7331_data *data = dev->data;
+
+  return 1000U << data->time;
+}
+
+static int as7331_attr_set(const struct device *dev, enum sensor_attribute attr, const struct sensor_value *val) {
+  struct as7331_data *data = dev->data;
+
+  switch ((int)attr) {
+  case SENSEI_SENSOR_ATTR_GAIN:
+    return val->val1 <= 11 ? as7331_configure(dev, val->val1, data->time) : -EINVAL;
+  case SENSEI_SENSOR_ATTR_INTEGRATION:
+    return val->val1 <= 15 ? as7331_configure(dev, data->gain, val->val1) : -EINVAL;
+  default:
+    return -ENOTSUP;
+  }
+}
+
+static const sensei_sensor_ops_t as7331_ops = {
+    .init = as7331_dev_init,
+    .start = as7331_start,
+    .ready = as7331_ready,
+    .read = as7331_read,
+    .conversion_us = as7331_conversion_us,
+    .attr_set = as7331_attr_set,
+};
+
+static const struct sensor_driver_api as7331_api = SENSEI_SENSOR_API;
+
+#define AS7331_DEFINE(inst)                                                                                            \
+  static struct as7331_data as7331_data_##inst = {                                                                     \
+      .gain = DT_INST_PROP(inst, gain),                                                                                \
+      .time = DT_INST_PROP(inst, conversion_time),                                                                     \
+  };                                                                                                                   \
+  static const struct sensei_sensor_config as7331_config_##inst =                                                      \
+      SENSEI_SENSOR_CONFIG(inst, as7331_ops, as7331_channels);                                                         \
+  SENSOR_DEVICE_DT_INST_DEFINE(inst, sensei_sensor_init, NULL, &as7331_data_##inst, &as7331_config_##inst,             \
+                               POST_KERNEL, CONFIG_SENSOR_INIT_PRIORITY, &as7331_api);
+
+DT_INST_FOREACH_STATUS_OKAY(AS7331_DEFINE)
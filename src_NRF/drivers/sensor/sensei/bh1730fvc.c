@@ -0,0 +1,172 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: bh1730fvc.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#define DT_DRV_COMPAT sensei_bh1730fvc
+
+#include <zephyr/logging/log.h>
+
+#include "bh1730fvc_reg.h"
+#include "sensei_sensor_common.h"
+
+LOG_MODULE_DECLARE(sensei_sensor, CONFIG_SENSEI_SENSORS_LOG_LEVEL);
+
+// Integrates continuously after the initialization, the valid flag is set at the end of every integration
+struct bh1730fvc_data {
+  struct sensei_sensor_data common;
+  bh1730_t ctx;
+  uint32_t gain;       // 1, 2, 64 or 128, initialized from the devicetree
+  uint8_t integration; // ITIME register
+};
+
+static const sensei_sensor_channel_t bh1730fvc_channels[] = {
+    {SENSEI_SENSOR_CHAN_VISIBLE, 16},
+    {SENSOR_CHAN_IR, 16},
+    {SENSOR_CHAN_LIGHT, 17},
+};
+
+static int bh1730fvc_configure(const struct device *dev, uint32_t gain, uint8_t integration) {
+  struct bh1730fvc_data *data = dev->data;
+  int rc;
+
+  switch (gain) {
+  case 1:
+    rc = bh1730_init(&data->ctx, BH1730_GAIN_X1, integration);
+    break;
+  case 2:
+    rc = bh1730_init(&data->ctx, BH1730_GAIN_X2, integration);
+    break;
+  case 64:
+    rc = bh1730_init(&data->ctx, BH1730_GAIN_X64, integration);
+    break;
+  case 128:
+    rc = bh1730_init(&data->ctx, BH1730_GAIN_X128, integration);
+    break;
+  default:
+    return -EINVAL;
+  }
+  if (rc) {
+    return rc;
+  }
+
+  data->gain = gain;
+  data->integration = integration;
+  LOG_DBG("%s gain x%u, integration time %u us", dev->name, gain, data->ctx.integration_time_us);
+  return 0;
+}
+
+static int bh1730fvc_dev_init(const struct device *dev) {
+  const struct sensei_sensor_config *config = dev->config;
+  struct bh1730fvc_data *data = dev->data;
+
+  data->ctx.ctx.read_reg = sensei_sensor_read_reg;
+  data->ctx.ctx.write_reg = sensei_sensor_write_reg;
+  data->ctx.ctx.handle = (void *)&config->i2c;
+
+  int rc = bh1730_power_on(&data->ctx);
+  if (rc) {
+    return rc;
+  }
+  return bh1730fvc_configure(dev, data->gain, data->integration);
+}
+
+static int bh1730fvc_ready(const struct device *dev, bool *ready) {
+  struct bh1730fvc_data *data = dev->data;
+  uint8_t valid = false;
+
+  int rc = bh1730_valid(&data->ctx, &valid);
+  if (rc) {
+    return rc;
+  }
+  *ready = valid;
+  return 0;
+}
+
+static int bh1730fvc_read(const struct device *dev, float *values) {
+  struct bh1730fvc_data *data = dev->data;
+  uint16_t visible, ir;
+  uint32_t lux;
+
+  int rc = bh1730_read_visible(&data->ctx, &visible);
+  if (rc == 0) {
+    rc = bh1730_read_ir(&data->ctx, &ir);
+  }
+  if (rc == 0) {
+    rc = bh1730_read_lux(&data->ctx, &lux);
+  }
+  if (rc) {
+    return rc;
+  }
+
+  values[0] = visible;
+  values[1] = ir;
+  values[2] = lux;
+  return 0;
+}
+
+static uint32_t bh1730fvc_conversion_us(const struct device *dev) {
+  struct bh1730fvc_data *data = dev->data;
+
+  return data->ctx.integration_time_us;
+}
+
+static int bh1730fvc_attr_set(const struct device *dev, enum sensor_attribute attr, const struct sensor_value *val) {
+  struct bh1730fvc_data *data = dev->data;
+
+  switch ((int)attr) {
+  case SENSEI_SENSOR_ATTR_GAIN:
+    return bh1730fvc_configure(dev, val->val1, data->integration);
+  case SENSEI_SENSOR_ATTR_INTEGRATION:
+    return val->val1 <= UINT8_MAX ? bh1730fvc_configure(dev, data->gain, val->val1) : -EINVAL;
+  default:
+    return -ENOTSUP;
+  }
+}
+
+static const sensei_sensor_ops_t bh1730fvc_ops = {
+    .init = bh1730fvc_dev_init,
+    .ready = bh1730fvc_ready,
+    .read = bh1730fvc_read,
+    .conversion_us = bh1730fvc_conversion_us,
+    .attr_set = bh1730fvc_attr_set,
+};
+
+static const struct sensor_driver_api bh1730fvc_api = SENSEI_SENSOR_API;
+
+#define BH1730FVC_DEFINE(inst)                                                                                         \
+  static struct bh1730fvc_data bh1730fvc_data_##inst = {                                                               \
+      .gain = DT_INST_PROP(inst, gain),                                                                                \
+      .integration = BH1730_INT_50MS,                                                                                  \
+  };                                                                                                                   \
+  static const struct sensei_sensor_config bh1730fvc_config_##inst =                                                   \
+      SENSEI_SENSOR_CONFIG(inst, bh1730fvc_ops, bh1730fvc_channels);                                                   \
+  SENSOR_DEVICE_DT_INST_DEFINE(inst, sensei_sensor_init, NULL, &bh1730fvc_data_##inst, &bh1730fvc_config_##inst,       \
+                               POST_KERNEL, CONFIG_SENSOR_INIT_PRIORITY, &bh1730fvc_api);
+
+DT_INST_FOREACH_STATUS_OKAY(BH1730FVC_DEFINE)
@@ -0,0 +1,229 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: ilps28qsw.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#define DT_DRV_COMPAT sensei_ilps28qsw
+
+#include <zephyr/logging/log.h>
+
+#include "ilps28qsw_reg.h"
+#include "sensei_sensor_common.h"
+
+LOG_MODULE_DECLARE(sensei_sensor, CONFIG_SENSEI_SENSORS_LOG_LEVEL);
+
+// Converts continuously at the configured ODR, the status reports a new pressure sample
+struct ilps28qsw_data {
+  struct sensei_sensor_data common;
+  stmdev_ctx_t ctx;
+  ilps28qsw_md_t md;
+  uint32_t odr; // Hz, initialized from the devicetree
+  uint32_t avg; // Samples averaged per output
+};
+
+static const sensei_sensor_channel_t ilps28qsw_channels[] = {
+    {SENSOR_CHAN_PRESS, 8},
+    {SENSOR_CHAN_AMBIENT_TEMP, 8},
+};
+
+static const struct {
+  uint32_t hz;
+  uint8_t odr;
+} ilps28qsw_odrs[] = {
+    {1, ILPS28QSW_1Hz},   {4, ILPS28QSW_4Hz},   {10, ILPS28QSW_10Hz},   {25, ILPS28QSW_25Hz},
+    {50, ILPS28QSW_50Hz}, {75, ILPS28QSW_75Hz}, {100, ILPS28QSW_100Hz}, {200, ILPS28QSW_200Hz},
+};
+
+static const struct {
+  uint32_t samples;
+  uint8_t avg;
+} ilps28qsw_avgs[] = {
+    {4, ILPS28QSW_4_AVG},   {8, ILPS28QSW_8_AVG},     {16, ILPS28QSW_16_AVG},   {32, ILPS28QSW_32_AVG},
+    {64, ILPS28QSW_64_AVG}, {128, ILPS28QSW_128_AVG}, {256, ILPS28QSW_256_AVG}, {512, ILPS28QSW_512_AVG},
+};
+
+/**
+ * @brief Changes output data rate and averaging, the sensor passes through power-down.
+ *
+ */
+static int ilps28qsw_configure(const struct device *dev, uint32_t odr, uint32_t avg) {
+  struct ilps28qsw_data *data = dev->data;
+  ilps28qsw_md_t md = data->md;
+  size_t i, j;
+
+  for (i = 0; i < ARRAY_SIZE(ilps28qsw_odrs); i++) {
+    if (ilps28qsw_odrs[i].hz == odr) {
+      break;
+    }
+  }
+  for (j = 0; j < ARRAY_SIZE(ilps28qsw_avgs); j++) {
+    if (ilps28qsw_avgs[j].samples == avg) {
+      break;
+    }
+  }
+  if (i == ARRAY_SIZE(ilps28qsw_odrs) || j == ARRAY_SIZE(ilps28qsw_avgs)) {
+    return -EINVAL;
+  }
+
+  md.odr = ILPS28QSW_ONE_SHOT;
+  int rc = ilps28qsw_mode_set(&data->ctx, &md);
+  if (rc) {
+    return rc;
+  }
+
+  md.odr = ilps28qsw_odrs[i].odr;
+  md.avg = ilps28qsw_avgs[j].avg;
+  md.lpf = ILPS28QSW_LPF_ODR_DIV_4;
+  md.fs = ILPS28QSW_1260hPa;
+  rc = ilps28qsw_mode_set(&data->ctx, &md);
+  if (rc) {
+    return rc;
+  }
+
+  data->md = md;
+  data->odr = odr;
+  data->avg = avg;
+  LOG_DBG("%s ODR %u Hz, %u samples averaged", dev->name, odr, avg);
+  return 0;
+}
+
+static int ilps28qsw_dev_init(const struct device *dev) {
+  const struct sensei_sensor_config *config = dev->config;
+  struct ilps28qsw_data *data = dev->data;
+  ilps28qsw_bus_mode_t bus_mode = {.filter = ILPS28QSW_AUTO};
+  ilps28qsw_stat_t status;
+  uint8_t id;
+
+  data->ctx.read_reg = sensei_sensor_read_reg;
+  data->ctx.write_reg = sensei_sensor_write_reg;
+  data->ctx.handle = (void *)&config->i2c;
+
+  int rc = ilps28qsw_id_get(&data->ctx, (ilps28qsw_id_t *)&id);
+  if (rc) {
+    return rc;
+  }
+  if (id != ILPS28QSW_ID) {
+    LOG_ERR("%s Unexpected ID 0x%02X", dev->name, id);
+    return -ENODEV;
+  }
+
+  // Restore the default configuration and wait for the reset to finish
+  rc = ilps28qsw_init_set(&data->ctx, ILPS28QSW_RESET);
+  for (int retries = 10; rc == 0; retries--) {
+    rc = ilps28qsw_status_get(&data->ctx, &status);
+    if (rc || !status.sw_reset) {
+      break;
+    }
+    if (retries == 0) {
+      return -ETIMEDOUT;
+    }
+    k_msleep(1);
+  }
+
+  // AH/QVAR disabled to save power, BDU and auto-increment as recommended for driver usage
+  if (rc == 0) {
+    rc = ilps28qsw_ah_qvar_en_set(&data->ctx, PROPERTY_DISABLE);
+  }
+  if (rc == 0) {
+    rc = ilps28qsw_init_set(&data->ctx, ILPS28QSW_DRV_RDY);
+  }
+  if (rc == 0) {
+    rc = ilps28qsw_bus_mode_set(&data->ctx, &bus_mode);
+  }
+  if (rc) {
+    return rc;
+  }
+  return ilps28qsw_configure(dev, data->odr, data->avg);
+}
+
+static int ilps28qsw_ready(const struct device *dev, bool *ready) {
+  struct ilps28qsw_data *data = dev->data;
+  ilps28qsw_stat_t status;
+
+  int rc = ilps28qsw_status_get(&data->ctx, &status);
+  if (rc) {
+    return rc;
+  }
+  *ready = status.drdy_pres;
+  return 0;
+}
+
+static int ilps28qsw_read(const struct device *dev, float *values) {
+  struct ilps28qsw_data *data = dev->data;
+  ilps28qsw_data_t sample;
+
+  int rc = ilps28qsw_data_get(&data->ctx, &data->md, &sample);
+  if (rc) {
+    return rc;
+  }
+
+  values[0] = sample.pressure.hpa / 10.0f; // kPa
+  values[1] = sample.heat.deg_c;
+  return 0;
+}
+
+static uint32_t ilps28qsw_conversion_us(const struct device *dev) {
+  struct ilps28qsw_data *data = dev->data;
+
+  return USEC_PER_SEC / data->odr;
+}
+
+static int ilps28qsw_attr_set(const struct device *dev, enum sensor_attribute attr, const struct sensor_value *val) {
+  struct ilps28qsw_data *data = dev->data;
+
+  switch ((int)attr) {
+  case SENSOR_ATTR_SAMPLING_FREQUENCY:
+    return ilps28qsw_configure(dev, val->val1, data->avg);
+  case SENSEI_SENSOR_ATTR_AVERAGING:
+    return ilps28qsw_configure(dev, data->odr, val->val1);
+  default:
+    return -ENOTSUP;
+  }
+}
+
+static const sensei_sensor_ops_t ilps28qsw_ops = {
+    .init = ilps28qsw_dev_init,
+    .ready = ilps28qsw_ready,
+    .read = ilps28qsw_read,
+    .conversion_us = ilps28qsw_conversion_us,
+    .attr_set = ilps28qsw_attr_set,
+};
+
+static const struct sensor_driver_api ilps28qsw_api = SENSEI_SENSOR_API;
+
+#define ILPS28QSW_DEFINE(inst)                                                                                         \
+  static struct ilps28qsw_data ilps28qsw_data_##inst = {                                                               \
+      .odr = DT_INST_PROP(inst, odr),                                                                                  \
+      .avg = DT_INST_PROP(inst, avg),                                                                                  \
+  };                                                                                                                   \
+  static const struct sensei_sensor_config ilps28qsw_config_##inst =                                                   \
+      SENSEI_SENSOR_CONFIG(inst, ilps28qsw_ops, ilps28qsw_channels);                                                   \
+  SENSOR_DEVICE_DT_INST_DEFINE(inst, sensei_sensor_init, NULL, &ilps28qsw_data_##inst, &ilps28qsw_config_##inst,       \
+                               POST_KERNEL, CONFIG_SENSOR_INIT_PRIORITY, &ilps28qsw_api);
+
+DT_INST_FOREACH_STATUS_OKAY(ILPS28QSW_DEFINE)
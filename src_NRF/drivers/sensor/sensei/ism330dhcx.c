@@ -0,0 +1,223 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: ism330dhcx.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#define DT_DRV_COMPAT sensei_ism330dhcx
+
+#include <zephyr/logging/log.h>
+
+#include "ism330dhcx_reg.h"
+#include "sensei_sensor_common.h"
+
+LOG_MODULE_DECLARE(sensei_sensor, CONFIG_SENSEI_SENSORS_LOG_LEVEL);
+
+// Full scale of 2 g and 2000 dps, the sensitivity in mg and mdps per LSB
+#define ISM330DHCX_XL_SENSITIVITY 0.061f
+#define ISM330DHCX_GY_SENSITIVITY 70.0f
+
+// The sensor API reports m/s^2 and rad/s
+#define ISM330DHCX_MG_TO_MS2 (9.80665f / 1000.0f)
+#define ISM330DHCX_MDPS_TO_RADS (3.14159265f / 180000.0f)
+
+// Accelerometer and gyroscope convert continuously at the same ODR, INT1 signals a new accelerometer sample
+struct ism330dhcx_data {
+  struct sensei_sensor_data common;
+  stmdev_ctx_t ctx;
+  uint32_t odr; // Hz, 12 for 12.5 Hz, initialized from the devicetree
+};
+
+static const sensei_sensor_channel_t ism330dhcx_channels[] = {
+    {SENSOR_CHAN_ACCEL_X, 8}, {SENSOR_CHAN_ACCEL_Y, 8}, {SENSOR_CHAN_ACCEL_Z, 8}, {SENSOR_CHAN_GYRO_X, 7},
+    {SENSOR_CHAN_GYRO_Y, 7},  {SENSOR_CHAN_GYRO_Z, 7},  {SENSOR_CHAN_DIE_TEMP, 8},
+};
+
+static const struct {
+  uint32_t hz;
+  ism330dhcx_odr_xl_t xl;
+  ism330dhcx_odr_g_t gy;
+} ism330dhcx_odrs[] = {
+    {12, ISM330DHCX_XL_ODR_12Hz5, ISM330DHCX_GY_ODR_12Hz5}, {26, ISM330DHCX_XL_ODR_26Hz, ISM330DHCX_GY_ODR_26Hz},
+    {52, ISM330DHCX_XL_ODR_52Hz, ISM330DHCX_GY_ODR_52Hz},   {104, ISM330DHCX_XL_ODR_104Hz, ISM330DHCX_GY_ODR_104Hz},
+    {208, ISM330DHCX_XL_ODR_208Hz, ISM330DHCX_GY_ODR_208Hz},
+};
+
+static int ism330dhcx_configure(const struct device *dev, uint32_t odr) {
+  struct ism330dhcx_data *data = dev->data;
+  size_t i;
+
+  for (i = 0; i < ARRAY_SIZE(ism330dhcx_odrs); i++) {
+    if (ism330dhcx_odrs[i].hz == odr) {
+      break;
+    }
+  }
+  if (i == ARRAY_SIZE(ism330dhcx_odrs)) {
+    return -EINVAL;
+  }
+
+  int rc = ism330dhcx_xl_data_rate_set(&data->ctx, ism330dhcx_odrs[i].xl);
+  if (rc == 0) {
+    rc = ism330dhcx_gy_data_rate_set(&data->ctx, ism330dhcx_odrs[i].gy);
+  }
+  if (rc) {
+    return rc;
+  }
+
+  data->odr = odr;
+  LOG_DBG("%s ODR %u Hz", dev->name, odr);
+  return 0;
+}
+
+static int ism330dhcx_dev_init(const struct device *dev) {
+  const struct sensei_sensor_config *config = dev->config;
+  struct ism330dhcx_data *data = dev->data;
+  uint8_t id, rst;
+
+  data->ctx.read_reg = sensei_sensor_read_reg;
+  data->ctx.write_reg = sensei_sensor_write_reg;
+  data->ctx.handle = (void *)&config->i2c;
+
+  int rc = ism330dhcx_device_id_get(&data->ctx, &id);
+  if (rc) {
+    return rc;
+  }
+  if (id != ISM330DHCX_ID) {
+    LOG_ERR("%s Unexpected ID 0x%02X", dev->name, id);
+    return -ENODEV;
+  }
+
+  rc = ism330dhcx_reset_set(&data->ctx, PROPERTY_ENABLE);
+  for (int retries = 10; rc == 0; retries--) {
+    rc = ism330dhcx_reset_get(&data->ctx, &rst);
+    if (rc || !rst) {
+      break;
+    }
+    if (retries == 0) {
+      return -ETIMEDOUT;
+    }
+    k_msleep(1);
+  }
+
+  if (rc == 0) {
+    rc = ism330dhcx_auto_increment_set(&data->ctx, PROPERTY_ENABLE);
+  }
+  if (rc == 0) {
+    rc = ism330dhcx_block_data_update_set(&data->ctx, PROPERTY_ENABLE);
+  }
+  if (rc == 0) {
+    rc = ism330dhcx_fifo_mode_set(&data->ctx, ISM330DHCX_BYPASS_MODE);
+  }
+  if (rc == 0) {
+    rc = ism330dhcx_xl_full_scale_set(&data->ctx, ISM330DHCX_2g);
+  }
+  if (rc == 0) {
+    rc = ism330dhcx_gy_full_scale_set(&data->ctx, ISM330DHCX_2000dps);
+  }
+  if (rc == 0 && config->drdy.port) {
+    ism330dhcx_pin_int1_route_t route;
+
+    rc = ism330dhcx_pin_int1_route_get(&data->ctx, &route);
+    if (rc == 0) {
+      route.int1_ctrl.int1_drdy_xl = PROPERTY_ENABLE;
+      rc = ism330dhcx_pin_int1_route_set(&data->ctx, &route);
+    }
+  }
+  if (rc) {
+    return rc;
+  }
+  return ism330dhcx_configure(dev, data->odr);
+}
+
+static int ism330dhcx_ready(const struct device *dev, bool *ready) {
+  struct ism330dhcx_data *data = dev->data;
+  uint8_t drdy;
+
+  int rc = ism330dhcx_xl_flag_data_ready_get(&data->ctx, &drdy);
+  if (rc) {
+    return rc;
+  }
+  *ready = drdy;
+  return 0;
+}
+
+static int ism330dhcx_read(const struct device *dev, float *values) {
+  struct ism330dhcx_data *data = dev->data;
+  int16_t xl[3], gy[3], temp;
+
+  int rc = ism330dhcx_acceleration_raw_get(&data->ctx, xl);
+  if (rc == 0) {
+    rc = ism330dhcx_angular_rate_raw_get(&data->ctx, gy);
+  }
+  if (rc == 0) {
+    rc = ism330dhcx_temperature_raw_get(&data->ctx, &temp);
+  }
+  if (rc) {
+    return rc;
+  }
+
+  for (size_t i = 0; i < 3; i++) {
+    values[i] = xl[i] * ISM330DHCX_XL_SENSITIVITY * ISM330DHCX_MG_TO_MS2;
+    values[3 + i] = gy[i] * ISM330DHCX_GY_SENSITIVITY * ISM330DHCX_MDPS_TO_RADS;
+  }
+  values[6] = temp / 256.0f + 25.0f;
+  return 0;
+}
+
+static uint32_t ism330dhcx_conversion_us(const struct device *dev) {
+  struct ism330dhcx_data *data = dev->data;
+
+  return USEC_PER_SEC / data->odr;
+}
+
+static int ism330dhcx_attr_set(const struct device *dev, enum sensor_attribute attr, const struct sensor_value *val) {
+  switch ((int)attr) {
+  case SENSOR_ATTR_SAMPLING_FREQUENCY:
+    return ism330dhcx_configure(dev, val->val1);
+  default:
+    return -ENOTSUP;
+  }
+}
+
+static const sensei_sensor_ops_t ism330dhcx_ops = {
+    .init = ism330dhcx_dev_init,
+    .ready = ism330dhcx_ready,
+    .read = ism330dhcx_read,
+    .conversion_us = ism330dhcx_conversion_us,
+    .attr_set = ism330dhcx_attr_set,
+};
+
+static const struct sensor_driver_api ism330dhcx_api = SENSEI_SENSOR_API;
+
+#define ISM330DHCX_DEFINE(inst)                                                                                        \
+  static struct ism330dhcx_data ism330dhcx_data_##inst = {.odr = DT_INST_PROP(inst, odr)};                             \
+  static const struct sensei_sensor_config ism330dhcx_config_##inst =                                                  \
+      SENSEI_SENSOR_CONFIG(inst, ism330dhcx_ops, ism330dhcx_channels);                                                 \
+  SENSOR_DEVICE_DT_INST_DEFINE(inst, sensei_sensor_init, NULL, &ism330dhcx_data_##inst, &ism330dhcx_config_##inst,     \
+                               POST_KERNEL, CONFIG_SENSOR_INIT_PRIORITY, &ism330dhcx_api);
+
+DT_INST_FOREACH_STATUS_OKAY(ISM330DHCX_DEFINE)
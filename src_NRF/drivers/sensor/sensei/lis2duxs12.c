@@ -0,0 +1,218 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: lis2duxs12.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#define DT_DRV_COMPAT sensei_lis2duxs12
+
+#include <zephyr/logging/log.h>
+
+#include "lis2duxs12_reg.h"
+#include "sensei_sensor_common.h"
+
+LOG_MODULE_DECLARE(sensei_sensor, CONFIG_SENSEI_SENSORS_LOG_LEVEL);
+
+// The sensor API reports m/s^2
+#define LIS2DUXS12_MG_TO_MS2 (9.80665f / 1000.0f)
+
+// Converts continuously in ultra-low-power mode with a full scale of 2 g, INT1 signals a new sample
+struct lis2duxs12_data {
+  struct sensei_sensor_data common;
+  stmdev_ctx_t ctx;
+  lis2duxs12_md_t md;
+  uint32_t odr; // Hz, 1 for 1.6 Hz, initialized from the devicetree
+};
+
+static const sensei_sensor_channel_t lis2duxs12_channels[] = {
+    {SENSOR_CHAN_ACCEL_X, 8},
+    {SENSOR_CHAN_ACCEL_Y, 8},
+    {SENSOR_CHAN_ACCEL_Z, 8},
+    {SENSOR_CHAN_DIE_TEMP, 8},
+};
+
+static const struct {
+  uint32_t hz;
+  uint32_t period_us;
+  uint8_t odr;
+} lis2duxs12_odrs[] = {
+    {1, 625000, LIS2DUXS12_1Hz6_ULP},
+    {3, 333334, LIS2DUXS12_3Hz_ULP},
+    {25, 40000, LIS2DUXS12_25Hz_ULP},
+};
+
+static int lis2duxs12_odr_index(uint32_t odr) {
+  for (size_t i = 0; i < ARRAY_SIZE(lis2duxs12_odrs); i++) {
+    if (lis2duxs12_odrs[i].hz == odr) {
+      return i;
+    }
+  }
+  return -EINVAL;
+}
+
+static int lis2duxs12_configure(const struct device *dev, uint32_t odr) {
+  struct lis2duxs12_data *data = dev->data;
+  lis2duxs12_md_t md = data->md;
+  int i = lis2duxs12_odr_index(odr);
+
+  if (i < 0) {
+    return i;
+  }
+
+  md.fs = LIS2DUXS12_2g;
+  md.bw = LIS2DUXS12_ODR_div_16;
+  md.odr = lis2duxs12_odrs[i].odr;
+  int rc = lis2duxs12_mode_set(&data->ctx, &md);
+  if (rc) {
+    return rc;
+  }
+
+  data->md = md;
+  data->odr = odr;
+  LOG_DBG("%s ODR index %d", dev->name, i);
+  return 0;
+}
+
+static int lis2duxs12_dev_init(const struct device *dev) {
+  const struct sensei_sensor_config *config = dev->config;
+  struct lis2duxs12_data *data = dev->data;
+  lis2duxs12_status_t status;
+  uint8_t id;
+
+  data->ctx.read_reg = sensei_sensor_read_reg;
+  data->ctx.write_reg = sensei_sensor_write_reg;
+  data->ctx.handle = (void *)&config->i2c;
+
+  int rc = lis2duxs12_exit_deep_power_down(&data->ctx);
+  if (rc == 0) {
+    rc = lis2duxs12_device_id_get(&data->ctx, &id);
+  }
+  if (rc) {
+    return rc;
+  }
+  if (id != LIS2DUXS12_ID) {
+    LOG_ERR("%s Unexpected ID 0x%02X", dev->name, id);
+    return -ENODEV;
+  }
+
+  // Restore the default configuration and wait for the reset to finish
+  rc = lis2duxs12_init_set(&data->ctx, LIS2DUXS12_RESET);
+  for (int retries = 10; rc == 0; retries--) {
+    rc = lis2duxs12_status_get(&data->ctx, &status);
+    if (rc || !status.sw_reset) {
+      break;
+    }
+    if (retries == 0) {
+      return -ETIMEDOUT;
+    }
+    k_msleep(1);
+  }
+
+  if (rc == 0) {
+    rc = lis2duxs12_init_set(&data->ctx, LIS2DUXS12_SENSOR_ONLY_ON);
+  }
+  if (rc == 0 && config->drdy.port) {
+    lis2duxs12_pin_int_route_t route;
+
+    rc = lis2duxs12_pin_int1_route_get(&data->ctx, &route);
+    if (rc == 0) {
+      route.drdy = PROPERTY_ENABLE;
+      rc = lis2duxs12_pin_int1_route_set(&data->ctx, &route);
+    }
+  }
+  if (rc) {
+    return rc;
+  }
+  return lis2duxs12_configure(dev, data->odr);
+}
+
+static int lis2duxs12_ready(const struct device *dev, bool *ready) {
+  struct lis2duxs12_data *data = dev->data;
+  lis2duxs12_status_t status;
+
+  int rc = lis2duxs12_status_get(&data->ctx, &status);
+  if (rc) {
+    return rc;
+  }
+  *ready = status.drdy;
+  return 0;
+}
+
+static int lis2duxs12_read(const struct device *dev, float *values) {
+  struct lis2duxs12_data *data = dev->data;
+  lis2duxs12_xl_data_t xl;
+  lis2duxs12_outt_data_t temp;
+
+  int rc = lis2duxs12_xl_data_get(&data->ctx, &data->md, &xl);
+  if (rc == 0) {
+    rc = lis2duxs12_outt_data_get(&data->ctx, &data->md, &temp);
+  }
+  if (rc) {
+    return rc;
+  }
+
+  for (size_t i = 0; i < 3; i++) {
+    values[i] = xl.mg[i] * LIS2DUXS12_MG_TO_MS2;
+  }
+  values[3] = temp.heat.deg_c;
+  return 0;
+}
+
+static uint32_t lis2duxs12_conversion_us(const struct device *dev) {
+  struct lis2duxs12_data *data = dev->data;
+  int i = lis2duxs12_odr_index(data->odr);
+
+  return i < 0 ? 0 : lis2duxs12_odrs[i].period_us;
+}
+
+static int lis2duxs12_attr_set(const struct device *dev, enum sensor_attribute attr, const struct sensor_value *val) {
+  switch ((int)attr) {
+  case SENSOR_ATTR_SAMPLING_FREQUENCY:
+    return lis2duxs12_configure(dev, val->val1);
+  default:
+    return -ENOTSUP;
+  }
+}
+
+static const sensei_sensor_ops_t lis2duxs12_ops = {
+    .init = lis2duxs12_dev_init,
+    .ready = lis2duxs12_ready,
+    .read = lis2duxs12_read,
+    .conversion_us = lis2duxs12_conversion_us,
+    .attr_set = lis2duxs12_attr_set,
+};
+
+static const struct sensor_driver_api lis2duxs12_api = SENSEI_SENSOR_API;
+
+#define LIS2DUXS12_DEFINE(inst)                                                                                        \
+  static struct lis2duxs12_data lis2duxs12_data_##inst = {.odr = DT_INST_PROP(inst, odr)};                             \
+  static const struct sensei_sensor_config lis2duxs12_config_##inst =                                                  \
+      SENSEI_SENSOR_CONFIG(inst, lis2duxs12_ops, lis2duxs12_channels);                                                 \
+  SENSOR_DEVICE_DT_INST_DEFINE(inst, sensei_sensor_init, NULL, &lis2duxs12_data_##inst, &lis2duxs12_config_##inst,     \
+                               POST_KERNEL, CONFIG_SENSOR_INIT_PRIORITY, &lis2duxs12_api);
+
+DT_INST_FOREACH_STATUS_OKAY(LIS2DUXS12_DEFINE)
@@ -0,0 +1,157 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: scd41.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#define DT_DRV_COMPAT sensei_scd41
+
+#include <zephyr/logging/log.h>
+
+#include "sensei_sensor_common.h"
+
+LOG_MODULE_DECLARE(sensei_sensor, CONFIG_SENSEI_SENSORS_LOG_LEVEL);
+
+#define SCD41_CMD_START_PERIODIC 0x21B1
+#define SCD41_CMD_STOP_PERIODIC 0x3F86
+#define SCD41_CMD_MEASURE_SINGLE_SHOT 0x219D
+#define SCD41_CMD_GET_DATA_READY 0xE4B8
+#define SCD41_CMD_READ_MEASUREMENT 0xEC05
+#define SCD41_CMD_WAKE_UP 0x36F6
+
+#define SCD41_STOP_TIME 500    // ms until the sensor accepts commands after stopping the periodic measurement
+#define SCD41_WAKE_UP_TIME 30  // ms
+#define SCD41_COMMAND_TIME 1   // ms between a read command and its response
+#define SCD41_INTERVAL 5000000 // us, periodic measurement interval and single-shot conversion time
+
+// Periodic measurement mode, or single-shot conversions with the sensor idle in between
+struct scd41_data {
+  struct sensei_sensor_data common;
+};
+
+static const sensei_sensor_channel_t scd41_channels[] = {
+    {SENSOR_CHAN_CO2, 16},
+    {SENSOR_CHAN_AMBIENT_TEMP, 8},
+    {SENSOR_CHAN_HUMIDITY, 7},
+};
+
+static int scd41_command(const struct device *dev, uint16_t cmd) {
+  const struct sensei_sensor_config *config = dev->config;
+
+  return sensei_sensirion_write(&config->i2c, cmd, NULL, 0);
+}
+
+static int scd41_query(const struct device *dev, uint16_t cmd, uint16_t *words, size_t count) {
+  const struct sensei_sensor_config *config = dev->config;
+
+  int rc = sensei_sensirion_write(&config->i2c, cmd, NULL, 0);
+  if (rc) {
+    return rc;
+  }
+  k_msleep(SCD41_COMMAND_TIME);
+  return sensei_sensirion_read(&config->i2c, words, count);
+}
+
+static int scd41_stop(const struct device *dev) {
+  // The sensor does not acknowledge the wake-up command
+  scd41_command(dev, SCD41_CMD_WAKE_UP);
+  k_msleep(SCD41_WAKE_UP_TIME);
+
+  int rc = scd41_command(dev, SCD41_CMD_STOP_PERIODIC);
+  if (rc) {
+    return rc;
+  }
+  k_msleep(SCD41_STOP_TIME);
+  return 0;
+}
+
+static int scd41_periodic_init(const struct device *dev) {
+  int rc = scd41_stop(dev);
+  if (rc) {
+    return rc;
+  }
+  return scd41_command(dev, SCD41_CMD_START_PERIODIC);
+}
+
+static int scd41_single_shot_start(const struct device *dev) {
+  return scd41_command(dev, SCD41_CMD_MEASURE_SINGLE_SHOT);
+}
+
+static int scd41_ready(const struct device *dev, bool *ready) {
+  uint16_t status;
+
+  int rc = scd41_query(dev, SCD41_CMD_GET_DATA_READY, &status, 1);
+  if (rc) {
+    return rc;
+  }
+  *ready = (status & 0x07FF) != 0;
+  return 0;
+}
+
+static int scd41_read(const struct device *dev, float *values) {
+  uint16_t words[3];
+
+  int rc = scd41_query(dev, SCD41_CMD_READ_MEASUREMENT, words, ARRAY_SIZE(words));
+  if (rc) {
+    return rc;
+  }
+
+  values[0] = words[0];
+  values[1] = -45.0f + 175.0f * words[1] / 65535.0f;
+  values[2] = 100.0f * words[2] / 65535.0f;
+  return 0;
+}
+
+static uint32_t scd41_conversion_us(const struct device *dev) { return SCD41_INTERVAL; }
+
+static const sensei_sensor_ops_t scd41_periodic_ops = {
+    .init = scd41_periodic_init,
+    .ready = scd41_ready,
+    .read = scd41_read,
+    .conversion_us = scd41_conversion_us,
+};
+
+static const sensei_sensor_ops_t scd41_single_shot_ops = {
+    .init = scd41_stop,
+    .start = scd41_single_shot_start,
+    .ready = scd41_ready,
+    .read = scd41_read,
+    .conversion_us = scd41_conversion_us,
+};
+
+static const struct sensor_driver_api scd41_api = SENSEI_SENSOR_API;
+
+#define SCD41_OPS(inst) COND_CODE_1(DT_INST_PROP(inst, single_shot), (scd41_single_shot_ops), (scd41_periodic_ops))
+
+#define SCD41_DEFINE(inst)                                                                                             \
+  static struct scd41_data scd41_data_##inst;                                                                          \
+  static const struct sensei_sensor_config scd41_config_##inst =                                                       \
+      SENSEI_SENSOR_CONFIG(inst, SCD41_OPS(inst), scd41_channels);                                                     \
+  SENSOR_DEVICE_DT_INST_DEFINE(inst, sensei_sensor_init, NULL, &scd41_data_##inst, &scd41_config_##inst, POST_KERNEL,  \
+                               CONFIG_SENSOR_INIT_PRIORITY, &scd41_api);
+
+DT_INST_FOREACH_STATUS_OKAY(SCD41_DEFINE)
@@ -0,0 +1,91 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: sensei_sensirion.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/crc.h>
+
+#include "sensei_sensor_common.h"
+
+#define SENSIRION_CRC_POLY 0x31
+#define SENSIRION_CRC_INIT 0xFF
+#define SENSIRION_MAX_WORDS 3
+
+static uint8_t sensirion_crc(const uint8_t *data) {
+  return crc8(data, 2, SENSIRION_CRC_POLY, SENSIRION_CRC_INIT, false);
+}
+
+/**
+ * @brief Sends a command with up to SENSIRION_MAX_WORDS argument words.
+ *
+ * @return 0 on success, negative on error
+ */
+int sensei_sensirion_write(const struct i2c_dt_spec *i2c, uint16_t cmd, const uint16_t *args, size_t count) {
+  uint8_t buf[2 + 3 * SENSIRION_MAX_WORDS];
+
+  if (count > SENSIRION_MAX_WORDS) {
+    return -EINVAL;
+  }
+
+  sys_put_be16(cmd, buf);
+  for (size_t i = 0; i < count; i++) {
+    uint8_t *word = &buf[2 + 3 * i];
+
+    sys_put_be16(args[i], word);
+    word[2] = sensirion_crc(word);
+  }
+  return i2c_write_dt(i2c, buf, 2 + 3 * count);
+}
+
+/**
+ * @brief Reads the response words of the previous command and checks their CRC.
+ *
+ * @return 0 on success, -EIO on a CRC mismatch, negative on error
+ */
+int sensei_sensirion_read(const struct i2c_dt_spec *i2c, uint16_t *words, size_t count) {
+  uint8_t buf[3 * SENSIRION_MAX_WORDS];
+
+  if (count > SENSIRION_MAX_WORDS) {
+    return -EINVAL;
+  }
+
+  int rc = i2c_read_dt(i2c, buf, 3 * count);
+  if (rc) {
+    return rc;
+  }
+  for (size_t i = 0; i < count; i++) {
+    const uint8_t *word = &buf[3 * i];
+
+    if (sensirion_crc(word) != word[2]) {
+      return -EIO;
+    }
+    words[i] = sys_get_be16(word);
+  }
+  return 0;
+}
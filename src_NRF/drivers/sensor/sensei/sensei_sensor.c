@@ -0,0 +1,526 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: sensei_sensor.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <math.h>
+
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+
+#include "sensei_sensor_common.h"
+
+LOG_MODULE_REGISTER(sensei_sensor, CONFIG_SENSEI_SENSORS_LOG_LEVEL);
+
+// Conversions of all parts run on one queue, the parts share the bus anyway
+static K_THREAD_STACK_DEFINE(sensei_sensor_stack, CONFIG_SENSEI_SENSORS_WORKQ_STACK_SIZE);
+static struct k_work_q sensei_sensor_workq;
+
+// Streams do not restart before the previous sample was consumed, see sensei_sensor_submit()
+#define SENSEI_SENSOR_POLL K_USEC(CONFIG_SENSEI_SENSORS_POLL_US)
+
+static inline const struct sensei_sensor_config *sensei_config(const struct device *dev) { return dev->config; }
+static inline struct sensei_sensor_data *sensei_data(const struct device *dev) { return dev->data; }
+
+// A conversion not ready after twice its expected time has failed
+static uint32_t sensei_sensor_timeout_ms(const struct device *dev) {
+  return 2 * DIV_ROUND_UP(sensei_config(dev)->ops->conversion_us(dev), 1000) + CONFIG_SENSEI_SENSORS_TIMEOUT_MARGIN_MS;
+}
+
+// ----------------- Register Access -----------------------------------------------------------------------------------
+int32_t sensei_sensor_write_reg(void *handle, uint8_t reg, const uint8_t *buf, uint16_t len) {
+  return i2c_burst_write_dt(handle, reg, buf, len);
+}
+
+int32_t sensei_sensor_read_reg(void *handle, uint8_t reg, uint8_t *buf, uint16_t len) {
+  return i2c_burst_read_dt(handle, reg, buf, len);
+}
+
+// ----------------- Conversion ----------------------------------------------------------------------------------------
+/**
+ * @brief Configures the part on first use.
+ *
+ * The supply of several parts is switched by the application, so nothing is sent to the part during boot.
+ */
+static int sensei_sensor_prepare(const struct device *dev) {
+  struct sensei_sensor_data *data = sensei_data(dev);
+
+  if (data->initialized) {
+    return 0;
+  }
+
+  int rc = sensei_config(dev)->ops->init(dev);
+  if (rc) {
+    LOG_ERR("%s Error %d initializing", dev->name, rc);
+    return rc;
+  }
+  data->initialized = true;
+  return 0;
+}
+
+/**
+ * @brief Starts a conversion, a continuously converting part only rearms the data-ready line.
+ *
+ */
+static int sensei_sensor_start(const struct device *dev) {
+  const struct sensei_sensor_config *config = sensei_config(dev);
+  struct sensei_sensor_data *data = sensei_data(dev);
+
+  atomic_clear(&data->drdy);
+  if (config->ops->start) {
+    int rc = config->ops->start(dev);
+    if (rc) {
+      return rc;
+    }
+  }
+  data->start_ms = k_uptime_get();
+  data->converting = true;
+  return 0;
+}
+
+static int sensei_sensor_check(const struct device *dev, bool *ready) {
+  const struct sensei_sensor_config *config = sensei_config(dev);
+  struct sensei_sensor_data *data = sensei_data(dev);
+
+  if (config->drdy.port && atomic_get(&data->drdy)) {
+    *ready = true;
+    return 0;
+  }
+  return config->ops->ready(dev, ready);
+}
+
+static void sensei_sensor_drdy_isr(const struct device *port, struct gpio_callback *cb, gpio_port_pins_t pins) {
+  struct sensei_sensor_data *data = CONTAINER_OF(cb, struct sensei_sensor_data, drdy_cb);
+
+  atomic_set(&data->drdy, 1);
+  k_work_reschedule_for_queue(&sensei_sensor_workq, &data->work, K_NO_WAIT);
+}
+
+// ----------------- Blocking API --------------------------------------------------------------------------------------
+int sensei_sensor_sample_fetch(const struct device *dev, enum sensor_channel chan) {
+  const struct sensei_sensor_config *config = sensei_config(dev);
+  struct sensei_sensor_data *data = sensei_data(dev);
+  bool ready = false;
+
+  k_mutex_lock(&data->lock, K_FOREVER);
+  int rc = data->sqe ? -EBUSY : sensei_sensor_prepare(dev);
+  if (rc == 0) {
+    rc = sensei_sensor_start(dev);
+  }
+  if (rc == 0 && config->ops->start) {
+    k_usleep(config->ops->conversion_us(dev));
+  }
+  while (rc == 0) {
+    rc = sensei_sensor_check(dev, &ready);
+    if (rc || ready) {
+      break;
+    }
+    if (k_uptime_get() - data->start_ms > sensei_sensor_timeout_ms(dev)) {
+      rc = -ETIMEDOUT;
+      break;
+    }
+    k_sleep(SENSEI_SENSOR_POLL);
+  }
+  if (rc == 0) {
+    rc = config->ops->read(dev, data->values);
+  }
+  data->converting = false;
+  k_mutex_unlock(&data->lock);
+  return rc;
+}
+
+int sensei_sensor_channel_get(const struct device *dev, enum sensor_channel chan, struct sensor_value *val) {
+  const struct sensei_sensor_config *config = sensei_config(dev);
+  struct sensei_sensor_data *data = sensei_data(dev);
+  size_t count = 1;
+
+  // The three axes are consecutive in the channel table
+  switch (chan) {
+  case SENSOR_CHAN_ACCEL_XYZ:
+    chan = SENSOR_CHAN_ACCEL_X;
+    count = 3;
+    break;
+  case SENSOR_CHAN_GYRO_XYZ:
+    chan = SENSOR_CHAN_GYRO_X;
+    count = 3;
+    break;
+  default:
+    break;
+  }
+
+  for (size_t i = 0; i + count <= config->channel_count; i++) {
+    if (config->channels[i].chan == chan) {
+      for (size_t j = 0; j < count; j++) {
+        sensor_value_from_float(&val[j], data->values[i + j]);
+      }
+      return 0;
+    }
+  }
+  return -ENOTSUP;
+}
+
+int sensei_sensor_attr_set(const struct device *dev, enum sensor_channel chan, enum sensor_attribute attr,
+                           const struct sensor_value *val) {
+  const struct sensei_sensor_config *config = sensei_config(dev);
+  struct sensei_sensor_data *data = sensei_data(dev);
+  int rc = 0;
+
+  k_mutex_lock(&data->lock, K_FOREVER);
+  if (data->sqe) {
+    rc = -EBUSY;
+  } else if (attr == (enum sensor_attribute)SENSEI_SENSOR_ATTR_INIT) {
+    data->initialized = false;
+    rc = sensei_sensor_prepare(dev);
+  } else if (config->ops->attr_set == NULL) {
+    rc = -ENOTSUP;
+  } else {
+    rc = sensei_sensor_prepare(dev);
+    if (rc == 0) {
+      rc = config->ops->attr_set(dev, attr, val);
+    }
+  }
+  k_mutex_unlock(&data->lock);
+  return rc;
+}
+
+int sensei_sensor_attr_get(const struct device *dev, enum sensor_channel chan, enum sensor_attribute attr,
+                           struct sensor_value *val) {
+  struct sensei_sensor_data *data = sensei_data(dev);
+
+  if (attr != (enum sensor_attribute)SENSEI_SENSOR_ATTR_CONVERSION_TIME) {
+    return -ENOTSUP;
+  }
+
+  k_mutex_lock(&data->lock, K_FOREVER);
+  val->val1 = sensei_config(dev)->ops->conversion_us(dev);
+  val->val2 = 0;
+  k_mutex_unlock(&data->lock);
+  return 0;
+}
+
+// ----------------- RTIO Submission -----------------------------------------------------------------------------------
+static q31_t sensei_sensor_to_q31(float value, int8_t shift) {
+  float scaled = ldexpf(value, 31 - shift);
+
+  if (scaled >= (float)INT32_MAX) {
+    return INT32_MAX;
+  }
+  if (scaled <= (float)INT32_MIN) {
+    return INT32_MIN;
+  }
+  return (q31_t)lroundf(scaled);
+}
+
+/**
+ * @brief Completes the pending submission with the sample in values, or with the error.
+ *
+ */
+static void sensei_sensor_complete(const struct device *dev, int rc, const float *values) {
+  const struct sensei_sensor_config *config = sensei_config(dev);
+  struct sensei_sensor_data *data = sensei_data(dev);
+  struct rtio_iodev_sqe *sqe = data->sqe;
+  const struct sensor_read_config *read_config = sqe->sqe.iodev->data;
+  uint32_t size = sizeof(sensei_sensor_frame_t) + (values ? config->channel_count : 0) * sizeof(sensei_sensor_entry_t);
+  uint8_t *buf;
+  uint32_t buf_len;
+
+  data->sqe = NULL;
+  data->converting = false;
+  if (config->drdy.port) {
+    gpio_pin_interrupt_configure_dt(&config->drdy, GPIO_INT_DISABLE);
+  }
+
+  if (rc == 0) {
+    rc = rtio_sqe_rx_buf(sqe, size, size, &buf, &buf_len);
+  }
+  if (rc) {
+    rtio_iodev_sqe_err(sqe, rc);
+    return;
+  }
+
+  sensei_sensor_frame_t *frame = (sensei_sensor_frame_t *)buf;
+  sensei_sensor_entry_t *entries = (sensei_sensor_entry_t *)(frame + 1);
+
+  *frame = (sensei_sensor_frame_t){
+      .timestamp_ns = k_ticks_to_ns_floor64(k_uptime_ticks()),
+      .count = values ? config->channel_count : 0,
+      .triggers = read_config->is_streaming ? BIT(SENSOR_TRIG_DATA_READY) : 0,
+  };
+  for (size_t i = 0; i < frame->count; i++) {
+    const sensei_sensor_channel_t *channel = &config->channels[i];
+
+    entries[i] = (sensei_sensor_entry_t){
+        .value = sensei_sensor_to_q31(values[i], channel->shift),
+        .chan = channel->chan,
+        .shift = channel->shift,
+    };
+  }
+  // Completing a stream resubmits it, which starts the next conversion
+  rtio_iodev_sqe_ok(sqe, 0);
+}
+
+static void sensei_sensor_work(struct k_work *work) {
+  struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+  struct sensei_sensor_data *data = CONTAINER_OF(dwork, struct sensei_sensor_data, work);
+  const struct device *dev = data->dev;
+  const struct sensei_sensor_config *config = sensei_config(dev);
+  float values[SENSEI_SENSOR_MAX_CHANNELS];
+  bool ready = false;
+  int rc = 0;
+
+  k_mutex_lock(&data->lock, K_FOREVER);
+  if (data->sqe == NULL) {
+    goto out;
+  }
+
+  const struct sensor_read_config *read_config = data->sqe->sqe.iodev->data;
+
+  // Start the conversion and come back once it is expected to be finished or the data-ready line fires
+  if (!data->converting) {
+    rc = sensei_sensor_prepare(dev);
+    if (rc == 0) {
+      rc = sensei_sensor_start(dev);
+    }
+    if (rc) {
+      sensei_sensor_complete(dev, rc, NULL);
+      goto out;
+    }
+    if (config->drdy.port) {
+      gpio_pin_interrupt_configure_dt(&config->drdy, GPIO_INT_EDGE_TO_ACTIVE);
+    }
+    // A stream waits one output interval of a continuously converting part, a read takes the latest sample
+    if (config->ops->start || read_config->is_streaming) {
+      k_work_reschedule_for_queue(&sensei_sensor_workq, &data->work,
+                                  config->drdy.port ? K_MSEC(sensei_sensor_timeout_ms(dev))
+                                                    : K_USEC(config->ops->conversion_us(dev)));
+      goto out;
+    }
+  }
+
+  rc = sensei_sensor_check(dev, &ready);
+  if (rc) {
+    sensei_sensor_complete(dev, rc, NULL);
+    goto out;
+  }
+  if (!ready) {
+    if (k_uptime_get() - data->start_ms > sensei_sensor_timeout_ms(dev)) {
+      LOG_WRN("%s Timeout waiting for data ready", dev->name);
+      sensei_sensor_complete(dev, -ETIMEDOUT, NULL);
+    } else {
+      k_work_reschedule_for_queue(&sensei_sensor_workq, &data->work, SENSEI_SENSOR_POLL);
+    }
+    goto out;
+  }
+
+  // A stream with SENSOR_STREAM_DATA_DROP or _NOP only reports the trigger
+  if (read_config->is_streaming && read_config->triggers[0].opt != SENSOR_STREAM_DATA_INCLUDE) {
+    sensei_sensor_complete(dev, 0, NULL);
+    goto out;
+  }
+
+  rc = config->ops->read(dev, values);
+  sensei_sensor_complete(dev, rc, rc ? NULL : values);
+
+out:
+  k_mutex_unlock(&data->lock);
+}
+
+void sensei_sensor_submit(const struct device *dev, struct rtio_iodev_sqe *iodev_sqe) {
+  const struct sensor_read_config *read_config = iodev_sqe->sqe.iodev->data;
+  struct sensei_sensor_data *data = sensei_data(dev);
+
+  if (read_config->is_streaming) {
+    for (size_t i = 0; i < read_config->count; i++) {
+      if (read_config->triggers[i].trigger != SENSOR_TRIG_DATA_READY) {
+        rtio_iodev_sqe_err(iodev_sqe, -ENOTSUP);
+        return;
+      }
+    }
+  }
+
+  k_mutex_lock(&data->lock, K_FOREVER);
+  if (data->sqe) {
+    k_mutex_unlock(&data->lock);
+    rtio_iodev_sqe_err(iodev_sqe, -EBUSY);
+    return;
+  }
+  data->sqe = iodev_sqe;
+  k_work_reschedule_for_queue(&sensei_sensor_workq, &data->work, K_NO_WAIT);
+  k_mutex_unlock(&data->lock);
+}
+
+// ----------------- Decoder -------------------------------------------------------------------------------------------
+static const sensei_sensor_entry_t *sensei_decoder_find(const uint8_t *buffer, uint16_t chan) {
+  const sensei_sensor_frame_t *frame = (const sensei_sensor_frame_t *)buffer;
+  const sensei_sensor_entry_t *entries = (const sensei_sensor_entry_t *)(frame + 1);
+
+  for (size_t i = 0; i < frame->count; i++) {
+    if (entries[i].chan == chan) {
+      return &entries[i];
+    }
+  }
+  return NULL;
+}
+
+// First channel of a three-axis channel, the axes are consecutive entries
+static uint16_t sensei_decoder_axis(enum sensor_channel chan) {
+  switch (chan) {
+  case SENSOR_CHAN_ACCEL_XYZ:
+    return SENSOR_CHAN_ACCEL_X;
+  case SENSOR_CHAN_GYRO_XYZ:
+    return SENSOR_CHAN_GYRO_X;
+  default:
+    return SENSOR_CHAN_MAX;
+  }
+}
+
+static int sensei_decoder_get_frame_count(const uint8_t *buffer, struct sensor_chan_spec chan_spec,
+                                          uint16_t *frame_count) {
+  uint16_t axis = sensei_decoder_axis(chan_spec.chan_type);
+
+  if (chan_spec.chan_idx != 0 ||
+      sensei_decoder_find(buffer, axis != SENSOR_CHAN_MAX ? axis : chan_spec.chan_type) == NULL) {
+    return -ENOTSUP;
+  }
+  *frame_count = 1;
+  return 0;
+}
+
+static int sensei_decoder_get_size_info(struct sensor_chan_spec chan_spec, size_t *base_size, size_t *frame_size) {
+  if (sensei_decoder_axis(chan_spec.chan_type) != SENSOR_CHAN_MAX) {
+    *base_size = sizeof(struct sensor_three_axis_data);
+    *frame_size = sizeof(struct sensor_three_axis_sample_data);
+  } else {
+    *base_size = sizeof(struct sensor_q31_data);
+    *frame_size = sizeof(struct sensor_q31_sample_data);
+  }
+  return 0;
+}
+
+static int sensei_decoder_decode(const uint8_t *buffer, struct sensor_chan_spec chan_spec, uint32_t *fit,
+                                 uint16_t max_count, void *data_out) {
+  const sensei_sensor_frame_t *frame = (const sensei_sensor_frame_t *)buffer;
+  uint16_t axis = sensei_decoder_axis(chan_spec.chan_type);
+
+  // Every frame holds one sample
+  if (*fit != 0 || max_count == 0 || chan_spec.chan_idx != 0) {
+    return 0;
+  }
+
+  if (axis != SENSOR_CHAN_MAX) {
+    const sensei_sensor_entry_t *entry = sensei_decoder_find(buffer, axis);
+    struct sensor_three_axis_data *out = data_out;
+
+    if (entry == NULL) {
+      return -ENOTSUP;
+    }
+    out->header.base_timestamp_ns = frame->timestamp_ns;
+    out->header.reading_count = 1;
+    out->shift = entry->shift;
+    out->readings[0].timestamp_delta = 0;
+    out->readings[0].x = entry[0].value;
+    out->readings[0].y = entry[1].value;
+    out->readings[0].z = entry[2].value;
+  } else {
+    const sensei_sensor_entry_t *entry = sensei_decoder_find(buffer, chan_spec.chan_type);
+    struct sensor_q31_data *out = data_out;
+
+    if (entry == NULL) {
+      return -ENOTSUP;
+    }
+    out->header.base_timestamp_ns = frame->timestamp_ns;
+    out->header.reading_count = 1;
+    out->shift = entry->shift;
+    out->readings[0].timestamp_delta = 0;
+    out->readings[0].value = entry->value;
+  }
+
+  *fit = 1;
+  return 1;
+}
+
+static bool sensei_decoder_has_trigger(const uint8_t *buffer, enum sensor_trigger_type trigger) {
+  const sensei_sensor_frame_t *frame = (const sensei_sensor_frame_t *)buffer;
+
+  return trigger < 8 && (frame->triggers & BIT(trigger));
+}
+
+static const struct sensor_decoder_api sensei_sensor_decoder = {
+    .get_frame_count = sensei_decoder_get_frame_count,
+    .get_size_info = sensei_decoder_get_size_info,
+    .decode = sensei_decoder_decode,
+    .has_trigger = sensei_decoder_has_trigger,
+};
+
+int sensei_sensor_get_decoder(const struct device *dev, const struct sensor_decoder_api **decoder) {
+  *decoder = &sensei_sensor_decoder;
+  return 0;
+}
+
+// ----------------- Initialization ------------------------------------------------------------------------------------
+static int sensei_sensor_workq_init(void) {
+  k_work_queue_start(&sensei_sensor_workq, sensei_sensor_stack, K_THREAD_STACK_SIZEOF(sensei_sensor_stack),
+                     CONFIG_SENSEI_SENSORS_WORKQ_PRIORITY, NULL);
+  k_thread_name_set(&sensei_sensor_workq.thread, "sensei_sensor");
+  return 0;
+}
+
+// Before the sensor devices, which are initialized with CONFIG_SENSOR_INIT_PRIORITY
+SYS_INIT(sensei_sensor_workq_init, POST_KERNEL, 0);
+
+/**
+ * @brief Initializes the device, the part itself is only configured on first use, see sensei_sensor_prepare().
+ *
+ */
+int sensei_sensor_init(const struct device *dev) {
+  const struct sensei_sensor_config *config = sensei_config(dev);
+  struct sensei_sensor_data *data = sensei_data(dev);
+
+  __ASSERT_NO_MSG(config->channel_count <= SENSEI_SENSOR_MAX_CHANNELS);
+
+  if (!i2c_is_ready_dt(&config->i2c)) {
+    LOG_ERR("%s Bus %s not ready", dev->name, config->i2c.bus->name);
+    return -ENODEV;
+  }
+
+  data->dev = dev;
+  k_mutex_init(&data->lock);
+  k_work_init_delayable(&data->work, sensei_sensor_work);
+
+  if (config->drdy.port) {
+    if (!gpio_is_ready_dt(&config->drdy) || gpio_pin_configure_dt(&config->drdy, GPIO_INPUT) != 0) {
+      LOG_ERR("%s Data-ready line not ready", dev->name);
+      return -ENODEV;
+    }
+    gpio_init_callback(&data->drdy_cb, sensei_sensor_drdy_isr, BIT(config->drdy.pin));
+    if (gpio_add_callback(config->drdy.port, &data->drdy_cb) != 0) {
+      LOG_ERR("%s Data-ready interrupt not supported", dev->name);
+      return -ENOTSUP;
+    }
+  }
+  return 0;
+}
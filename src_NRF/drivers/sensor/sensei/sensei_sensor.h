@@ -0,0 +1,66 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: sensei_sensor.h
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SENSEI_SENSOR_H
+#define SENSEI_SENSOR_H
+
+#include <zephyr/drivers/sensor.h>
+
+/*
+ * Sensor drivers of the shield parts
+ *
+ * The AS7331, BH1730FVC, ILPS28QSW, ISM330DHCX, LIS2DUXS12, SCD41 and SGP41 are instantiated from the devicetree
+ * (compatibles sensei,<part>, see dts/bindings/sensor) and implement the blocking sensor API as well as the RTIO
+ * submission of sensor_read() and sensor_stream(). A submitted read starts the conversion and returns, the result is
+ * completed from the driver work queue once the data-ready line or status reports it, so the caller only waits on
+ * the completion queue. Streams support SENSOR_TRIG_DATA_READY.
+ *
+ * Values are encoded as q31 with a fixed shift per channel and decoded with sensor_get_decoder(). The channels and
+ * attributes below extend the Zephyr ones for quantities without a standard channel.
+ */
+
+enum sensei_sensor_channel {
+  SENSEI_SENSOR_CHAN_UVA = SENSOR_CHAN_PRIV_START, // AS7331 UVA in counts
+  SENSEI_SENSOR_CHAN_UVB,                          // AS7331 UVB in counts
+  SENSEI_SENSOR_CHAN_UVC,                          // AS7331 UVC in counts
+  SENSEI_SENSOR_CHAN_VISIBLE,                      // BH1730FVC visible channel in counts, SENSOR_CHAN_IR in counts
+  SENSEI_SENSOR_CHAN_SRAW_VOC,                     // SGP41 raw VOC signal in ticks
+  SENSEI_SENSOR_CHAN_SRAW_NOX,                     // SGP41 raw NOx signal in ticks
+};
+
+enum sensei_sensor_attribute {
+  SENSEI_SENSOR_ATTR_INIT = SENSOR_ATTR_PRIV_START, // Reinitializes the part, e.g. after a power cycle
+  SENSEI_SENSOR_ATTR_GAIN,                          // AS7331 gain code 0 - 11, BH1730FVC gain 1, 2, 64 or 128
+  SENSEI_SENSOR_ATTR_INTEGRATION,                   // AS7331 conversion time 2^n ms, BH1730FVC ITIME register
+  SENSEI_SENSOR_ATTR_AVERAGING,                     // ILPS28QSW samples averaged per output, 4 - 512
+  SENSEI_SENSOR_ATTR_COMPENSATION,                  // SGP41 humidity (val1) and temperature (val2) in ticks
+  SENSEI_SENSOR_ATTR_CONVERSION_TIME,               // Read only, conversion time or output interval in us (val1)
+};
+
+#endif /* SENSEI_SENSOR_H */
@@ -0,0 +1,140 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: sensei_sensor_common.h
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SENSEI_SENSOR_COMMON_H
+#define SENSEI_SENSOR_COMMON_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/kernel.h>
+#include <zephyr/rtio/rtio.h>
+
+#include "sensei_sensor.h"
+
+/*
+ * Common part of the shield sensor drivers
+ *
+ * A part driver only implements the split-phase operations of sensei_sensor_ops, the blocking API, the RTIO
+ * submission and the decoder are shared. Every conversion runs on the driver work queue: start, wait for the data-ready
+ * interrupt or poll the status, read and complete the submission. The config and data of a part begin with
+ * sensei_sensor_config and sensei_sensor_data.
+ */
+
+#define SENSEI_SENSOR_MAX_CHANNELS 8
+
+typedef struct {
+  uint16_t chan; // enum sensor_channel or enum sensei_sensor_channel
+  int8_t shift;  // Encoded as q31 with a range of +-2^shift in the unit of the channel
+} sensei_sensor_channel_t;
+
+typedef struct {
+  int (*init)(const struct device *dev); // Resets and configures the powered part
+  int (*start)(const struct device *dev); // Starts a conversion, NULL if the part converts continuously
+  int (*ready)(const struct device *dev, bool *ready);
+  int (*read)(const struct device *dev, float *values); // All channels in the order of the channel table
+  uint32_t (*conversion_us)(const struct device *dev);  // Conversion time, or output interval if continuous
+  int (*attr_set)(const struct device *dev, enum sensor_attribute attr, const struct sensor_value *val);
+} sensei_sensor_ops_t;
+
+struct sensei_sensor_config {
+  struct i2c_dt_spec i2c;
+  struct gpio_dt_spec drdy; // Optional data-ready line, the status is polled without it
+  const sensei_sensor_ops_t *ops;
+  const sensei_sensor_channel_t *channels;
+  uint8_t channel_count;
+};
+
+struct sensei_sensor_data {
+  const struct device *dev;
+  struct k_mutex lock; // Serializes the blocking API, the attributes and the conversion work
+  struct k_work_delayable work;
+  struct gpio_callback drdy_cb;
+  atomic_t drdy;               // Data-ready edge seen since the start of the conversion
+  struct rtio_iodev_sqe *sqe;  // Read or stream waiting for a sample, NULL while idle
+  int64_t start_ms;            // Start of the conversion in flight
+  bool initialized;            // The part is configured, cleared by SENSEI_SENSOR_ATTR_INIT
+  bool converting;
+  float values[SENSEI_SENSOR_MAX_CHANNELS]; // Last sample of the blocking API
+};
+
+/*
+ * Encoded sample, a header followed by one entry per channel
+ */
+typedef struct {
+  uint64_t timestamp_ns;
+  uint8_t count;    // Entries following the header
+  uint8_t triggers; // BIT(SENSOR_TRIG_DATA_READY) if produced by a stream
+  uint8_t reserved[6];
+} sensei_sensor_frame_t;
+
+typedef struct {
+  q31_t value;
+  uint16_t chan;
+  int8_t shift;
+  uint8_t reserved;
+} sensei_sensor_entry_t;
+
+#define SENSEI_SENSOR_CONFIG(inst, part_ops, part_channels)                                                            \
+  {                                                                                                                    \
+    .i2c = I2C_DT_SPEC_INST_GET(inst), .drdy = GPIO_DT_SPEC_INST_GET_OR(inst, drdy_gpios, {0}), .ops = &part_ops,      \
+    .channels = part_channels, .channel_count = ARRAY_SIZE(part_channels),                                             \
+  }
+
+int sensei_sensor_init(const struct device *dev);
+int sensei_sensor_sample_fetch(const struct device *dev, enum sensor_channel chan);
+int sensei_sensor_channel_get(const struct device *dev, enum sensor_channel chan, struct sensor_value *val);
+int sensei_sensor_attr_set(const struct device *dev, enum sensor_channel chan, enum sensor_attribute attr,
+                           const struct sensor_value *val);
+int sensei_sensor_attr_get(const struct device *dev, enum sensor_channel chan, enum sensor_attribute attr,
+                           struct sensor_value *val);
+int sensei_sensor_get_decoder(const struct device *dev, const struct sensor_decoder_api **decoder);
+void sensei_sensor_submit(const struct device *dev, struct rtio_iodev_sqe *iodev_sqe);
+
+// Register access of the vendor libraries, the handle is the struct i2c_dt_spec of the part
+int32_t sensei_sensor_write_reg(void *handle, uint8_t reg, const uint8_t *buf, uint16_t len);
+int32_t sensei_sensor_read_reg(void *handle, uint8_t reg, uint8_t *buf, uint16_t len);
+
+// Command protocol of the Sensirion parts, 16-bit command followed by words protected with CRC-8
+int sensei_sensirion_write(const struct i2c_dt_spec *i2c, uint16_t cmd, const uint16_t *args, size_t count);
+int sensei_sensirion_read(const struct i2c_dt_spec *i2c, uint16_t *words, size_t count);
+
+#define SENSEI_SENSOR_API                                                                                              \
+  {                                                                                                                    \
+    .attr_set = sensei_sensor_attr_set, .attr_get = sensei_sensor_attr_get,                                            \
+    .sample_fetch = sensei_sensor_sample_fetch,                                                                        \
+    .channel_get = sensei_sensor_channel_get, .get_decoder = sensei_sensor_get_decoder,                                \
+    .submit = sensei_sensor_submit,                                                                                    \
+  }
+
+#endif /* SENSEI_SENSOR_COMMON_H */
@@ -0,0 +1,140 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: sgp41.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#define DT_DRV_COMPAT sensei_sgp41
+
+#include <zephyr/logging/log.h>
+
+#include "sensei_sensor_common.h"
+
+LOG_MODULE_DECLARE(sensei_sensor, CONFIG_SENSEI_SENSORS_LOG_LEVEL);
+
+#define SGP41_CMD_EXECUTE_CONDITIONING 0x2612
+#define SGP41_CMD_MEASURE_RAW_SIGNALS 0x2619
+
+#define SGP41_MEASURE_TIME 50 // ms, also of the conditioning command
+
+// Humidity and temperature compensation, 50 %RH and 25 °C
+#define SGP41_DEFAULT_RH 0x8000
+#define SGP41_DEFAULT_T 0x6666
+
+// One-shot conversions of fixed duration, the part has no status register
+struct sgp41_data {
+  struct sensei_sensor_data common;
+  uint16_t compensation[2]; // Humidity and temperature in ticks
+};
+
+static const sensei_sensor_channel_t sgp41_channels[] = {
+    {SENSEI_SENSOR_CHAN_SRAW_VOC, 16},
+    {SENSEI_SENSOR_CHAN_SRAW_NOX, 16},
+};
+
+/**
+ * @brief Starts the heater conditioning, the VOC signal is only valid after about 10 s.
+ *
+ */
+static int sgp41_dev_init(const struct device *dev) {
+  const struct sensei_sensor_config *config = dev->config;
+  struct sgp41_data *data = dev->data;
+  uint16_t sraw_voc;
+
+  int rc = sensei_sensirion_write(&config->i2c, SGP41_CMD_EXECUTE_CONDITIONING, data->compensation, 2);
+  if (rc) {
+    return rc;
+  }
+  k_msleep(SGP41_MEASURE_TIME);
+  return sensei_sensirion_read(&config->i2c, &sraw_voc, 1);
+}
+
+static int sgp41_start(const struct device *dev) {
+  const struct sensei_sensor_config *config = dev->config;
+  struct sgp41_data *data = dev->data;
+
+  return sensei_sensirion_write(&config->i2c, SGP41_CMD_MEASURE_RAW_SIGNALS, data->compensation, 2);
+}
+
+static int sgp41_ready(const struct device *dev, bool *ready) {
+  struct sgp41_data *data = dev->data;
+
+  *ready = (k_uptime_get() - data->common.start_ms) >= SGP41_MEASURE_TIME;
+  return 0;
+}
+
+static int sgp41_read(const struct device *dev, float *values) {
+  const struct sensei_sensor_config *config = dev->config;
+  uint16_t words[2];
+
+  int rc = sensei_sensirion_read(&config->i2c, words, ARRAY_SIZE(words));
+  if (rc) {
+    return rc;
+  }
+
+  values[0] = words[0];
+  values[1] = words[1];
+  return 0;
+}
+
+static uint32_t sgp41_conversion_us(const struct device *dev) { return SGP41_MEASURE_TIME * USEC_PER_MSEC; }
+
+static int sgp41_attr_set(const struct device *dev, enum sensor_attribute attr, const struct sensor_value *val) {
+  struct sgp41_data *data = dev->data;
+
+  switch ((int)attr) {
+  case SENSEI_SENSOR_ATTR_COMPENSATION:
+    if (val->val1 < 0 || val->val1 > UINT16_MAX || val->val2 < 0 || val->val2 > UINT16_MAX) {
+      return -EINVAL;
+    }
+    data->compensation[0] = val->val1;
+    data->compensation[1] = val->val2;
+    return 0;
+  default:
+    return -ENOTSUP;
+  }
+}
+
+static const sensei_sensor_ops_t sgp41_ops = {
+    .init = sgp41_dev_init,
+    .start = sgp41_start,
+    .ready = sgp41_ready,
+    .read = sgp41_read,
+    .conversion_us = sgp41_conversion_us,
+    .attr_set = sgp41_attr_set,
+};
+
+static const struct sensor_driver_api sgp41_api = SENSEI_SENSOR_API;
+
+#define SGP41_DEFINE(inst)                                                                                             \
+  static struct sgp41_data sgp41_data_##inst = {.compensation = {SGP41_DEFAULT_RH, SGP41_DEFAULT_T}};                  \
+  static const struct sensei_sensor_config sgp41_config_##inst =                                                       \
+      SENSEI_SENSOR_CONFIG(inst, sgp41_ops, sgp41_channels);                                                           \
+  SENSOR_DEVICE_DT_INST_DEFINE(inst, sensei_sensor_init, NULL, &sgp41_data_##inst, &sgp41_config_##inst, POST_KERNEL,  \
+                               CONFIG_SENSOR_INIT_PRIORITY, &sgp41_api);
+
+DT_INST_FOREACH_STATUS_OKAY(SGP41_DEFINE)
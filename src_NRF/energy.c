@@ -0,0 +1,301 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: energy.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+
+#include <zephyr/logging/log.h>
+
+#include "config.h"
+#include "energy.h"
+#include "max77654_sensor.h"
+
+#if ENERGY_ENABLED
+
+LOG_MODULE_REGISTER(energy, LOG_LEVEL_INF);
+
+typedef struct {
+  int vsys_mv;
+  int vbat_mv;
+  int charge_pct; // Of ENERGY_FAST_CHARGE_UA
+  int discharge_ma;
+} energy_sample_t;
+
+static struct k_spinlock energy_lock;
+
+// Last sample, held until the next one
+static energy_sample_t energy_last;
+static int64_t energy_last_ticks;
+static int64_t energy_start_ticks;
+
+static energy_count_t energy_total;
+static uint64_t energy_charged_pc; // Battery charge, uA * us
+static uint32_t energy_samples = 0;
+static uint32_t energy_errors = 0;
+
+// Acquisition cycles, only accessed by the record task
+static energy_count_t energy_cycle_start;
+static uint32_t energy_cycles = 0;
+static uint32_t energy_cycle_max_uj = 0;
+
+static energy_window_t *energy_windows[ENERGY_MAX_WINDOWS];
+static size_t energy_window_count = 0;
+
+/**
+ * @brief Extrapolates the counters from the last sample to now.
+ *
+ * Must be called with energy_lock held.
+ */
+static void energy_extrapolate(int64_t now, energy_count_t *count) {
+  uint64_t elapsed_us = k_ticks_to_us_floor64(now - energy_last_ticks);
+  uint32_t current_ma = MAX(energy_last.discharge_ma, 0);
+  uint32_t power_uw = current_ma * MAX(energy_last.vbat_mv, 0);
+
+  count->charge_nc = energy_total.charge_nc + current_ma * elapsed_us;
+  count->energy_pj = energy_total.energy_pj + power_uw * elapsed_us;
+}
+
+static int energy_measure(energy_sample_t *sample) {
+  return measure_max77654(&sample->vsys_mv, &sample->vbat_mv, &sample->charge_pct, &sample->discharge_ma,
+                          ENERGY_DISCHARGE_RANGE);
+}
+
+/**
+ * @brief Takes the first sample, the counters start at zero.
+ *
+ */
+int energy_init(void) {
+  energy_sample_t sample = {0};
+  int error = energy_measure(&sample);
+
+  k_spinlock_key_t key = k_spin_lock(&energy_lock);
+  energy_last = sample;
+  energy_last_ticks = k_uptime_ticks();
+  energy_start_ticks = energy_last_ticks;
+  energy_total = (energy_count_t){0};
+  energy_charged_pc = 0;
+  k_spin_unlock(&energy_lock, key);
+
+  energy_cycle_start = (energy_count_t){0};
+  if (error == NO_ERROR) {
+    LOG_INF("VSYS %d mV, battery %d mV, charging %d %%, discharging %d mA", sample.vsys_mv, sample.vbat_mv,
+            sample.charge_pct, sample.discharge_ma);
+  }
+  return error;
+}
+
+/**
+ * @brief Samples the PMIC, runs as periodic task on the bus of the MAX77654.
+ *
+ * A failed measurement holds the previous sample.
+ */
+void energy_sample(sched_task_t *task) {
+  ARG_UNUSED(task);
+
+  energy_sample_t sample;
+  int error = energy_measure(&sample);
+  int64_t now = k_uptime_ticks();
+
+  k_spinlock_key_t key = k_spin_lock(&energy_lock);
+  uint64_t elapsed_us = k_ticks_to_us_floor64(now - energy_last_ticks);
+  uint32_t charge_ua = MAX(energy_last.charge_pct, 0) * ENERGY_FAST_CHARGE_UA / 100;
+
+  energy_extrapolate(now, &energy_total);
+  energy_charged_pc += charge_ua * elapsed_us;
+  energy_last_ticks = now;
+  if (error == NO_ERROR) {
+    energy_last = sample;
+    energy_samples++;
+  } else {
+    energy_errors++;
+  }
+  k_spin_unlock(&energy_lock, key);
+}
+
+/**
+ * @brief Returns the charge and energy drawn from the battery since energy_init().
+ *
+ */
+void energy_get(energy_count_t *count) {
+  k_spinlock_key_t key = k_spin_lock(&energy_lock);
+  energy_extrapolate(k_uptime_ticks(), count);
+  k_spin_unlock(&energy_lock, key);
+}
+
+/**
+ * @brief Fills the MAX77654 fields of a record with the supply voltages and the charge and energy drawn since the
+ * previous record.
+ *
+ * Must only be called from the record task. The differences are taken of the rounded totals, so the rounding does
+ * not accumulate over the records.
+ */
+void energy_record(sensor_values_t *record) {
+  energy_count_t now;
+
+  k_spinlock_key_t key = k_spin_lock(&energy_lock);
+  energy_extrapolate(k_uptime_ticks(), &now);
+  record->max77654_vsys = CLAMP(energy_last.vsys_mv, 0, UINT16_MAX);
+  record->max77654_vbat = CLAMP(energy_last.vbat_mv, 0, UINT16_MAX);
+  k_spin_unlock(&energy_lock, key);
+
+  record->max77654_charge = now.charge_nc / 1000 - energy_cycle_start.charge_nc / 1000;
+  record->max77654_energy = now.energy_pj / 1000000 - energy_cycle_start.energy_pj / 1000000;
+
+  energy_cycle_start = now;
+  energy_cycles++;
+  energy_cycle_max_uj = MAX(energy_cycle_max_uj, record->max77654_energy);
+}
+
+/**
+ * @brief Initializes a window and adds it to the statistics.
+ *
+ */
+void energy_window_init(energy_window_t *window, const char *name) {
+  *window = (energy_window_t){.name = name};
+
+  __ASSERT(energy_window_count < ENERGY_MAX_WINDOWS, "Increase ENERGY_MAX_WINDOWS");
+  if (energy_window_count < ENERGY_MAX_WINDOWS) {
+    energy_windows[energy_window_count++] = window;
+  }
+}
+
+void energy_window_begin(energy_window_t *window) {
+  energy_get(&window->start);
+  window->start_ticks = k_uptime_ticks();
+  window->open = true;
+}
+
+/**
+ * @brief Closes a window and adds the charge and energy drawn since energy_window_begin() to its statistics.
+ *
+ */
+void energy_window_end(energy_window_t *window) {
+  energy_count_t now;
+
+  if (!window->open) {
+    return;
+  }
+
+  k_spinlock_key_t key = k_spin_lock(&energy_lock);
+  int64_t ticks = k_uptime_ticks();
+
+  energy_extrapolate(ticks, &now);
+  window->total.charge_nc += now.charge_nc - window->start.charge_nc;
+  window->total.energy_pj += now.energy_pj - window->start.energy_pj;
+  window->duration_us += k_ticks_to_us_floor64(ticks - window->start_ticks);
+  window->count++;
+  window->open = false;
+  k_spin_unlock(&energy_lock, key);
+}
+
+/**
+ * @brief Returns the counters and the last sample consistently for the statistics.
+ *
+ */
+static void energy_snapshot(energy_count_t *total, energy_sample_t *last, uint64_t *charged_pc, uint64_t *elapsed_us) {
+  k_spinlock_key_t key = k_spin_lock(&energy_lock);
+  int64_t now = k_uptime_ticks();
+
+  energy_extrapolate(now, total);
+  *last = energy_last;
+  *charged_pc = energy_charged_pc;
+  *elapsed_us = k_ticks_to_us_floor64(now - energy_start_ticks);
+  k_spin_unlock(&energy_lock, key);
+}
+
+// Average energy of the records emitted so far in uJ
+static uint64_t energy_cycle_avg_uj(void) {
+  return energy_cycles ? energy_cycle_start.energy_pj / 1000000 / energy_cycles : 0;
+}
+
+/**
+ * @brief Logs the supply, the average power and the energy per cycle and per window.
+ *
+ */
+void energy_log(void) {
+  energy_sample_t last;
+  energy_count_t total;
+  uint64_t charged_pc;
+  uint64_t elapsed_us;
+
+  energy_snapshot(&total, &last, &charged_pc, &elapsed_us);
+
+  LOG_INF("energy: VSYS %d mV, battery %d mV, charging %d %%, discharging %d mA (%u samples, %u errors)",
+          last.vsys_mv, last.vbat_mv, last.charge_pct, last.discharge_ma, energy_samples, energy_errors);
+  LOG_INF("energy: %llu mC and %llu mJ drawn, %llu mC charged, average %llu uW, %llu uJ per cycle (max %u)",
+          total.charge_nc / 1000000, total.energy_pj / 1000000000, charged_pc / 1000000000,
+          elapsed_us ? total.energy_pj / elapsed_us : 0, energy_cycle_avg_uj(), energy_cycle_max_uj);
+
+  for (size_t i = 0; i < energy_window_count; i++) {
+    const energy_window_t *window = energy_windows[i];
+
+    if (window->count == 0) {
+      continue;
+    }
+    LOG_INF(" - %-10s %6u windows of %6llu us : %6llu uC %6llu uJ per window", window->name, window->count,
+            window->duration_us / window->count, window->total.charge_nc / 1000 / window->count,
+            window->total.energy_pj / 1000000 / window->count);
+  }
+}
+
+#if defined(CONFIG_SHELL)
+static int cmd_energy(const struct shell *sh, size_t argc, char **argv) {
+  ARG_UNUSED(argc);
+  ARG_UNUSED(argv);
+
+  energy_sample_t last;
+  energy_count_t total;
+  uint64_t charged_pc;
+  uint64_t elapsed_us;
+
+  energy_snapshot(&total, &last, &charged_pc, &elapsed_us);
+
+  shell_print(sh, "VSYS %d mV, battery %d mV, charging %d %%, discharging %d mA", last.vsys_mv, last.vbat_mv,
+              last.charge_pct, last.discharge_ma);
+  shell_print(sh, "Drawn %llu uC, %llu uJ, charged %llu uC, average %llu uW", total.charge_nc / 1000,
+              total.energy_pj / 1000000, charged_pc / 1000000, elapsed_us ? total.energy_pj / elapsed_us : 0);
+  shell_print(sh, "Per cycle %llu uJ (max %u uJ) over %u cycles", energy_cycle_avg_uj(), energy_cycle_max_uj,
+              energy_cycles);
+
+  shell_print(sh, "%-10s %8s %10s %10s %10s", "Window", "Count", "Avg [us]", "Avg [uC]", "Avg [uJ]");
+  for (size_t i = 0; i < energy_window_count; i++) {
+    const energy_window_t *window = energy_windows[i];
+    uint32_t count = MAX(window->count, 1);
+
+    shell_print(sh, "%-10s %8u %10llu %10llu %10llu", window->name, window->count, window->duration_us / count,
+                window->total.charge_nc / 1000 / count, window->total.energy_pj / 1000000 / count);
+  }
+  return 0;
+}
+
+SHELL_CMD_REGISTER(energy, NULL, "Print the battery charge and energy per cycle and per sensor conversion", cmd_energy);
+#endif
+
+#endif
@@ -0,0 +1,93 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: energy.h
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef ENERGY_H
+#define ENERGY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "config.h"
+#include "record.h"
+#include "sched.h"
+
+/*
+ * Energy meter
+ *
+ * The MAX77654 measures the VSYS and battery voltage and the battery charge and discharge currents. The meter samples
+ * them every ENERGY_SAMPLE_PERIOD ms and integrates the discharge current and power, holding each sample until the
+ * next one. Between two samples the counters are extrapolated with the last sample, so windows shorter than the
+ * sample period still get an estimate.
+ *
+ * Every record carries the charge and energy drawn from the battery since the previous record. A window accumulates
+ * the charge drawn while it is open, e.g. during the conversion of a sensor. The PMIC only sees the whole system, a
+ * window includes everything else running at the same time.
+ */
+
+typedef struct {
+  uint64_t charge_nc; // Battery discharge, mA * us
+  uint64_t energy_pj; // Battery discharge power, uW * us
+} energy_count_t;
+
+typedef struct {
+  const char *name;
+  bool open;
+  energy_count_t start;
+  int64_t start_ticks;
+
+  uint32_t count;
+  uint64_t duration_us;
+  energy_count_t total;
+} energy_window_t;
+
+#if ENERGY_ENABLED
+
+int energy_init(void);
+void energy_sample(sched_task_t *task);
+void energy_get(energy_count_t *count);
+void energy_record(sensor_values_t *record);
+void energy_window_init(energy_window_t *window, const char *name);
+void energy_window_begin(energy_window_t *window);
+void energy_window_end(energy_window_t *window);
+void energy_log(void);
+
+#else
+
+static inline int energy_init(void) { return 0; }
+static inline void energy_sample(sched_task_t *task) {}
+static inline void energy_get(energy_count_t *count) { *count = (energy_count_t){0}; }
+static inline void energy_record(sensor_values_t *record) {}
+static inline void energy_window_init(energy_window_t *window, const char *name) {}
+static inline void energy_window_begin(energy_window_t *window) {}
+static inline void energy_window_end(energy_window_t *window) {}
+static inline void energy_log(void) {}
+
+#endif /* ENERGY_ENABLED */
+
+#endif /* ENERGY_H */
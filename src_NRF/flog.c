@@ -0,0 +1,289 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: flog.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <errno.h>
+
+#include <zephyr/fs/fcb.h>
+#include <zephyr/kernel.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/byteorder.h>
+
+#include <zephyr/logging/log.h>
+
+#include "config.h"
+#include "flog.h"
+#include "trace.h"
+#include "tscodec.h"
+
+LOG_MODULE_REGISTER(flog, LOG_LEVEL_INF);
+
+#define FLOG_PARTITION_ID FIXED_PARTITION_ID(sample_log)
+#define FLOG_MAGIC 0x474f4c53 // "SLOG"
+#define FLOG_VERSION 3        // Entries are tscodec blocks with the MAX77654 channels
+#define FLOG_HEADER_RESERVE 32 // Upper bound of the FCB sector and entry headers including alignment
+
+static struct flash_sector flog_sectors[FLOG_MAX_SECTORS];
+static struct fcb flog_fcb;
+static bool flog_ready = false;
+
+static uint8_t flog_block[FLOG_BLOCK_SIZE];
+static tscodec_t flog_enc;
+
+static flog_stats_t flog_stat;
+
+// Last entry emitted by an interrupted drain, the next drain resumes behind it. Unset while fe_sector is NULL
+static struct fcb_entry flog_cursor;
+
+static int flog_count_records(struct fcb_entry_ctx *loc_ctx, void *arg) {
+  uint32_t *records = arg;
+  uint8_t header[TSCODEC_HEADER_SIZE];
+
+  if (flash_area_read(loc_ctx->fap, FCB_ENTRY_FA_DATA_OFF(loc_ctx->loc), header, sizeof(header)) == 0) {
+    *records += sys_get_le16(header);
+  }
+  return 0;
+}
+
+/**
+ * @brief Erases the oldest sector to make room for new entries.
+ *
+ */
+static int flog_rotate(bool drained) {
+  if (!drained) {
+    uint32_t records = 0;
+
+    fcb_walk(&flog_fcb, flog_fcb.f_oldest, flog_count_records, &records);
+    flog_stat.overwritten += records;
+  }
+  if (flog_cursor.fe_sector == flog_fcb.f_oldest) {
+    flog_cursor = (struct fcb_entry){0};
+  }
+  return fcb_rotate(&flog_fcb);
+}
+
+/**
+ * @brief Opens the sample_log partition and recovers the log written before the last reset.
+ *
+ */
+int flog_init(void) {
+  uint32_t sector_cnt = ARRAY_SIZE(flog_sectors);
+  int rc;
+
+  rc = flash_area_get_sectors(FLOG_PARTITION_ID, &sector_cnt, flog_sectors);
+  if (rc) {
+    LOG_ERR("Failed to get sectors of sample_log partition (%d)", rc);
+    return rc;
+  }
+
+  flog_fcb.f_magic = FLOG_MAGIC;
+  flog_fcb.f_version = FLOG_VERSION;
+  flog_fcb.f_sector_cnt = sector_cnt;
+  flog_fcb.f_scratch_cnt = 0;
+  flog_fcb.f_sectors = flog_sectors;
+
+  rc = fcb_init(FLOG_PARTITION_ID, &flog_fcb);
+  if (rc) {
+    // Log written by an incompatible firmware, start over
+    const struct flash_area *fa;
+
+    LOG_WRN("Erasing incompatible sample log (%d)", rc);
+    rc = flash_area_open(FLOG_PARTITION_ID, &fa);
+    if (rc == 0) {
+      rc = flash_area_erase(fa, 0, fa->fa_size);
+      flash_area_close(fa);
+    }
+    if (rc == 0) {
+      rc = fcb_init(FLOG_PARTITION_ID, &flog_fcb);
+    }
+    if (rc) {
+      LOG_ERR("Failed to initialize sample log (%d)", rc);
+      return rc;
+    }
+  }
+
+  // A block plus the sector and entry headers must fit into one sector
+  if (FLOG_BLOCK_SIZE + FLOG_HEADER_RESERVE > flog_sectors[0].fs_size) {
+    LOG_ERR("Block of %u bytes does not fit into a %u byte sector", FLOG_BLOCK_SIZE, flog_sectors[0].fs_size);
+    return -EINVAL;
+  }
+
+  tscodec_init(&flog_enc, flog_block, sizeof(flog_block));
+
+  flog_ready = true;
+  LOG_INF("Sample log with %u sectors of %u bytes, %s", sector_cnt, flog_sectors[0].fs_size,
+          fcb_is_empty(&flog_fcb) ? "empty" : "backlog pending");
+  return 0;
+}
+
+/**
+ * @brief Writes the buffered block to flash as one entry.
+ *
+ */
+int flog_flush(void) {
+  struct fcb_entry loc;
+  uint16_t count = flog_enc.count;
+  size_t len;
+  int rc;
+
+  if (count == 0) {
+    return 0;
+  }
+
+  TRACE_BEGIN(FLOG, count);
+
+  // Flash writes must be aligned to the write block size, the decoder ignores the padding
+  len = tscodec_finish(&flog_enc);
+  len = MIN(ROUND_UP(len, flash_area_align(flog_fcb.fap)), sizeof(flog_block));
+  tscodec_init(&flog_enc, flog_block, sizeof(flog_block));
+
+  rc = fcb_append(&flog_fcb, len, &loc);
+  if (rc == -ENOSPC) {
+    // The log is full, overwrite the oldest sector
+    rc = flog_rotate(false);
+    if (rc == 0) {
+      rc = fcb_append(&flog_fcb, len, &loc);
+    }
+  }
+  if (rc == 0) {
+    rc = flash_area_write(flog_fcb.fap, FCB_ENTRY_FA_DATA_OFF(loc), flog_block, len);
+  }
+  if (rc == 0) {
+    rc = fcb_append_finish(&flog_fcb, &loc);
+  }
+
+  if (rc) {
+    LOG_ERR("Failed to write %u records to sample log (%d)", count, rc);
+    flog_stat.errors++;
+  } else {
+    flog_stat.appended += count;
+  }
+  TRACE_END(FLOG, count);
+  return rc;
+}
+
+/**
+ * @brief Compresses a record into the current block, a full block is written to flash.
+ *
+ */
+int flog_append(const sensor_values_t *record) {
+  int rc = 0;
+
+  if (!flog_ready) {
+    flog_stat.errors++;
+    return -ENODEV;
+  }
+
+  if (tscodec_encode(&flog_enc, record) == -ENOSPC) {
+    rc = flog_flush();
+    tscodec_encode(&flog_enc, record);
+  }
+  return rc;
+}
+
+static uint32_t flog_emit_block(const uint8_t *buf, size_t len, flog_emit_t emit) {
+  sensor_values_t record;
+  tscodec_t dec;
+  uint32_t records = 0;
+
+  if (tscodec_decode_init(&dec, buf, len)) {
+    flog_stat.errors++;
+    return 0;
+  }
+  while (tscodec_decode(&dec, &record) == 0) {
+    emit(&record);
+    records++;
+  }
+  if (dec.count != dec.total) {
+    flog_stat.errors++;
+  }
+  return records;
+}
+
+/**
+ * @brief Streams the backlog oldest first and erases it.
+ *
+ * Sectors are erased as soon as all their entries are emitted, without any acknowledgement from the host, so records
+ * the host loses after they were emitted are gone. If cont returns false the drain stops, the current sector is kept
+ * and the next drain resumes behind the last emitted entry. The position is kept in RAM only, after a reset the kept
+ * sector is streamed again from its start.
+ *
+ * @param emit Called for every record
+ * @param cont Checked before every entry, e.g. whether the host is still connected
+ * @return Number of records emitted
+ */
+uint32_t flog_drain(flog_emit_t emit, flog_continue_t cont) {
+  static uint8_t buf[FLOG_BLOCK_SIZE];
+  struct fcb_entry loc = flog_cursor;
+  struct flash_sector *sector = loc.fe_sector;
+  uint32_t records = 0;
+  bool complete = true;
+
+  if (flog_ready) {
+    while (true) {
+      if (!cont()) {
+        complete = false;
+        break;
+      }
+      if (fcb_getnext(&flog_fcb, &loc)) {
+        break;
+      }
+      if (sector && loc.fe_sector != sector) {
+        // All entries of the oldest sector were emitted
+        flog_rotate(true);
+      }
+      sector = loc.fe_sector;
+      flog_cursor = loc;
+
+      if (loc.fe_data_len > sizeof(buf) ||
+          flash_area_read(flog_fcb.fap, FCB_ENTRY_FA_DATA_OFF(loc), buf, loc.fe_data_len)) {
+        flog_stat.errors++;
+        continue;
+      }
+      records += flog_emit_block(buf, loc.fe_data_len, emit);
+    }
+    if (complete && sector) {
+      flog_rotate(true);
+    }
+  }
+
+  // Records not yet written to flash are emitted directly
+  if (complete && flog_enc.count) {
+    size_t len = tscodec_finish(&flog_enc);
+
+    records += flog_emit_block(flog_block, len, emit);
+    tscodec_init(&flog_enc, flog_block, sizeof(flog_block));
+  }
+
+  flog_stat.drained += records;
+  return records;
+}
+
+bool flog_empty(void) { return !flog_ready || (flog_enc.count == 0 && fcb_is_empty(&flog_fcb)); }
+
+const flog_stats_t *flog_stats(void) { return &flog_stat; }
@@ -0,0 +1,63 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: flog.h
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef FLOG_H
+#define FLOG_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "record.h"
+
+/*
+ * Flash ring log of records
+ *
+ * Records are compressed into a tscodec block in RAM, which is appended to the sample_log partition as one flash
+ * circular buffer (FCB) entry once it reaches FLOG_BLOCK_SIZE, so every block costs a single page-sized write. The FCB fills the sectors in
+ * order and erases the oldest sector once the partition is full, which spreads the erases evenly over the partition.
+ */
+
+typedef void (*flog_emit_t)(const sensor_values_t *record);
+typedef bool (*flog_continue_t)(void);
+
+typedef struct {
+  uint32_t appended;    // Records written to flash
+  uint32_t drained;     // Records streamed to the host
+  uint32_t overwritten; // Records lost because the partition was full
+  uint32_t errors;      // Failed flash operations
+} flog_stats_t;
+
+int flog_init(void);
+int flog_append(const sensor_values_t *record);
+int flog_flush(void);
+uint32_t flog_drain(flog_emit_t emit, flog_continue_t cont);
+bool flog_empty(void);
+const flog_stats_t *flog_stats(void);
+
+#endif /* FLOG_H */
@@ -0,0 +1,247 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: fmt.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <zephyr/sys/util.h>
+
+#include "fmt.h"
+
+/*
+ * Integer and fixed-point CSV formatter
+ *
+ * Floats are scaled to an integer with a fixed number of decimals and printed with integer arithmetic only, so the
+ * record output does not depend on the floating-point support of printf. The columns follow the channel schema in
+ * record.c, the decimals of every column match the resolution of its sensor, the units are unchanged.
+ */
+
+// Above this magnitude the integer part does not fit into an uint32_t
+#define FMT_FIXED_MAX 4e9f
+
+#define FMT_MAX_DECIMALS 6
+
+static const uint32_t fmt_pow10[FMT_MAX_DECIMALS + 1] = {1, 10, 100, 1000, 10000, 100000, 1000000};
+
+static char *fmt_str(char *p, const char *str) {
+  while (*str) {
+    *p++ = *str++;
+  }
+  return p;
+}
+
+/**
+ * @brief Prints an unsigned integer in decimal, without terminating null.
+ *
+ * @return Pointer behind the last character
+ */
+char *fmt_u32(char *p, uint32_t value) {
+  char tmp[10];
+  uint8_t n = 0;
+
+  do {
+    tmp[n++] = '0' + (value % 10);
+    value /= 10;
+  } while (value);
+
+  while (n) {
+    *p++ = tmp[--n];
+  }
+  return p;
+}
+
+/**
+ * @brief Prints a float rounded to a fixed number of decimals, without terminating null.
+ *
+ * @param p Output position
+ * @param value Value to print
+ * @param decimals Digits after the decimal point, at most 6
+ * @return Pointer behind the last character
+ */
+char *fmt_fixed(char *p, float value, uint8_t decimals) {
+  if (isnan(value)) {
+    return fmt_str(p, "nan");
+  }
+  if (!(fabsf(value) < FMT_FIXED_MAX)) {
+    return fmt_str(p, value < 0 ? "-inf" : "inf");
+  }
+
+  decimals = MIN(decimals, FMT_MAX_DECIMALS);
+  uint32_t scale = fmt_pow10[decimals];
+  bool negative = value < 0;
+  float magnitude = negative ? -value : value;
+
+  // Integer and fraction are scaled separately, value * scale would exceed the 24 bit mantissa of a float
+  uint32_t integer = (uint32_t)magnitude;
+  uint32_t frac = (uint32_t)((magnitude - integer) * scale + 0.5f);
+  if (frac >= scale) {
+    integer++;
+    frac -= scale;
+  }
+
+  if (negative && (integer || frac)) {
+    *p++ = '-';
+  }
+  p = fmt_u32(p, integer);
+  if (decimals) {
+    *p++ = '.';
+    // Leading zeros of the fraction
+    for (uint32_t digit = scale / 10; digit > 1 && frac < digit; digit /= 10) {
+      *p++ = '0';
+    }
+    p = fmt_u32(p, frac);
+  }
+  return p;
+}
+
+/**
+ * @brief Prints a float like fmt_fixed() as null terminated string, e.g. for log messages.
+ *
+ * @param buf Output buffer of at least FMT_FIXED_MAX_LEN + 1 bytes
+ * @param value Value to print
+ * @param decimals Digits after the decimal point, at most 6
+ * @return buf
+ */
+char *fmt_fixed_str(char *buf, float value, uint8_t decimals) {
+  *fmt_fixed(buf, value, decimals) = '\0';
+  return buf;
+}
+
+/**
+ * @brief Formats the CSV header with the columns of the record.
+ *
+ * @param buf Output buffer of at least FMT_CSV_HEADER_SIZE bytes
+ * @return Length of the line without the terminating null
+ */
+size_t fmt_header_csv(char *buf) {
+  char *p = buf;
+
+  for (size_t i = 0; i < RECORD_CHANNEL_COUNT; i++) {
+    size_t len = strlen(record_channels[i].name);
+
+    memcpy(p, record_channels[i].name, len);
+    p += len;
+    *p++ = i + 1 < RECORD_CHANNEL_COUNT ? ',' : '\n';
+  }
+  *p = '\0';
+
+  return p - buf;
+}
+
+/**
+ * @brief Formats a record as CSV line with the same columns as the header.
+ *
+ * Missing values of a failed sensor are printed as empty field.
+ *
+ * @param buf Output buffer of at least FMT_CSV_MAX_LINE bytes
+ * @param record Record to format
+ * @return Length of the line without the terminating null
+ */
+size_t fmt_record_csv(char *buf, const sensor_values_t *record) {
+  char *p = buf;
+
+  for (size_t i = 0; i < RECORD_CHANNEL_COUNT; i++) {
+    const record_channel_t *ch = &record_channels[i];
+    const uint8_t *field = (const uint8_t *)record + ch->offset;
+    uint16_t u16;
+    uint32_t u32;
+    float f32;
+
+    if (i) {
+      *p++ = ',';
+    }
+    switch (ch->type) {
+    case RECORD_U16:
+      memcpy(&u16, field, sizeof(u16));
+      if (u16 != RECORD_MISSING_U16) {
+        p = fmt_u32(p, u16);
+      }
+      break;
+    case RECORD_U32:
+      memcpy(&u32, field, sizeof(u32));
+      if (i == 0 || u32 != RECORD_MISSING_U32) {
+        p = fmt_u32(p, u32);
+      }
+      break;
+    case RECORD_F32:
+      memcpy(&f32, field, sizeof(f32));
+      if (!isnan(f32)) {
+        p = fmt_fixed(p, f32, ch->decimals);
+      }
+      break;
+    }
+  }
+  *p++ = '\n';
+  *p = '\0';
+
+  return p - buf;
+}
+
+/**
+ * @brief Formats a record with printf, requires CONFIG_SENSOR_HUB_FLOAT_PRINTF.
+ *
+ * Reference for fmt_record_csv(), missing values are printed as their raw marker.
+ *
+ * @param buf Output buffer
+ * @param size Size of the buffer
+ * @param record Record to format
+ * @return Length of the line without the terminating null, at most size - 1
+ */
+size_t fmt_record_printf(char *buf, size_t size, const sensor_values_t *record) {
+  size_t len = 0;
+
+  for (size_t i = 0; i < RECORD_CHANNEL_COUNT && len < size; i++) {
+    const record_channel_t *ch = &record_channels[i];
+    const uint8_t *field = (const uint8_t *)record + ch->offset;
+    char sep = i + 1 < RECORD_CHANNEL_COUNT ? ',' : '\n';
+    uint16_t u16;
+    uint32_t u32;
+    float f32;
+    int n = 0;
+
+    switch (ch->type) {
+    case RECORD_U16:
+      memcpy(&u16, field, sizeof(u16));
+      n = snprintf(buf + len, size - len, "%u%c", u16, sep);
+      break;
+    case RECORD_U32:
+      memcpy(&u32, field, sizeof(u32));
+      n = snprintf(buf + len, size - len, "%u%c", u32, sep);
+      break;
+    case RECORD_F32:
+      memcpy(&f32, field, sizeof(f32));
+      n = snprintf(buf + len, size - len, "%f%c", (double)f32, sep);
+      break;
+    }
+    len += MAX(n, 0);
+  }
+  return MIN(len, size - 1);
+}
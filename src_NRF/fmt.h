@@ -0,0 +1,56 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: fmt.h
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef FMT_H
+#define FMT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "record.h"
+
+// Longest CSV line of fmt_record_csv() including the newline and terminating null
+#define FMT_CSV_MAX_LINE 320
+
+// Longest output of fmt_fixed(), sign, 10 digits, decimal point and 6 decimals
+#define FMT_FIXED_MAX_LEN 18
+
+// CSV header of fmt_header_csv(), every column followed by a separator or the newline, and the terminating null
+#define FMT_CSV_COLUMN_SIZE(field, type, column, unit, decimals) +sizeof(column)
+#define FMT_CSV_HEADER_SIZE (1 RECORD_CHANNELS(FMT_CSV_COLUMN_SIZE))
+
+char *fmt_u32(char *p, uint32_t value);
+char *fmt_fixed(char *p, float value, uint8_t decimals);
+char *fmt_fixed_str(char *buf, float value, uint8_t decimals);
+
+size_t fmt_header_csv(char *buf);
+size_t fmt_record_csv(char *buf, const sensor_values_t *record);
+size_t fmt_record_printf(char *buf, size_t size, const sensor_values_t *record);
+
+#endif /* FMT_H */
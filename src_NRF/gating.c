@@ -0,0 +1,54 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: gating.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "gating.h"
+
+#if GATING_ENABLED
+
+/**
+ * @brief Decides whether a sensor is switched off between two samples.
+ *
+ * @param model Warm-up model of the sensor
+ * @param period_ms Sampling period
+ * @param conversion_ms Conversion time of the applied configuration
+ * @return Whether gating needs less charge than staying powered
+ */
+bool gating_decide(const gating_model_t *model, uint32_t period_ms, uint32_t conversion_ms) {
+  uint32_t warmup_ms = SENSOR_SETTLE_TIME + model->warmup_ms;
+  uint32_t on_ms = warmup_ms + (model->conversion_ms ? model->conversion_ms : conversion_ms);
+
+  if (period_ms < on_ms + GATING_MIN_OFF_TIME) {
+    return false;
+  }
+
+  // Charge in uA ms of staying powered while the gated sensor would be off against the charge of one warm-up
+  return (uint64_t)model->idle_ua * (period_ms - on_ms) > (uint64_t)model->warmup_ua * warmup_ms;
+}
+
+#endif
@@ -0,0 +1,66 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: gating.h
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GATING_H
+#define GATING_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "config.h"
+
+/*
+ * Power gating of the shield sensors
+ *
+ * For long sampling periods a sensor is switched off after every sample and powered on again ahead of the next one.
+ * Whether that saves energy depends on the warm-up after power-on: the SCD41 has to discard its first single shot and
+ * the SGP41 has to condition its hotplate, both at the full supply current. The model of a sensor compares the charge
+ * of one warm-up with the charge of staying powered until the next sample. A sensor is gated if the warm-up is cheaper
+ * and it stays off for at least GATING_MIN_OFF_TIME, otherwise it is always on.
+ *
+ * The decision is taken after every sample, so it follows the period of the runtime configuration and of adaptive
+ * sampling. Powering on is split into switching the supply and the bus, which takes no time, and bringing the sensor
+ * up after SENSOR_SETTLE_TIME, so several sensors share a single settle delay, see sensor_power_up().
+ */
+
+typedef struct {
+  uint32_t warmup_ms;     // After configure() until a valid conversion can be triggered
+  uint32_t warmup_ua;     // Mean supply current while settling and warming up
+  uint32_t idle_ua;       // Mean supply current of an always-on sensor between two samples
+  uint32_t conversion_ms; // Conversion time when gated, 0 for the conversion time of the configuration
+} gating_model_t;
+
+#if GATING_ENABLED
+bool gating_decide(const gating_model_t *model, uint32_t period_ms, uint32_t conversion_ms);
+#else
+static inline bool gating_decide(const gating_model_t *model, uint32_t period_ms, uint32_t conversion_ms) {
+  return false;
+}
+#endif
+
+#endif /* GATING_H */
@@ -0,0 +1,156 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: health.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+
+#include <zephyr/logging/log.h>
+
+#include "config.h"
+#include "health.h"
+
+LOG_MODULE_REGISTER(health, LOG_LEVEL_INF);
+
+static const char *const health_names[] = {"ok", "retry", "recovering", "failed"};
+
+static health_t *health_sensors[HEALTH_MAX_SENSORS];
+static size_t health_count = 0;
+
+/**
+ * @brief Initializes the health of a sensor and adds it to the `health` shell command.
+ *
+ */
+void health_init(health_t *health, const char *name, bool recoverable) {
+  *health = (health_t){.name = name, .recoverable = recoverable, .state = HEALTH_OK};
+
+  __ASSERT(health_count < HEALTH_MAX_SENSORS, "Increase HEALTH_MAX_SENSORS");
+  if (health_count < HEALTH_MAX_SENSORS) {
+    health_sensors[health_count++] = health;
+  }
+}
+
+/**
+ * @brief Checks whether the backoff after a failure has passed.
+ *
+ */
+bool health_ready(const health_t *health, uint32_t now_ms) {
+  return health->state == HEALTH_OK || (int32_t)(now_ms - health->resume_ms) >= 0;
+}
+
+/**
+ * @brief Counts a failed conversion and schedules the next attempt.
+ *
+ * @param health Health of the sensor
+ * @param now_ms Uptime of the failure
+ * @param timeout The sensor did not report data ready in time, else it returned an error
+ * @return true if the sensor should be power cycled before the next attempt
+ */
+bool health_fault(health_t *health, uint32_t now_ms, bool timeout) {
+  health_state_t state;
+  bool recover;
+
+  if (timeout) {
+    health->timeouts++;
+  } else {
+    health->errors++;
+  }
+  health->failures++;
+
+  recover = health->recoverable && (health->failures % HEALTH_RECOVER_AFTER) == 0;
+  if (recover) {
+    health->recoveries++;
+  }
+
+  if (health->failures >= HEALTH_RECOVER_AFTER * HEALTH_RECOVER_ATTEMPTS) {
+    state = HEALTH_FAILED;
+  } else if (recover || health->state == HEALTH_RECOVERING) {
+    state = HEALTH_RECOVERING;
+  } else {
+    state = HEALTH_RETRY;
+  }
+
+  uint32_t backoff_ms = HEALTH_RETRY_TIME << MIN(health->failures - 1, 16);
+
+  health->resume_ms = now_ms + MIN(backoff_ms, HEALTH_RETRY_MAX);
+  if (state != health->state) {
+    LOG_WRN("%s %s after %u failures, next attempt in %u ms", health->name, health_names[state], health->failures,
+            health->resume_ms - now_ms);
+  }
+  health->state = state;
+
+  return recover;
+}
+
+/**
+ * @brief Counts a good sample, a failed sensor is back to normal.
+ *
+ */
+void health_ok(health_t *health) {
+  if (health->state != HEALTH_OK) {
+    LOG_INF("%s ok after %u failures", health->name, health->failures);
+  }
+  health->state = HEALTH_OK;
+  health->failures = 0;
+}
+
+/**
+ * @brief Checks whether every sensor has failed, e.g. because the bus or the supply of the sensors failed.
+ *
+ */
+bool health_all_failed(void) {
+  for (size_t i = 0; i < health_count; i++) {
+    if (health_sensors[i]->state != HEALTH_FAILED) {
+      return false;
+    }
+  }
+  return health_count > 0;
+}
+
+#if defined(CONFIG_SHELL)
+static int cmd_health(const struct shell *sh, size_t argc, char **argv) {
+  ARG_UNUSED(argc);
+  ARG_UNUSED(argv);
+
+  uint32_t now_ms = k_uptime_get_32();
+
+  shell_print(sh, "%-10s %-10s %8s %8s %8s %10s %10s", "Sensor", "State", "Failures", "Errors", "Timeouts",
+              "Recoveries", "Resume");
+  for (size_t i = 0; i < health_count; i++) {
+    const health_t *health = health_sensors[i];
+    uint32_t resume_ms = health_ready(health, now_ms) ? 0 : health->resume_ms - now_ms;
+
+    shell_print(sh, "%-10s %-10s %8u %8u %8u %10u %8u ms", health->name, health_names[health->state],
+                health->failures, health->errors, health->timeouts, health->recoveries, resume_ms);
+  }
+  return 0;
+}
+
+SHELL_CMD_REGISTER(health, NULL, "Print the state and the failure counts of the sensors", cmd_health);
+#endif
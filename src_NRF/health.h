@@ -0,0 +1,72 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: health.h
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef HEALTH_H
+#define HEALTH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Sensor health
+ *
+ * A failed conversion (I2C error or no data ready within the timeout of the sensor) only affects the sensor itself:
+ * its fields are marked missing in the record and it is retried with an exponential backoff starting at
+ * HEALTH_RETRY_TIME. After every HEALTH_RECOVER_AFTER consecutive failures a recoverable sensor is power cycled.
+ * After HEALTH_RECOVER_ATTEMPTS of these rounds the sensor is considered failed and only retried every
+ * HEALTH_RETRY_MAX ms.
+ */
+
+typedef enum {
+  HEALTH_OK,
+  HEALTH_RETRY,      // Failed, retried after the backoff
+  HEALTH_RECOVERING, // Power cycled, waiting for the first good sample
+  HEALTH_FAILED,     // Recovery did not help, retried rarely
+} health_state_t;
+
+typedef struct {
+  const char *name;
+  bool recoverable; // The sensor can be power cycled
+  health_state_t state;
+  uint32_t failures;  // Consecutive failures
+  uint32_t resume_ms; // No attempt before this uptime while not HEALTH_OK
+
+  // Statistics since boot
+  uint32_t errors;
+  uint32_t timeouts;
+  uint32_t recoveries;
+} health_t;
+
+void health_init(health_t *health, const char *name, bool recoverable);
+bool health_ready(const health_t *health, uint32_t now_ms);
+bool health_fault(health_t *health, uint32_t now_ms, bool timeout);
+void health_ok(health_t *health);
+bool health_all_failed(void);
+
+#endif /* HEALTH_H */
@@ -34,6 +34,7 @@
 #include <zephyr/logging/log.h>
 #include <zephyr/logging/log_ctrl.h>
 
+#include "devpm.h"
 #include "i2c_helpers.h"
 
 LOG_MODULE_REGISTER(sensors, LOG_LEVEL_INF);
@@ -41,27 +42,53 @@ LOG_MODULE_REGISTER(sensors, LOG_LEVEL_INF);
 // static const struct device *const i2c_a = DEVICE_DT_GET(DT_ALIAS(i2ca));
 static const struct device *const i2c_b = DEVICE_DT_GET(DT_ALIAS(i2cb));
 
+// The controller is resumed for every transfer and suspended again when no other transfer holds it, see devpm.h
 int32_t i2c_write_reg(void *handle, uint8_t reg, const uint8_t *bufp, uint16_t len) {
   i2c_ctx_t *ctx = (i2c_ctx_t *)handle;
   LOG_DBG("[0x%02X] Address 0x%02X:", ctx->i2c_addr, reg);
   LOG_HEXDUMP_DBG(bufp, len, "I2C TX");
-  return i2c_burst_write(ctx->i2c_handle, ctx->i2c_addr, reg, bufp, len);
+
+  int error = devpm_get(ctx->i2c_handle);
+  if (error < 0) {
+    return error;
+  }
+  error = i2c_burst_write(ctx->i2c_handle, ctx->i2c_addr, reg, bufp, len);
+  devpm_put(ctx->i2c_handle);
+  return error;
 }
 
 int32_t i2c_read_reg(void *handle, uint8_t reg, uint8_t *bufp, uint16_t len) {
   i2c_ctx_t *ctx = (i2c_ctx_t *)handle;
-  int error = i2c_burst_read(ctx->i2c_handle, ctx->i2c_addr, reg, bufp, len);
+
+  int error = devpm_get(ctx->i2c_handle);
+  if (error < 0) {
+    return error;
+  }
+  error = i2c_burst_read(ctx->i2c_handle, ctx->i2c_addr, reg, bufp, len);
+  devpm_put(ctx->i2c_handle);
   LOG_DBG("[0x%02X] Address 0x%02X:", ctx->i2c_addr, reg);
   LOG_HEXDUMP_DBG(bufp, len, "I2C RX");
   return error;
 }
 
 int8_t sensirion_i2c_hal_read(uint8_t address, uint8_t *data, uint16_t count) {
-  return i2c_read(i2c_b, data, count, address);
+  int error = devpm_get(i2c_b);
+  if (error < 0) {
+    return error;
+  }
+  error = i2c_read(i2c_b, data, count, address);
+  devpm_put(i2c_b);
+  return error;
 }
 
 int8_t sensirion_i2c_hal_write(uint8_t address, const uint8_t *data, uint16_t count) {
-  return i2c_write(i2c_b, data, count, address);
+  int error = devpm_get(i2c_b);
+  if (error < 0) {
+    return error;
+  }
+  error = i2c_write(i2c_b, data, count, address);
+  devpm_put(i2c_b);
+  return error;
 }
 
 void sensirion_i2c_hal_sleep_usec(uint32_t useconds) {
@@ -126,7 +153,9 @@ void i2c_scan(const struct device *dev) {
   uint8_t peripherals[MAX_PERIPHERALS];
   char name[32];
 
+  // Held active for the whole scan
   uint8_t found_nb = 0;
+  devpm_get(dev);
   for (uint8_t i = 0; i < MAX_PERIPHERALS; i++) {
     peripherals[i] = i2c_write(dev, buf, 1, i);
 
@@ -134,6 +163,7 @@ void i2c_scan(const struct device *dev) {
       found_nb++;
     }
   }
+  devpm_put(dev);
   if (found_nb) {
     LOG_INF(" - Number of Peripherals               : %d", found_nb);
     for (uint8_t i = 0; i < MAX_PERIPHERALS; i++) {
@@ -0,0 +1,221 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: latency.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/byteorder.h>
+
+#include <zephyr/logging/log.h>
+
+#include "latency.h"
+
+#if LATENCY_ENABLED
+
+LOG_MODULE_REGISTER(latency, LOG_LEVEL_INF);
+
+#define LATENCY_STAGE_NAME(name) #name,
+static const char *const latency_names[] = {LATENCY_STAGES(LATENCY_STAGE_NAME)};
+#undef LATENCY_STAGE_NAME
+
+static latency_hist_t latency_hists[LATENCY_STAGE_COUNT];
+
+// Stages are recorded from the acquisition and output threads, the shell reads them concurrently
+static struct k_spinlock latency_lock;
+
+static uint32_t latency_bucket(uint32_t us) {
+  if (us < LATENCY_SUB_BUCKETS) {
+    return us;
+  }
+
+  // The power of two selects the group, the following bits the bucket within the group
+  uint32_t msb = find_msb_set(us) - 1;
+  uint32_t sub = (us >> (msb - LATENCY_SUB_BITS)) & (LATENCY_SUB_BUCKETS - 1);
+
+  return MIN((msb - LATENCY_SUB_BITS + 1) * LATENCY_SUB_BUCKETS + sub, LATENCY_BUCKETS - 1);
+}
+
+// Largest value counted in a bucket
+static uint32_t latency_bucket_max(uint32_t bucket) {
+  if (bucket < LATENCY_SUB_BUCKETS) {
+    return bucket;
+  }
+
+  uint32_t shift = bucket / LATENCY_SUB_BUCKETS - 1;
+  uint32_t sub = bucket % LATENCY_SUB_BUCKETS;
+
+  return ((LATENCY_SUB_BUCKETS + sub + 1) << shift) - 1;
+}
+
+/**
+ * @brief Starts the timing counter and clears all histograms.
+ *
+ */
+void latency_init(void) {
+  timing_init();
+  timing_start();
+  latency_reset();
+}
+
+void latency_reset(void) {
+  k_spinlock_key_t key = k_spin_lock(&latency_lock);
+
+  memset(latency_hists, 0, sizeof(latency_hists));
+  for (size_t i = 0; i < ARRAY_SIZE(latency_hists); i++) {
+    latency_hists[i].min_us = UINT32_MAX;
+  }
+  k_spin_unlock(&latency_lock, key);
+}
+
+const char *latency_name(latency_stage_t stage) { return latency_names[stage]; }
+
+void latency_record(latency_stage_t stage, uint32_t us, uint64_t cycles) {
+  latency_hist_t *hist = &latency_hists[stage];
+  uint32_t bucket = latency_bucket(us);
+
+  k_spinlock_key_t key = k_spin_lock(&latency_lock);
+  hist->count++;
+  hist->sum_us += us;
+  hist->sum_cycles += cycles;
+  hist->min_us = MIN(hist->min_us, us);
+  hist->max_us = MAX(hist->max_us, us);
+  hist->buckets[bucket]++;
+  k_spin_unlock(&latency_lock, key);
+}
+
+/**
+ * @brief Computes min, mean, p99 and max of a stage, and the mean in timing counter cycles.
+ *
+ * The p99 is the upper bound of the bucket containing the 99th percentile, clamped to the observed range.
+ */
+void latency_summarize(latency_stage_t stage, latency_summary_t *summary) {
+  const latency_hist_t *hist = &latency_hists[stage];
+  uint32_t rank, seen = 0;
+
+  memset(summary, 0, sizeof(*summary));
+
+  // Walking the buckets under the lock is cheaper than a copy of the histogram on the stack
+  k_spinlock_key_t key = k_spin_lock(&latency_lock);
+  if (hist->count != 0) {
+    summary->count = hist->count;
+    summary->min_us = hist->min_us;
+    summary->max_us = hist->max_us;
+    summary->mean_us = (uint32_t)(hist->sum_us / hist->count);
+    summary->mean_cycles = (uint32_t)(hist->sum_cycles / hist->count);
+
+    rank = hist->count - hist->count / 100;
+    for (uint32_t i = 0; i < LATENCY_BUCKETS; i++) {
+      seen += hist->buckets[i];
+      if (seen >= rank) {
+        summary->p99_us = CLAMP(latency_bucket_max(i), hist->min_us, hist->max_us);
+        break;
+      }
+    }
+  }
+  k_spin_unlock(&latency_lock, key);
+}
+
+/**
+ * @brief Logs the summary of all stages that were recorded.
+ *
+ */
+void latency_log(void) {
+  latency_summary_t summary;
+
+  LOG_INF("Latency of %u stages in us", LATENCY_STAGE_COUNT);
+  for (size_t i = 0; i < LATENCY_STAGE_COUNT; i++) {
+    latency_summarize(i, &summary);
+    if (summary.count == 0) {
+      continue;
+    }
+    LOG_INF(" - %-16s : count %u, min/mean/p99/max %u/%u/%u/%u", latency_names[i], summary.count, summary.min_us,
+            summary.mean_us, summary.p99_us, summary.max_us);
+  }
+}
+
+/**
+ * @brief Packs the summary of all stages into the payload of a PROTO_TYPE_STATS frame.
+ *
+ *   u8 stage count, then for every stage in latency_stage_t order:
+ *   u8 stage, u32 count, u32 min, u32 mean, u32 p99, u32 max, all durations in us
+ *
+ * @param buf Buffer of LATENCY_PACKED_SIZE bytes
+ * @return Size of the payload
+ */
+size_t latency_pack(uint8_t *buf) {
+  latency_summary_t summary;
+  size_t n = 0;
+
+  buf[n++] = LATENCY_STAGE_COUNT;
+  for (size_t i = 0; i < LATENCY_STAGE_COUNT; i++) {
+    latency_summarize(i, &summary);
+    buf[n++] = i;
+    sys_put_le32(summary.count, &buf[n]);
+    sys_put_le32(summary.min_us, &buf[n + 4]);
+    sys_put_le32(summary.mean_us, &buf[n + 8]);
+    sys_put_le32(summary.p99_us, &buf[n + 12]);
+    sys_put_le32(summary.max_us, &buf[n + 16]);
+    n += LATENCY_PACKED_STAGE_SIZE - 1;
+  }
+  return n;
+}
+
+#if defined(CONFIG_SHELL)
+static int cmd_stats(const struct shell *sh, size_t argc, char **argv) {
+  ARG_UNUSED(argc);
+  ARG_UNUSED(argv);
+
+  latency_summary_t summary;
+
+  shell_print(sh, "%-16s %8s %8s %8s %8s %8s", "Stage [us]", "Count", "Min", "Mean", "P99", "Max");
+  for (size_t i = 0; i < LATENCY_STAGE_COUNT; i++) {
+    latency_summarize(i, &summary);
+    shell_print(sh, "%-16s %8u %8u %8u %8u %8u", latency_names[i], summary.count, summary.min_us, summary.mean_us,
+                summary.p99_us, summary.max_us);
+  }
+  return 0;
+}
+
+static int cmd_stats_reset(const struct shell *sh, size_t argc, char **argv) {
+  ARG_UNUSED(argc);
+  ARG_UNUSED(argv);
+
+  latency_reset();
+  shell_print(sh, "Latency histograms cleared");
+  return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(stats_cmds, SHELL_CMD(reset, NULL, "Clear the latency histograms", cmd_stats_reset),
+                               SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(stats, &stats_cmds, "Print the latency of every acquisition stage", cmd_stats);
+#endif
+
+#endif
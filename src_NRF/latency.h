@@ -0,0 +1,129 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: latency.h
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/timing/timing.h>
+
+#include "config.h"
+
+/*
+ * Latency histograms
+ *
+ * Every stage of the acquisition records its duration in a fixed-bucket histogram, so the distribution is available
+ * in the field without debug logging. The buckets are log-linear with LATENCY_SUB_BUCKETS per power of two, which
+ * bounds the error of the reported percentile to 25 % over the full range from 1 us to 33 s.
+ *
+ * The histograms are printed by the `stats` shell command and sent as PROTO_TYPE_STATS frame every
+ * LATENCY_SUMMARY_INTERVAL records.
+ */
+
+// Every sensor has a START, WAIT and READ stage in this order, see LATENCY_SENSOR_*
+#define LATENCY_SENSOR(X, sensor) X(sensor##_START) X(sensor##_WAIT) X(sensor##_READ)
+
+#define LATENCY_STAGES(X)                                                                                              \
+  LATENCY_SENSOR(X, SCD41)                                                                                             \
+  LATENCY_SENSOR(X, SGP41)                                                                                             \
+  LATENCY_SENSOR(X, ILPS28QSW)                                                                                         \
+  LATENCY_SENSOR(X, BME688)                                                                                            \
+  LATENCY_SENSOR(X, BH1730FVC)                                                                                         \
+  LATENCY_SENSOR(X, AS7331)                                                                                            \
+  X(RECORD)                                                                                                            \
+  X(OUTPUT)
+
+#define LATENCY_STAGE_ID(name) LATENCY_##name,
+typedef enum { LATENCY_STAGES(LATENCY_STAGE_ID) LATENCY_STAGE_COUNT } latency_stage_t;
+#undef LATENCY_STAGE_ID
+
+// Offsets from the first stage of a sensor
+#define LATENCY_SENSOR_START 0 // Triggering the conversion
+#define LATENCY_SENSOR_WAIT 1  // From the trigger until the sensor reports data ready, including the polls
+#define LATENCY_SENSOR_READ 2  // Reading the result and committing it to the record
+
+#define LATENCY_SUB_BITS 2
+#define LATENCY_SUB_BUCKETS (1 << LATENCY_SUB_BITS)
+#define LATENCY_BUCKETS 96 // Up to 2^25 us, longer durations are counted in the last bucket
+
+// Payload of a PROTO_TYPE_STATS frame, a stage count followed by the summary of every stage
+#define LATENCY_PACKED_STAGE_SIZE 21
+#define LATENCY_PACKED_SIZE (1 + LATENCY_STAGE_COUNT * LATENCY_PACKED_STAGE_SIZE)
+
+typedef struct {
+  uint32_t count;
+  uint32_t min_us;
+  uint32_t max_us;
+  uint64_t sum_us;
+  uint64_t sum_cycles; // Timing counter cycles, the same durations without the conversion to us
+  uint32_t buckets[LATENCY_BUCKETS];
+} latency_hist_t;
+
+typedef struct {
+  uint32_t count;
+  uint32_t min_us;
+  uint32_t mean_us;
+  uint32_t p99_us;
+  uint32_t max_us;
+  uint32_t mean_cycles;
+} latency_summary_t;
+
+#if LATENCY_ENABLED
+void latency_init(void);
+void latency_reset(void);
+const char *latency_name(latency_stage_t stage);
+void latency_record(latency_stage_t stage, uint32_t us, uint64_t cycles);
+void latency_summarize(latency_stage_t stage, latency_summary_t *summary);
+void latency_log(void);
+size_t latency_pack(uint8_t *buf);
+
+static inline timing_t latency_now(void) { return timing_counter_get(); }
+
+/**
+ * @brief Records the time elapsed since start, taken with latency_now().
+ *
+ */
+static inline void latency_end(latency_stage_t stage, timing_t start) {
+  timing_t end = timing_counter_get();
+  uint64_t cycles = timing_cycles_get(&start, &end);
+
+  latency_record(stage, (uint32_t)(timing_cycles_to_ns(cycles) / 1000), cycles);
+}
+#else
+static inline void latency_init(void) {}
+static inline void latency_reset(void) {}
+static inline void latency_record(latency_stage_t stage, uint32_t us, uint64_t cycles) {}
+static inline void latency_log(void) {}
+static inline timing_t latency_now(void) { return 0; }
+static inline void latency_end(latency_stage_t stage, timing_t start) {}
+#endif
+
+#endif /* LATENCY_H */
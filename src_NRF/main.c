@@ -3,7 +3,7 @@
  *
  * File: main.c
  *
- * Last edited: 30.10.2025
+ * Last edited: 16.10.2026
  *
  * Copyright (c) 2024 ETH Zurich and University of Bologna
  *
@@ -26,6 +26,8 @@
  * limitations under the License.
  */
 
+#include <string.h>
+
 #include <zephyr/device.h>
 #include <zephyr/kernel.h>
 
@@ -33,7 +35,6 @@
 #include <zephyr/drivers/i2c.h>
 #include <zephyr/drivers/led.h>
 #include <zephyr/drivers/sensor.h>
-#include <zephyr/drivers/uart.h>
 
 #include <zephyr/logging/log.h>
 #include <zephyr/logging/log_ctrl.h>
@@ -45,24 +46,28 @@
 #include "pwr/pwr_common.h"
 #include "pwr/thread_pwr.h"
 
+#include "adapt.h"
+#include "bench.h"
+#include "cfg.h"
 #include "config.h"
+#include "devpm.h"
+#include "drdy.h"
+#include "energy.h"
+#include "gating.h"
+#include "health.h"
 #include "i2c_helpers.h"
+#include "latency.h"
+#include "output.h"
+#include "predict.h"
+#include "record.h"
+#include "sched.h"
+#include "sensor.h"
 #include "test.h"
-#include "util.h"
-
-#include "as7331_sensor.h"
-#include "bh1730fvc_sensor.h"
-#include "bme688_sensor.h"
-#include "ilps28qsw_sensor.h"
-#include "ism330dhcx_sensor.h"
-#include "lis2duxs12_sensor.h"
-#include "max77654_sensor.h"
-#include "max_m10s_sensor.h"
-#include "scd41_sensor.h"
-#include "sgp41_sensor.h"
+#include "trace.h"
 
+#if BME688_ENABLED
 static const struct device *const bme_dev = DEVICE_DT_GET_ONE(bosch_bme680);
-static const struct device *const uart_dev = DEVICE_DT_GET_ONE(zephyr_cdc_acm_uart);
+#endif
 
 #define GPIO_NODE_debug_signal_1 DT_NODELABEL(gpio_debug_signal_1)
 static const struct gpio_dt_spec gpio_debug_1 = GPIO_DT_SPEC_GET(GPIO_NODE_debug_signal_1, gpios);
@@ -70,485 +75,603 @@ static const struct gpio_dt_spec gpio_debug_1 = GPIO_DT_SPEC_GET(GPIO_NODE_debug
 #define GPIO_NODE_debug_signal_2 DT_NODELABEL(gpio_debug_signal_2)
 static const struct gpio_dt_spec gpio_debug_2 = GPIO_DT_SPEC_GET(GPIO_NODE_debug_signal_2, gpios);
 
-#define GPIO_NODE_ext_as7331_ready DT_NODELABEL(gpio_ext_as7331_ready)
-static const struct gpio_dt_spec gpio_ext_as7331_ready = GPIO_DT_SPEC_GET(GPIO_NODE_ext_as7331_ready, gpios);
-
 LOG_MODULE_REGISTER(main, LOG_LEVEL_INF);
 
-// Imported from ilps28qsw_sensor.c
-extern stmdev_ctx_t ilps28qsw_ctx;
-extern ilps28qsw_md_t ilps28qsw_md;
-
-// Imported from bh1730_sensor.c
-extern bh1730_t bh1730_ctx;
-
-// Imported from as7331_sensor.c
-extern i2c_ctx_t as7331_i2c_ctx;
-extern as7331_t as7331_ctx;
-
-typedef struct sensor_values {
-  uint32_t timestamp;
-  uint16_t scd41_co2;
-  float scd41_temperature;
-  float scd41_humidity;
-  uint16_t sgp41_voc;
-  uint16_t sgp41_nox;
-  float ilps28qsw_pressure;
-  float ilps28qsw_temperature;
-  float bme688_temperature;
-  float bme688_pressure;
-  float bme688_humidity;
-  float bme688_gas_resistance;
-  uint16_t bh1730_visible;
-  uint16_t bh1730_ir;
-  uint32_t bh1730_lux;
-  float as7331_temp;
-  uint16_t as7331_uva;
-  uint16_t as7331_uvb;
-  uint16_t as7331_uvc;
-} __attribute__((aligned(4))) sensor_values_t;
+// Sensors on both buses collect into the staging record, their fields are then committed to the shared record under
+// the lock, so the output never sees a half-updated sensor. The lock also guards the periods, which are derived on the
+// queue that changed the configuration, see acq_update_periods().
+static sensor_values_t staging = {0};
+static sensor_values_t sensor_values = {0};
+static struct k_spinlock record_lock;
+
+// Power state of a sensor, a gated sensor passes through all of them once per sample, see acq_wake()
+typedef enum {
+  ACQ_POWER_OFF,
+  ACQ_POWER_SETTLING, // Supply switched on, init() follows after SENSOR_SETTLE_TIME
+  ACQ_POWER_WARMING,  // Configured, the conversion follows after the warm-up of the gating model
+  ACQ_POWER_ON,
+} acq_power_t;
+
+/**
+ * @brief Split-phase acquisition of one sensor of the registry.
+ *
+ * All sensors with the same deadline start their conversion first and are collected as they finish, so a period
+ * takes as long as the slowest conversion instead of the sum of all of them.
+ */
+typedef struct {
+  const sensor_driver_t *driver;
+
+  uint32_t conversion_ms; // Conversion time of the applied configuration, 0 for sensors converting continuously
+  uint32_t period_ms;     // Period without adaptive sampling
+  uint32_t min_period_ms; // Shortest period of the current configuration
+  uint32_t timeout_ms;    // Not ready after this time counts as failure
+  bool gated;             // Switched off between two samples, see gating.h
+  acq_power_t power;
+  bool converting;
+  uint32_t start_time;
+  int64_t start_ticks;
+  uint32_t checks;  // Ready checks of the current conversion
+  uint32_t busy_us; // Time of the last check that found the sensor busy
+  timing_t wait_start;
+  predict_t predict;
+  energy_window_t energy; // From the start of the conversion until the value is committed
+  health_t health;
+  sched_task_t task;
+} acq_sensor_t;
+
+static acq_sensor_t sensors[SENSOR_ACQ_COUNT];
+
+static sched_task_t record_task;
+static sched_task_t energy_task;
+
+// Sensor tasks followed by the record output and the energy meter
+static sched_task_t *tasks[SENSOR_ACQ_COUNT + 2];
+static size_t task_count = 0;
+
+// Given once the benchmark has completed to stop the acquisition and power off all sensors
+static K_SEM_DEFINE(acq_abort_sem, 0, 1);
+
+static void acq_abort(void) { k_sem_give(&acq_abort_sem); }
+
+// Periods of 0 in config.h follow the runtime sampling time
+static uint32_t acq_period(uint32_t period_ms) { return period_ms ? period_ms : cfg_get(CFG_SAMPLING_TIME); }
+
+/**
+ * @brief Applies the period of a sensor, the adaptive period if enabled, else the fixed one.
+ *
+ * Called with record_lock held.
+ */
+static void acq_apply_period(acq_sensor_t *sensor) {
+  uint32_t period_ms = sensor->period_ms;
 
-int main(void) {
-  int16_t error_i16 = NO_ERROR;
-  int32_t error_i32 = NO_ERROR;
+  if (ADAPT_ENABLED && sensor->driver->adapt_count) {
+    period_ms = adapt_period(sensor->driver->adapt, sensor->driver->adapt_count);
+  }
+  sched_task_set_period(&sensor->task, MAX(period_ms, sensor->min_period_ms));
+}
 
-  uint16_t default_rh = 0x8000;
-  uint16_t default_t = 0x6666;
+/**
+ * @brief Returns the record period, with adaptive sampling the period of the fastest sensor.
+ *
+ * Called with record_lock held.
+ */
+static uint32_t acq_record_period(void) {
+  uint32_t period_ms = UINT32_MAX;
 
-  LOG_INIT();
+  if (!ADAPT_ENABLED) {
+    return acq_period(RECORD_PERIOD);
+  }
+  for (size_t i = 0; i < ARRAY_SIZE(sensors); i++) {
+    period_ms = MIN(period_ms, sensors[i].task.period_ms);
+  }
+  return MAX(period_ms, SAMPLING_TIME_MIN);
+}
 
-  // Clear screen
-  LOG_INF("Sensor Shield Scan Test on %s", CONFIG_BOARD);
+/**
+ * @brief Derives the task periods from the runtime configuration, they apply from the next deadline.
+ *
+ * Runs on the queue of the record or of a sensor, the periods of all sensors are updated under record_lock.
+ */
+static void acq_update_periods(void) {
+  uint32_t conversion_ms[ARRAY_SIZE(sensors)];
+  uint32_t interval_ms[ARRAY_SIZE(sensors)];
 
-  gpio_pin_set_dt(&gpio_debug_1, 0);
-  gpio_pin_set_dt(&gpio_debug_2, 0);
+  // The hooks may query the sensor driver, so they are called before taking the lock
+  for (size_t i = 0; i < ARRAY_SIZE(sensors); i++) {
+    const sensor_driver_t *driver = sensors[i].driver;
 
-  // Set gpio_ext_as7331_ready as active high input
-  gpio_pin_configure_dt(&gpio_ext_as7331_ready, GPIO_INPUT);
+    conversion_ms[i] = driver->conversion_ms ? driver->conversion_ms() : 0;
+    interval_ms[i] = driver->interval_ms ? driver->interval_ms() : 0;
+  }
 
-  // Initialize and start power management
-  pwr_init();
-  pwr_start();
+  k_spinlock_key_t key = k_spin_lock(&record_lock);
+  for (size_t i = 0; i < ARRAY_SIZE(sensors); i++) {
+    acq_sensor_t *sensor = &sensors[i];
+    const sensor_driver_t *driver = sensor->driver;
 
-  k_msleep(100);
+    // Shortest period, a new conversion is only started after the previous one was read
+    sensor->conversion_ms = conversion_ms[i];
+    sensor->min_period_ms = sensor->conversion_ms ? sensor->conversion_ms + ACQ_POLL_TIME : interval_ms[i];
+    sensor->period_ms = driver->period_ms == ACQ_PERIOD_INTERVAL ? interval_ms[i] : acq_period(driver->period_ms);
 
-  if (!device_is_ready(uart_dev)) {
-    LOG_ERR("CDC ACM device not ready");
-    k_msleep(1000);
-    return -1;
+    // A sensor that is not ready after twice its expected time is considered stuck
+    sensor->timeout_ms = 2 * MAX(sensor->conversion_ms, sensor->min_period_ms) + ACQ_TIMEOUT_MARGIN;
+    acq_apply_period(sensor);
   }
+  sched_task_set_period(&record_task, acq_record_period());
+  k_spin_unlock(&record_lock, key);
+}
 
-  error_i32 = usb_enable(NULL);
-  if (error_i32 != NO_ERROR) {
-    k_msleep(1000);
+/**
+ * @brief Power cycles and reinitializes a sensor.
+ *
+ * Sensors without power switch are only reconfigured. A gated sensor is only switched off, the next sample powers it
+ * on with its warm-up, see acq_wake(). A sensor that is always on keeps its power state, if the recovery fails the
+ * next conversion fails as well and the health backoff retries the recovery.
+ */
+static int acq_recover(acq_sensor_t *sensor) {
+  const sensor_driver_t *driver = sensor->driver;
+
+  if (driver->power_off) {
+    driver->power_off();
+  }
+  if (sensor->gated) {
+    sensor->power = ACQ_POWER_OFF;
+    return NO_ERROR;
+  }
+  if (sensor_power_up(BIT(sensor - sensors)) != NO_ERROR) {
     return -1;
   }
-  LOG_INF("USB enabled");
-
-  if (!device_is_ready(bme_dev)) {
-    LOG_ERR("BME688 not not ready.");
-    k_msleep(1000);
+  if (driver->configure && driver->configure() != NO_ERROR) {
     return -1;
   }
-  LOG_INF("Device %p name is %s", bme_dev, bme_dev->name);
+  return NO_ERROR;
+}
 
-  k_msleep(5000);
+/**
+ * @brief Isolates a failed conversion to its sensor.
+ *
+ * The fields of the sensor are marked missing and it is retried after a backoff, see health.h. The other sensors
+ * continue with their own periods, a recovery only blocks the queue of the bus the sensor is connected to.
+ */
+static void acq_fault(acq_sensor_t *sensor, bool timeout) {
+  if (sensor->converting) {
+    sensor->converting = false;
+    drdy_bind(sensor->driver->drdy, NULL);
+    energy_window_end(&sensor->energy);
+    TRACE_ID_END(sensor->driver->trace_id, 0);
+  }
 
-  // ------------------- Sensor Tests ----------------------------------------------------------------------------------
-  LOG_INF("===== Testing all sensors ======");
-  test_sensors();
+  // A sensor failing to come up is switched off again, the next attempt starts with power_on()
+  if (sensor->power != ACQ_POWER_ON && sensor->driver->power_off) {
+    sensor->driver->power_off();
+    sensor->power = ACQ_POWER_OFF;
+  }
 
-  // ------------------- Sensor Data Collection ------------------------------------------------------------------------
-  LOG_INF("===== Gathering Data ======");
-  sensor_values_t sensor_values = {0};
-
-  // ----------------- SCD41 (CO2 Sensor) ------------------------------------------------------------------------------
-  LOG_INF("Preparing SCD41");
-  LOG_INF(" - Turn on SCD41");
-  poweron_scd41();
-  error_i16 = scd4x_start_periodic_measurement();
-  if (error_i16 != NO_ERROR) {
-    LOG_ERR(" * Error %d starting periodic measurement", error_i16);
-    k_msleep(1000);
-    return -1;
+  k_spinlock_key_t key = k_spin_lock(&record_lock);
+  record_set_missing(&sensor_values, sensor->driver->offset, sensor->driver->size);
+  k_spin_unlock(&record_lock, key);
+
+  if (health_fault(&sensor->health, k_uptime_get_32(), timeout)) {
+    LOG_WRN("%s Recovering after %u failures", sensor->task.name, sensor->health.failures);
+    if (acq_recover(sensor) != NO_ERROR) {
+      LOG_ERR(" * %s Recovery failed", sensor->task.name);
+    }
   }
 
-  // -----------------  SGP41 (VOC Sensor) -----------------------------------------------------------------------------
-  LOG_INF("Preparing SGP41");
-  LOG_INF(" - Turn on SGP41");
-  poweron_sgp41();
+  // Most likely the bus or the supply of the sensors failed, the acquisition keeps retrying at the longest backoff so
+  // the hub comes back without a reset once the fault is gone
+  if (health_all_failed()) {
+    LOG_ERR("All sensors failed, retrying every %u s", HEALTH_RETRY_MAX / 1000);
+  }
+}
 
-  LOG_INF(" - Start conditioning for 10s");
-  // Perform conditioning on SGP41 for 10s
-  error_i16 = sgp41_execute_conditioning(default_rh, default_t, &sensor_values.sgp41_voc);
-  if (error_i16 != NO_ERROR) {
-    LOG_ERR(" * Error %d starting conditioning", error_i16);
-    k_msleep(1000);
-    return -1;
+/**
+ * @brief Powers on a gated sensor ahead of its conversion without blocking the queue of its bus.
+ *
+ * The supply is switched on first, init() and configure() follow after SENSOR_SETTLE_TIME and the conversion after
+ * the warm-up of the gating model. Sensors sharing a deadline settle and warm up concurrently.
+ *
+ * @return Whether the sensor is ready for the conversion
+ */
+static bool acq_wake(acq_sensor_t *sensor, sched_task_t *task) {
+  const sensor_driver_t *driver = sensor->driver;
+  uint32_t warmup_ms = driver->gating ? driver->gating->warmup_ms : driver->warmup_ms;
+
+  switch (sensor->power) {
+  case ACQ_POWER_OFF:
+    if (driver->power_on && driver->power_on() != NO_ERROR) {
+      acq_fault(sensor, false);
+      return false;
+    }
+    sensor->power = ACQ_POWER_SETTLING;
+    sched_task_defer(task, SENSOR_SETTLE_TIME);
+    return false;
+  case ACQ_POWER_SETTLING:
+    if ((driver->init && driver->init() != NO_ERROR) || (driver->configure && driver->configure() != NO_ERROR)) {
+      acq_fault(sensor, false);
+      return false;
+    }
+    sensor->power = ACQ_POWER_WARMING;
+    if (warmup_ms) {
+      sched_task_defer(task, warmup_ms);
+      return false;
+    }
+    sensor->power = ACQ_POWER_ON;
+    return true;
+  default:
+    sensor->power = ACQ_POWER_ON;
+    return true;
   }
-  k_msleep(10000);
-  LOG_INF(" - SRAW VOC (Conditioning)             : %u", sensor_values.sgp41_voc);
+}
 
-  LOG_INF(" - Start measuring raw signals");
-  sgp41_measure_raw_signals(default_rh, default_t, &sensor_values.sgp41_voc, &sensor_values.sgp41_nox);
-  if (error_i16 != NO_ERROR) {
-    LOG_ERR(" * Error %d reading signals", error_i16);
-    k_msleep(1000);
-    return -1;
-  } else {
-    LOG_INF(" - SRAW VOC                            : %u", sensor_values.sgp41_voc);
-    LOG_INF(" - SRAW NOX                            : %u", sensor_values.sgp41_nox);
+/**
+ * @brief Chooses between gating and always-on for the current period and switches a gated sensor off.
+ *
+ * Called after every sample while the sensor is idle, so its measurement mode can be changed.
+ */
+static void acq_gate(acq_sensor_t *sensor) {
+  const sensor_driver_t *driver = sensor->driver;
+  bool gated = driver->gating && gating_decide(driver->gating, sensor->task.period_ms, sensor->conversion_ms);
+
+  if (gated != sensor->gated) {
+    LOG_INF("%s %s at a period of %u ms", sensor->task.name, gated ? "Gated" : "Always on", sensor->task.period_ms);
+    sensor->gated = gated;
+
+    // The mode of an always-on sensor is applied right away, a gated sensor applies it when powered on again
+    if (gated) {
+      driver->power_off();
+      sensor->power = ACQ_POWER_OFF;
+    }
+    if (driver->set_gated) {
+      driver->set_gated(gated);
+    }
+    if (!gated && driver->configure && driver->configure() != NO_ERROR) {
+      acq_fault(sensor, false);
+    }
+    acq_update_periods();
+    predict_reset(&sensor->predict, sensor->conversion_ms);
+    return;
   }
 
-  // ----------------- ILPS28QSW (Pressure Sensor) ---------------------------------------------------------------------
-  // No power on needed.
+  if (gated) {
+    driver->power_off();
+    sensor->power = ACQ_POWER_OFF;
+  }
+}
+
+static void acq_sample(sched_task_t *task) {
+  acq_sensor_t *sensor = task->user_data;
+  const sensor_driver_t *driver = sensor->driver;
+  bool ready = false;
+
+  // Trigger the conversion and come back once it is expected to be finished
+  if (!sensor->converting) {
+    // A failed sensor waits for its backoff, its fields stay marked missing
+    if (!health_ready(&sensor->health, k_uptime_get_32())) {
+      return;
+    }
 
-  // ----------------- BME688 (Environmental Sensor) -------------------------------------------------------------------
-  // No power on needed.
+    // A gated sensor is powered on again ahead of the conversion
+    if (sensor->power != ACQ_POWER_ON && !acq_wake(sensor, task)) {
+      return;
+    }
 
-  // ----------------- BH1730FVC (Ambient Light Sensor) ----------------------------------------------------------------
-  LOG_INF("Preparing BH1730FVC");
-  LOG_INF(" - Turn on BH1730FVC");
-  error_i16 = poweron_bh1730();
-  if (error_i16 != NO_ERROR) {
-    LOG_ERR(" * Error %d powering on BH1730FVC", error_i16);
-    k_msleep(1000);
-    return -1;
+    // Parameters changed at runtime are applied between two conversions, the sensor keeps running
+    if (driver->configure && cfg_take(driver->cfg_mask)) {
+      if (driver->configure() != NO_ERROR) {
+        acq_fault(sensor, false);
+        return;
+      }
+      acq_update_periods();
+      predict_reset(&sensor->predict, sensor->conversion_ms);
+    }
+
+    // The slice on the track of the sensor spans from the start of the conversion until the value is committed
+    TRACE_ID_BEGIN(driver->trace_id, 0);
+    energy_window_begin(&sensor->energy);
+    sensor->converting = true;
+    timing_t start = latency_now();
+    if (driver->trigger() != NO_ERROR) {
+      acq_fault(sensor, false);
+      return;
+    }
+    latency_end(driver->latency + LATENCY_SENSOR_START, start);
+    sensor->start_time = k_uptime_get_32();
+    sensor->start_ticks = k_uptime_ticks();
+    sensor->checks = 0;
+    sensor->busy_us = 0;
+    sensor->wait_start = latency_now();
+
+    // The data-ready interrupt runs the ready check early, the deferred check below is the fallback
+    drdy_bind(driver->drdy, task);
+
+    // Sleep until shortly before the sensor is expected to be ready, the retry must not exceed the period
+    uint32_t wake_ms = ACQ_PREDICT ? predict_wake_ms(&sensor->predict) : sensor->conversion_ms;
+    wake_ms = MIN(wake_ms, task->period_ms - 1);
+    if (wake_ms) {
+      sched_task_defer(task, wake_ms);
+      return;
+    }
   }
 
-  LOG_INF(" - Configuring BH1730FVC");
-  error_i32 = bh1730_init(&bh1730_ctx, BH1730_GAIN_X64, BH1730_INT_50MS);
-  if (error_i32) {
-    LOG_ERR(" * Error %d initializing BH1730FVC", error_i32);
-    k_msleep(1000);
-    return -1;
-  } else {
-    LOG_INF(" - Integration Time                    : %.2f ms" SPACES, (bh1730_ctx.integration_time_us / 1000.f));
-    LOG_INF(" - Gain                                : x%d" SPACES, bh1730_ctx.gain);
+  uint32_t check_us = k_ticks_to_us_near32(k_uptime_ticks() - sensor->start_ticks);
+
+  sensor->checks++;
+  if (driver->ready(&ready) != NO_ERROR) {
+    acq_fault(sensor, false);
+    return;
   }
 
-  // ----------------- AS7331 (UV Sensor) ----------------------------------------------------------------------------
-  LOG_INF("Preparing AS7331");
-  LOG_INF(" - Turn on AS7331");
-  error_i16 = poweron_as7331();
-  if (error_i16 != NO_ERROR) {
-    LOG_ERR(" * Error %d powering on AS7331", error_i16);
-    k_msleep(1000);
-    return -1;
+  if (!ready) {
+    if ((k_uptime_get_32() - sensor->start_time) > sensor->timeout_ms) {
+      LOG_ERR(" * %s Timeout waiting for data ready status", task->name);
+      acq_fault(sensor, true);
+      return;
+    }
+    TRACE_ID_INSTANT(driver->trace_id, k_uptime_get_32() - sensor->start_time);
+    sensor->busy_us = check_us;
+    sched_task_defer(task, driver->poll_ms ? driver->poll_ms : ACQ_POLL_TIME);
+    return;
+  }
+  LOG_DBG("%s Data ready after %u ms", task->name, k_uptime_get_32() - sensor->start_time);
+  drdy_bind(driver->drdy, NULL);
+  predict_update(&sensor->predict, sensor->busy_us, check_us, sensor->checks);
+  latency_end(driver->latency + LATENCY_SENSOR_WAIT, sensor->wait_start);
+
+  timing_t start = latency_now();
+  if (driver->read(&staging) != NO_ERROR) {
+    acq_fault(sensor, false);
+    return;
+  }
+  sensor->converting = false;
+
+  k_spinlock_key_t key = k_spin_lock(&record_lock);
+  memcpy((uint8_t *)&sensor_values + driver->offset, (uint8_t *)&staging + driver->offset, driver->size);
+  k_spin_unlock(&record_lock, key);
+  latency_end(driver->latency + LATENCY_SENSOR_READ, start);
+  energy_window_end(&sensor->energy);
+  TRACE_ID_END(driver->trace_id, 0);
+  health_ok(&sensor->health);
+
+  // Sample faster while the signal changes, the new period applies from the next deadline
+  if (ADAPT_ENABLED && driver->adapt_count) {
+    adapt_update(driver->adapt, driver->adapt_count, &staging, k_uptime_get_32());
+    key = k_spin_lock(&record_lock);
+    acq_apply_period(sensor);
+    k_spin_unlock(&record_lock, key);
   }
 
-  error_i32 = as7331_reset(&as7331_ctx);
-  if (error_i32) {
-    LOG_ERR(" * Error %d resetting AS7331", error_i32);
-    k_msleep(1000);
-    return -1;
+  if (GATING_ENABLED && driver->gating) {
+    acq_gate(sensor);
+  }
+}
+
+// ----------------- Record Output -------------------------------------------------------------------------------------
+static void record_output(sched_task_t *task) {
+  static uint32_t records = 0;
+
+  if (cfg_take(BIT(CFG_SAMPLING_TIME))) {
+    acq_update_periods();
+  } else if (ADAPT_ENABLED) {
+    k_spinlock_key_t key = k_spin_lock(&record_lock);
+    sched_task_set_period(task, acq_record_period());
+    k_spin_unlock(&record_lock, key);
   }
 
-  error_i16 = poweron_as7331();
-  if (error_i16 != NO_ERROR) {
-    LOG_ERR(" * Error %d powering on AS7331", error_i16);
-    k_msleep(1000);
-    return -1;
+  gpio_pin_set_dt(&gpio_debug_1, 1);
+  TRACE_BEGIN(RECORD, records);
+  timing_t start = latency_now();
+
+  k_spinlock_key_t key = k_spin_lock(&record_lock);
+  sensor_values_t record = sensor_values;
+  k_spin_unlock(&record_lock, key);
+
+  // Timestamp with the deadline so the output time does not add jitter to the record
+  record.timestamp = sched_task_deadline_ms(task);
+  energy_record(&record);
+
+  if (!output_submit(&record)) {
+    LOG_DBG("Output ring full, record dropped");
   }
 
-  // Specify sensor parameters //
-  MMODE AS7331_mmode = AS7331_CMD_MODE; // choices are modes are CONT, CMD, SYNS, SYND
-  CCLK AS7331_cclk = AS7331_1024;       // choices are 1.024, 2.048, 4.096, or 8.192 MHz
-  uint8_t AS7331_sb = 0x00;             // standby enabled 0x01 (to save power), standby disabled 0x00
-  uint8_t AS7331_breakTime = 255; // sample time == 8 us x breakTime (0 - 255, or 0 - 2040 us range), CONT or SYNX modes
+  latency_end(LATENCY_RECORD, start);
+  TRACE_END(RECORD, records);
+  gpio_pin_set_dt(&gpio_debug_1, 0);
+
+  records++;
+  if (BENCH_ENABLED && bench_record(&record)) {
+    acq_abort();
+  }
+  if (SCHED_STATS_INTERVAL && (records % SCHED_STATS_INTERVAL) == 0) {
+    LOG_INF("Scheduler statistics after %u records", records);
+    for (size_t i = 0; i < task_count; i++) {
+      sched_stats_log(tasks[i]);
+    }
+    output_stats_log();
+    predict_log();
+    energy_log();
+    devpm_log();
+  }
+  if (LATENCY_ENABLED && LATENCY_SUMMARY_INTERVAL && (records % LATENCY_SUMMARY_INTERVAL) == 0) {
+    latency_log();
+    output_send_stats();
+  }
+  if (OUTPUT_SCHEMA_INTERVAL && (records % OUTPUT_SCHEMA_INTERVAL) == 0) {
+    output_send_schema();
+  }
+  if (TRACE_ENABLED && TRACE_DUMP_INTERVAL && (records % TRACE_DUMP_INTERVAL) == 0) {
+    output_send_trace();
+  }
+}
+
+int main(void) {
+  int32_t error_i32 = NO_ERROR;
+
+  LOG_INIT();
+  trace_init();
 
-  uint8_t AS7331_gain = 10; // ADCGain = 2^(11-gain), by 2s, 1 - 2048 range,  0 < gain = 11 max, default 10
-  uint8_t AS7331_time = 11; // 2^time in ms, so 0x07 is 2^6 = 64 ms, 0 < time = 15 max, default  6
+  // Clear screen
+  LOG_INF("Sensor Shield Scan Test on %s", CONFIG_BOARD);
 
-  LOG_INF(" - Configuring AS7331");
-  error_i32 = as7331_set_configuration_mode(&as7331_ctx);
-  if (error_i32) {
-    LOG_ERR(" * Error %d setting configuration mode", error_i32);
+  gpio_pin_set_dt(&gpio_debug_1, 0);
+  gpio_pin_set_dt(&gpio_debug_2, 0);
+
+  // Initialize and start power management
+  pwr_init();
+  pwr_start();
+
+  k_msleep(100);
+
+  // Configure the data-ready lines (AS7331 READY is an active high input on the GPIO expander)
+  error_i32 = drdy_init();
+  if (error_i32 != NO_ERROR) {
+    LOG_ERR("Error %d configuring data-ready lines", error_i32);
     k_msleep(1000);
     return -1;
   }
-  error_i32 =
-      as7331_init(&as7331_ctx, AS7331_mmode, AS7331_cclk, AS7331_sb, AS7331_breakTime, AS7331_gain, AS7331_time);
-  if (error_i32) {
-    LOG_ERR(" * Error %d initializing sensor", error_i32);
+
+  // Loaded before the output accepts configuration commands from the host, see cfg_command()
+  LOG_INF("Loading configuration");
+  cfg_init();
+
+  if (output_init() != NO_ERROR) {
     k_msleep(1000);
     return -1;
   }
 
-  LOG_INF(" - Starting continuous measurement");
-  error_i32 = as7331_set_measurement_mode(&as7331_ctx);
-  if (error_i32) {
-    LOG_ERR(" * Error %d setting measurement mode", error_i32);
+  // Suspend the buses while idle, the USB state is followed from here on
+  devpm_init();
+
+  error_i32 = usb_enable(DEVPM_ENABLED ? devpm_usb_status : NULL);
+  if (error_i32 != NO_ERROR) {
     k_msleep(1000);
     return -1;
   }
+  LOG_INF("USB enabled");
 
-  // Already start first  measurement
-  error_i32 = as7331_start_measurement(&as7331_ctx);
-  if (error_i32) {
-    LOG_ERR(" * AS7331 Error %d starting one-shot measurement", error_i32);
+#if BME688_ENABLED
+  if (!device_is_ready(bme_dev)) {
+    LOG_ERR("BME688 not not ready.");
     k_msleep(1000);
     return -1;
   }
+  LOG_INF("Device %p name is %s", bme_dev, bme_dev->name);
+#endif
 
-  // ----------------- CSV Header --------------------------------------------------------------------------------------
-  // Print CSV header for sensor_values
-  printf("Timestamp,"
-         "SCD41_CO2,"
-         "SCD41_Temperature,"
-         "SCD41_Humidity,"
-         "SGP41_VOC,"
-         "SGP41_NOX,"
-         "ILPS28QSW_Pressure,"
-         "ILPS28QSW_Temperature,"
-         "BME688_Temperature,"
-         "BME688_Pressure,"
-         "BME688_Humidity,"
-         "BME688_Gas_Resistance,"
-         "BH1730FVC_Visible,"
-         "BH1730FVC_IR,"
-         "BH1730FVC_Lux,"
-         "AS7331_Temperature,"
-         "AS7331_UVA,"
-         "AS7331_UVB,"
-         "AS7331_UVC\n");
-
-  // ----------------- Main Loop --------------------------------------------------------------------------------------
-  bool data_ready;
-  uint32_t time;
-
-  int32_t loop_time = k_uptime_get_32();
-
-  while (1) {
-    gpio_pin_set_dt(&gpio_debug_1, 1);
-    sync();
-
-    // ----------------- SCD41 (CO2 Sensor) ----------------------------------------------------------------------------
-    // Wait until data is ready
-    data_ready = false;
-    time = k_uptime_get_32();
-    do {
-      error_i16 = scd4x_get_data_ready_status(&data_ready);
-      if (error_i16 != NO_ERROR) {
-        LOG_ERR(" * SCD41 Error %d getting data ready status", error_i16);
-        break;
-      }
+  k_msleep(5000);
 
-      if (!data_ready) {
-        k_usleep(100);
+  // ------------------- Sensor Tests ----------------------------------------------------------------------------------
+  LOG_INF("===== Testing all sensors ======");
+  test_sensors();
 
-        if ((k_uptime_get_32() - time) > 10 * 1000) {
-          LOG_ERR(" * SCD41 Timeout waiting for data ready status");
-          break;
-        }
-      }
-    } while (!data_ready);
-    LOG_DBG("SCD41 Data ready after %u ms", k_uptime_get_32() - time);
+#if FMT_BENCHMARK
+  LOG_INF("===== Benchmarking CSV formatter ======");
+  test_fmt();
+#endif
 
-    int32_t scd41_temperature, scd41_humidity;
-    error_i16 = scd4x_read_measurement(&sensor_values.scd41_co2, &scd41_temperature, &scd41_humidity);
+  // ------------------- Sensor Data Collection ------------------------------------------------------------------------
+  LOG_INF("===== Gathering Data ======");
 
-    sensor_values.scd41_temperature = scd41_temperature / 1000.0f;
-    sensor_values.scd41_humidity = scd41_humidity / 1000.0f;
+  // ----------------- Sensors -----------------------------------------------------------------------------------------
+  // A sensor failing to start is not fatal, it is marked missing and recovered by the acquisition, see acq_fault()
+  uint32_t warmup_ms = 0;
 
-    if (error_i16 != NO_ERROR) {
-      LOG_ERR(" * SCD41 Error %d reading measurement", error_i16);
-      break;
-    }
-    sync();
+  // All sensors are powered on behind a single settle delay and start always on, see acq_gate()
+  LOG_INF("Powering on %u sensors", SENSOR_ACQ_COUNT);
+  sensor_power_up(BIT_MASK(SENSOR_ACQ_COUNT));
 
-    // -----------------  SGP41 (VOC Sensor) ---------------------------------------------------------------------------
-    error_i16 = sgp41_measure_raw_signals(default_rh, default_t, &sensor_values.sgp41_voc, &sensor_values.sgp41_nox);
-    if (error_i16 != NO_ERROR) {
-      LOG_ERR(" * SGP41 Error %d reading signals", error_i16);
-      break;
-    }
-    sync();
-
-    // ----------------- ILPS28QSW (Pressure Sensor) -------------------------------------------------------------------
-    ilps28qsw_data_t data;
-    error_i32 = ilps28qsw_data_get(&ilps28qsw_ctx, &ilps28qsw_md, &data);
-    if (error_i32) {
-      LOG_ERR(" * ILPS28QSW Error %d getting data", error_i32);
-      break;
-    }
-    sensor_values.ilps28qsw_pressure = data.pressure.hpa;
-    sensor_values.ilps28qsw_temperature = data.heat.deg_c;
-    sync();
-
-    // ----------------- BME688 (Environmental Sensor) -----------------------------------------------------------------
-    struct sensor_value temp, press, humidity, gas_res;
-    sensor_sample_fetch(bme_dev);
-    sensor_channel_get(bme_dev, SENSOR_CHAN_AMBIENT_TEMP, &temp);
-    sensor_channel_get(bme_dev, SENSOR_CHAN_PRESS, &press);
-    sensor_channel_get(bme_dev, SENSOR_CHAN_HUMIDITY, &humidity);
-    sensor_channel_get(bme_dev, SENSOR_CHAN_GAS_RES, &gas_res);
-
-    sensor_values.bme688_temperature = temp.val1 + (temp.val2 / 1000000.0);
-    sensor_values.bme688_pressure = press.val1 + (press.val2 / 1000000.0);
-    sensor_values.bme688_humidity = humidity.val1 + (humidity.val2 / 1000000.0);
-    sensor_values.bme688_gas_resistance = gas_res.val1 + (gas_res.val2 / 1000000.0);
-    sync();
-
-    // ----------------- BH1730FVC (Ambient Light Sensor) --------------------------------------------------------------
-    uint8_t data_ready = false;
-    time = k_uptime_get_32();
-    do {
-      error_i32 = bh1730_valid(&bh1730_ctx, &data_ready);
-      if (error_i32) {
-        LOG_ERR(" * BH1730FVC Error %d reading valid status", error_i32);
-        break;
-      }
+  for (size_t i = 0; i < SENSOR_ACQ_COUNT; i++) {
+    const sensor_driver_t *driver = &sensor_registry[i];
 
-      if (!data_ready) {
-        k_usleep(100);
-
-        if ((k_uptime_get_32() - time) > 10 * 1000) {
-          LOG_ERR(" * BH1730FVC Timeout waiting for data ready status");
-          break;
-        }
+    LOG_INF("Preparing %s", driver->name);
+    if (driver->configure) {
+      error_i32 = driver->configure();
+      if (error_i32 != NO_ERROR) {
+        LOG_ERR(" * Error %d configuring %s", error_i32, driver->name);
       }
-    } while (!data_ready);
-    LOG_DBG("BH1730FVC Data ready after %u ms", k_uptime_get_32() - time);
-
-    error_i32 = bh1730_read_visible(&bh1730_ctx, &sensor_values.bh1730_visible);
-    if (error_i32) {
-      LOG_ERR(" * BH1730FVC Error %d reading visible light", error_i32);
-      break;
     }
+    sensors[i].power = ACQ_POWER_ON;
+    warmup_ms = MAX(warmup_ms, driver->warmup_ms);
+  }
 
-    error_i32 = bh1730_read_ir(&bh1730_ctx, &sensor_values.bh1730_ir);
-    if (error_i32) {
-      LOG_ERR(" * BH1730FVC Error %d reading IR light", error_i32);
-      break;
-    }
+  // The sensors warm up concurrently, e.g. the conditioning of the SGP41
+  LOG_INF("Warming up for %u ms", warmup_ms);
+  k_msleep(warmup_ms);
 
-    error_i32 = bh1730_read_lux(&bh1730_ctx, &sensor_values.bh1730_lux);
-    if (error_i32) {
-      LOG_ERR(" * BH1730FVC Error %d reading lux", error_i32);
-      break;
-    }
-    sync();
-
-    // ----------------- AS7331 (UV Sensor) ----------------------------------------------------------------------------
-    data_ready = false;
-    // as7331_reg_osrstat_t status;
-    time = k_uptime_get_32();
-    do {
-      // error_i32 = as7331_get_status(&as7331_ctx, &status);
-      // if (error_i32) {
-      //   LOG_ERR(" * AS7331 Error %d getting status", error_i32);
-      //   break;
-      // }
-      // data_ready = status.ndata;
-
-      // Read gpio_ext_as7331_ready to determine if sensor is read
-      int ret = gpio_pin_get_dt(&gpio_ext_as7331_ready);
-      data_ready = (ret == 1);
-
-      if (!data_ready) {
-        k_usleep(100);
-
-        if ((k_uptime_get_32() - time) > 10 * 1000) {
-          LOG_ERR(" * AS7331 Timeout waiting for data ready status");
-          break;
-        }
-      }
-    } while (!data_ready);
-    LOG_DBG("AS7331 Data ready after %d ms", k_uptime_get_32() - time);
-
-    // Read all
-    struct {
-      uint16_t temp;
-      uint16_t uva;
-      uint16_t uvb;
-      uint16_t uvc;
-    } as7331_all;
-    error_i32 = as7331_read_all(&as7331_ctx, (uint16_t *)&as7331_all);
-    if (error_i32) {
-      LOG_ERR(" * AS7331 Error %d reading all values", error_i32);
-      break;
-    }
+  // ----------------- Record Schema -----------------------------------------------------------------------------------
+  output_send_schema();
 
-    sensor_values.as7331_temp = as7331_all.temp * 0.05f - 66.9f;
-    sensor_values.as7331_uva = as7331_all.uva;
-    sensor_values.as7331_uvb = as7331_all.uvb;
-    sensor_values.as7331_uvc = as7331_all.uvc;
+  // ----------------- Scheduler ---------------------------------------------------------------------------------------
+  // Every sensor is sampled with its own period on the thread of its I2C bus, the record is emitted with the latest
+  // value of every sensor. The periods follow the runtime configuration, see acq_update_periods()
+  for (size_t i = 0; i < ARRAY_SIZE(sensors); i++) {
+    acq_sensor_t *sensor = &sensors[i];
+    const sensor_driver_t *driver = &sensor_registry[i];
 
-    // Already start next measurement
-    error_i32 = as7331_start_measurement(&as7331_ctx);
-    if (error_i32) {
-      LOG_ERR(" * AS7331 Error %d starting one-shot measurement", error_i32);
-      break;
-    }
-    sync();
-
-    // ----------------- CSV Output ------------------------------------------------------------------------------------
-    gpio_pin_set_dt(&gpio_debug_1, 0);
-
-    sensor_values.timestamp = k_uptime_get_32();
-
-    // Print all elements in sensor_values as CSV formatted string
-    printf("%u,%u,%f,%f,%u,%u,%f,%f,%f,%f,%f,%f,%u,%u,%u,%f,%u,%u,%u\n", sensor_values.timestamp,
-           sensor_values.scd41_co2, sensor_values.scd41_temperature, sensor_values.scd41_humidity,
-           sensor_values.sgp41_voc, sensor_values.sgp41_nox, sensor_values.ilps28qsw_pressure,
-           sensor_values.ilps28qsw_temperature, sensor_values.bme688_temperature, sensor_values.bme688_pressure,
-           sensor_values.bme688_humidity, sensor_values.bme688_gas_resistance, sensor_values.bh1730_visible,
-           sensor_values.bh1730_ir, sensor_values.bh1730_lux, sensor_values.as7331_temp, sensor_values.as7331_uva,
-           sensor_values.as7331_uvb, sensor_values.as7331_uvc);
-
-    int32_t loop_duration = k_uptime_get_32() - loop_time;
-    loop_time = k_uptime_get_32();
-    LOG_DBG("Loop duration: %d ms", loop_duration);
-
-    // Sleep to get 5s intervals
-    if (loop_duration < SAMPLING_TIME) {
-      int32_t sleep_duration = SAMPLING_TIME - loop_duration;
-      LOG_DBG("Sleeping for %d ms", sleep_duration);
-      k_msleep(sleep_duration);
-    } else {
-      LOG_WRN("Loop duration too long: %d ms", loop_duration);
-    }
+    sensor->driver = driver;
+    sched_task_init(&sensor->task, driver->name, 0, driver->queue, acq_sample, sensor);
+    tasks[task_count++] = &sensor->task;
+
+    // Adaptive channels start at the sampling time
+    adapt_init(driver->adapt, driver->adapt_count, cfg_get(CFG_SAMPLING_TIME));
+  }
+  sched_task_init(&record_task, "Record", 0, SCHED_QUEUE_DEFAULT, record_output, NULL);
+  tasks[task_count++] = &record_task;
+  sched_task_init(&energy_task, "MAX77654", ENERGY_SAMPLE_PERIOD, SCHED_QUEUE_I2CA, energy_sample, NULL);
+  if (ENERGY_ENABLED) {
+    tasks[task_count++] = &energy_task;
   }
+  acq_update_periods();
 
-  // ----------------- Power off sensors -------------------------------------------------------------------------------
-  LOG_INF("===== Powering off sensors ======");
+  for (size_t i = 0; i < ARRAY_SIZE(sensors); i++) {
+    acq_sensor_t *sensor = &sensors[i];
+    bool recoverable = sensor->driver->power_on || sensor->driver->init || sensor->driver->configure;
 
-  // ----------------- SCD41 (CO2 Sensor) ------------------------------------------------------------------------------
-  LOG_INF(" - Stop periodic measurement of SCD41");
-  error_i16 = scd4x_stop_periodic_measurement();
-  if (error_i16 != NO_ERROR) {
-    LOG_ERR(" * Error %d stopping periodic measurement", error_i16);
-    k_msleep(1000);
-    return -1;
+    predict_init(&sensor->predict, sensor->task.name, sensor->conversion_ms);
+    energy_window_init(&sensor->energy, sensor->task.name);
+    health_init(&sensor->health, sensor->task.name, recoverable);
   }
-  LOG_INF(" - Power off SCD41");
-  poweroff_scd41();
 
-  // ----------------- SGP41 (VOC Sensor) ------------------------------------------------------------------------------
-  LOG_INF(" - Turn off heater of SGP41");
-  error_i16 = sgp41_turn_heater_off();
-  if (error_i16 != NO_ERROR) {
-    LOG_ERR(" * Error %d turning heater off", error_i16);
-    k_msleep(1000);
-    return -1;
+  // The meter keeps the previous sample on errors, the records then report no energy
+  if (energy_init() != NO_ERROR) {
+    LOG_WRN("Energy meter not available");
   }
-  LOG_INF(" - Power off SGP41");
-  poweroff_sgp41();
 
-  // ----------------- ILPS28QSW (Pressure Sensor) ---------------------------------------------------------------------
-  // No power off needed.
+  sched_init();
+  latency_init();
+  bench_start();
 
-  // ----------------- BME688 (Environmental Sensor) -------------------------------------------------------------------
-  // No power off needed.
+  // All sensors share the same epoch, the first record is emitted once every sensor had one period to sample
+  int64_t epoch = k_uptime_ticks();
+  for (size_t i = 0; i < task_count; i++) {
+    if (tasks[i] == &record_task) {
+      sched_task_start(tasks[i], epoch + k_ms_to_ticks_ceil64(record_task.period_ms));
+    } else {
+      sched_task_start(tasks[i], epoch);
+    }
+  }
+
+  // Runs forever, only the benchmark stops the acquisition
+  k_sem_take(&acq_abort_sem, K_FOREVER);
+
+  for (size_t i = 0; i < task_count; i++) {
+    sched_task_stop(tasks[i]);
+  }
+  bench_report(tasks, task_count);
 
-  // ----------------- BH1730FVC (Ambient Light Sensor) ----------------------------------------------------------------
-  LOG_INF(" - Power off BH1730FVC");
-  poweroff_bh1730();
+  // ----------------- Power off sensors -------------------------------------------------------------------------------
+  // Every supply is cut even if a sensor does not respond. This includes the parts that are only tested at boot, such
+  // as the MAX-M10S, in case the self-test left them powered
+  LOG_INF("===== Powering off sensors ======");
+  for (size_t i = 0; i < SENSOR_COUNT; i++) {
+    const sensor_driver_t *driver = &sensor_registry[i];
 
-  // ----------------- AS7331 (UV Sensor) ------------------------------------------------------------------------------
-  LOG_INF(" - Power off AS7331");
-  poweroff_as7331();
+    if (driver->power_off) {
+      LOG_INF(" - Power off %s", driver->name);
+      driver->power_off();
+    }
+  }
 
   return 0;
 }
\ No newline at end of file
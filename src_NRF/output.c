@@ -0,0 +1,521 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: output.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+
+#include <zephyr/drivers/uart.h>
+
+#include <zephyr/logging/log.h>
+
+#include "cfg.h"
+#include "config.h"
+#include "flog.h"
+#include "fmt.h"
+#include "latency.h"
+#include "output.h"
+#include "proto.h"
+#include "ring.h"
+#include "trace.h"
+#include "tscodec.h"
+#include "uart_tx.h"
+
+LOG_MODULE_REGISTER(output, LOG_LEVEL_INF);
+
+BUILD_ASSERT(IS_POWER_OF_TWO(OUTPUT_RING_SIZE), "OUTPUT_RING_SIZE must be a power of two");
+BUILD_ASSERT(OUTPUT_BATCH_SIZE <= OUTPUT_RING_SIZE, "OUTPUT_BATCH_SIZE must not exceed OUTPUT_RING_SIZE");
+BUILD_ASSERT(OUTPUT_TX_BUFFER_SIZE >= FMT_CSV_MAX_LINE, "OUTPUT_TX_BUFFER_SIZE must hold a CSV line");
+BUILD_ASSERT(OUTPUT_TX_BUFFER_SIZE >= FMT_CSV_HEADER_SIZE, "OUTPUT_TX_BUFFER_SIZE must hold the CSV header");
+BUILD_ASSERT(OUTPUT_REPLY_SIZE <= PROTO_MAX_PAYLOAD, "Command reply does not fit into one frame");
+#if LATENCY_ENABLED
+BUILD_ASSERT(LATENCY_PACKED_SIZE <= PROTO_MAX_PAYLOAD, "Latency summary does not fit into one frame");
+#endif
+
+static const struct device *const uart_dev = DEVICE_DT_GET_ONE(zephyr_cdc_acm_uart);
+
+static sensor_values_t output_buf[OUTPUT_RING_SIZE];
+static ring_t output_ring;
+
+K_SEM_DEFINE(output_sem, 0, 1);
+
+K_THREAD_STACK_DEFINE(output_stack, OUTPUT_STACK_SIZE);
+static struct k_thread output_thread_data;
+
+static void output_thread(void *p1, void *p2, void *p3);
+
+#if OUTPUT_FORMAT == OUTPUT_FORMAT_BINARY && OUTPUT_COMPRESS
+// Block of records collected for one frame
+static uint8_t output_block[PROTO_MAX_PAYLOAD];
+static tscodec_t output_enc;
+static proto_type_t output_block_type;
+#endif
+
+// Transmit buffers, records are formatted directly into them and handed to the driver without a copy
+K_MEM_SLAB_DEFINE_STATIC(output_tx_slab, OUTPUT_TX_BUFFER_SIZE, OUTPUT_TX_BUFFERS, 4);
+
+static bool output_stalled = false;
+static uint32_t output_stalls = 0;
+
+// Set by output_send_stats(), the frame is sent by the output thread to keep the sequence numbers in order
+static atomic_t output_stats_pending = ATOMIC_INIT(0);
+// Set by output_send_schema() and whenever a host opens the port
+static atomic_t output_schema_pending = ATOMIC_INIT(0);
+// Set by output_send_trace(), the dump is printed by the output thread so it does not delay the traced tasks
+static atomic_t output_trace_pending = ATOMIC_INIT(0);
+
+// Command line from the host, assembled in the UART interrupt and executed by the output thread
+static char output_rx_line[OUTPUT_COMMAND_SIZE];
+static size_t output_rx_len = 0;
+static bool output_rx_overflow = false;
+static char output_command[OUTPUT_COMMAND_SIZE];
+static atomic_t output_command_pending = ATOMIC_INIT(0);
+
+static void output_tx_done(const uint8_t *buf, size_t len, void *user_data) {
+  ARG_UNUSED(len);
+  ARG_UNUSED(user_data);
+
+  k_mem_slab_free(&output_tx_slab, (void *)buf);
+}
+
+/**
+ * @brief Gets a transmit buffer, waits at most OUTPUT_TX_TIMEOUT for the host to consume the previous ones.
+ *
+ * @return Buffer of OUTPUT_TX_BUFFER_SIZE bytes, NULL if the host stalls
+ */
+static uint8_t *output_tx_alloc(void) {
+  void *buf;
+
+  if (k_mem_slab_alloc(&output_tx_slab, &buf, K_MSEC(OUTPUT_TX_TIMEOUT)) != 0) {
+    if (!output_stalled) {
+      LOG_WRN("Host does not read, dropping output (%u bytes pending)", uart_tx_pending());
+    }
+    output_stalled = true;
+    output_stalls++;
+    return NULL;
+  }
+  output_stalled = false;
+  return buf;
+}
+
+static void output_tx_submit(uint8_t *buf, size_t len) {
+  if (uart_tx_submit(buf, len, output_tx_done, NULL) != 0) {
+    k_mem_slab_free(&output_tx_slab, buf);
+  }
+}
+
+/**
+ * @brief Sends the collected block of records as one frame.
+ *
+ */
+static void output_flush(void) {
+#if OUTPUT_FORMAT == OUTPUT_FORMAT_BINARY && OUTPUT_COMPRESS
+  uint8_t *frame;
+  size_t len;
+
+  if (output_enc.count == 0) {
+    return;
+  }
+  len = tscodec_finish(&output_enc);
+  frame = output_tx_alloc();
+  if (frame) {
+    len = proto_frame(output_block_type, output_block, len, frame);
+    output_tx_submit(frame, len);
+  }
+  tscodec_init(&output_enc, output_block, sizeof(output_block));
+#endif
+}
+
+/**
+ * @brief Emits a record in the configured OUTPUT_FORMAT.
+ *
+ * Compressed records are only collected, output_flush() sends them.
+ */
+static void output_emit(proto_type_t type, const sensor_values_t *record) {
+#if OUTPUT_FORMAT == OUTPUT_FORMAT_BINARY && OUTPUT_COMPRESS
+  proto_type_t block_type = type == PROTO_TYPE_BACKLOG ? PROTO_TYPE_BACKLOG_BLOCK : PROTO_TYPE_RECORD_BLOCK;
+
+  if (block_type != output_block_type) {
+    output_flush();
+    output_block_type = block_type;
+  }
+  if (tscodec_encode(&output_enc, record) == -ENOSPC) {
+    output_flush();
+    tscodec_encode(&output_enc, record);
+  }
+#elif OUTPUT_FORMAT == OUTPUT_FORMAT_BINARY
+  uint8_t payload[PROTO_RECORD_SIZE];
+  uint8_t *frame = output_tx_alloc();
+
+  if (frame) {
+    size_t len = proto_pack_record(record, payload);
+    len = proto_frame(type, payload, len, frame);
+    output_tx_submit(frame, len);
+  }
+#else
+  ARG_UNUSED(type);
+
+  uint8_t *line = output_tx_alloc();
+  int len;
+
+  if (!line) {
+    return;
+  }
+
+#if OUTPUT_CSV_FIXED_POINT
+  len = fmt_record_csv((char *)line, record);
+#else
+  len = fmt_record_printf((char *)line, OUTPUT_TX_BUFFER_SIZE, record);
+#endif
+  output_tx_submit(line, CLAMP(len, 0, OUTPUT_TX_BUFFER_SIZE - 1));
+#endif
+}
+
+static void output_emit_backlog(const sensor_values_t *record) { output_emit(PROTO_TYPE_BACKLOG, record); }
+
+/**
+ * @brief Sends the latency summary as PROTO_TYPE_STATS frame, in CSV mode the summary is only logged.
+ *
+ */
+static void output_emit_stats(void) {
+#if OUTPUT_FORMAT == OUTPUT_FORMAT_BINARY && LATENCY_ENABLED
+  static uint8_t payload[LATENCY_PACKED_SIZE];
+  uint8_t *frame = output_tx_alloc();
+
+  if (frame) {
+    size_t len = latency_pack(payload);
+    len = proto_frame(PROTO_TYPE_STATS, payload, len, frame);
+    output_tx_submit(frame, len);
+  }
+#endif
+}
+
+/**
+ * @brief Sends the record schema, a PROTO_TYPE_SCHEMA frame or the CSV header line.
+ *
+ * Pending compressed records are flushed first, the host applies the schema to the records that follow.
+ */
+static void output_emit_schema(void) {
+  uint8_t *frame;
+  size_t len;
+
+  output_flush();
+  frame = output_tx_alloc();
+  if (!frame) {
+    return;
+  }
+#if OUTPUT_FORMAT == OUTPUT_FORMAT_BINARY
+  static uint8_t payload[PROTO_SCHEMA_SIZE];
+
+  len = proto_pack_schema(payload, NULL);
+  len = proto_frame(PROTO_TYPE_SCHEMA, payload, len, frame);
+#else
+  len = fmt_header_csv((char *)frame);
+#endif
+  output_tx_submit(frame, len);
+}
+
+/**
+ * @brief Executes the command received from the host and sends the reply.
+ *
+ * The reply is a PROTO_TYPE_REPLY frame, in CSV mode every line is prefixed with '#' so CSV readers skip it.
+ */
+static void output_emit_reply(void) {
+  static char reply[OUTPUT_REPLY_SIZE];
+  uint8_t *frame;
+  size_t len;
+
+  LOG_INF("Command from host: %s", output_command);
+  cfg_command(output_command, reply, sizeof(reply));
+
+  output_flush();
+  frame = output_tx_alloc();
+  if (!frame) {
+    return;
+  }
+#if OUTPUT_FORMAT == OUTPUT_FORMAT_BINARY
+  len = proto_frame(PROTO_TYPE_REPLY, (const uint8_t *)reply, strlen(reply), frame);
+#else
+  len = 0;
+  for (const char *c = reply; *c != '\0' && len + 3 <= OUTPUT_TX_BUFFER_SIZE; c++) {
+    if (c == reply || c[-1] == '\n') {
+      frame[len++] = '#';
+      frame[len++] = ' ';
+    }
+    frame[len++] = *c;
+  }
+#endif
+  output_tx_submit(frame, len);
+}
+
+/**
+ * @brief Assembles the command lines received from the host, runs in the UART interrupt callback.
+ *
+ * A line arriving while the previous command is still executed and overlong lines are dropped.
+ */
+static void output_rx(const uint8_t *buf, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    char c = buf[i];
+
+    if (c != '\r' && c != '\n') {
+      if (output_rx_len < sizeof(output_rx_line) - 1) {
+        output_rx_line[output_rx_len++] = c;
+      } else {
+        output_rx_overflow = true;
+      }
+      continue;
+    }
+
+    if (output_rx_len > 0 && !output_rx_overflow && !atomic_get(&output_command_pending)) {
+      memcpy(output_command, output_rx_line, output_rx_len);
+      output_command[output_rx_len] = '\0';
+      atomic_set(&output_command_pending, 1);
+      k_sem_give(&output_sem);
+    }
+    output_rx_len = 0;
+    output_rx_overflow = false;
+  }
+}
+
+/**
+ * @brief Checks whether a host has opened the CDC ACM port.
+ *
+ */
+static bool output_host_connected(void) {
+  uint32_t dtr = 0;
+
+  if (uart_line_ctrl_get(uart_dev, UART_LINE_CTRL_DTR, &dtr) != 0) {
+    // Line state not available, assume the host is listening
+    return true;
+  }
+  return dtr != 0;
+}
+
+// The drain stops when the host disconnects or stops reading, the rest of the backlog stays in flash
+static bool output_drain_continue(void) { return !output_stalled && output_host_connected(); }
+
+/**
+ * @brief Drains the ring in batches of OUTPUT_BATCH_SIZE records.
+ *
+ * Runs at OUTPUT_PRIORITY below the acquisition, so a stalled host only fills the ring and never delays a sensor read.
+ * While no host is connected the records are appended to the flash log, which is streamed as soon as a host opens the
+ * port.
+ */
+static void output_thread(void *p1, void *p2, void *p3) {
+  ARG_UNUSED(p1);
+  ARG_UNUSED(p2);
+  ARG_UNUSED(p3);
+
+  sensor_values_t batch[OUTPUT_BATCH_SIZE];
+  size_t count;
+  bool connected, was_connected = false;
+
+  while (true) {
+    // Incomplete batches are flushed after OUTPUT_FLUSH_TIME
+    k_sem_take(&output_sem, K_MSEC(OUTPUT_FLUSH_TIME));
+
+    connected = output_host_connected();
+    if (connected && !was_connected) {
+      // A host that opens the port later has missed the schema sent at boot
+      atomic_set(&output_schema_pending, 1);
+    }
+    was_connected = connected;
+    if (connected && atomic_cas(&output_schema_pending, 1, 0)) {
+      output_emit_schema();
+    }
+#if FLOG_ENABLED
+    if (connected && !flog_empty()) {
+      // Stream the backlog before any new record to keep the output in order
+      uint32_t drained = flog_drain(output_emit_backlog, output_drain_continue);
+      output_flush();
+      LOG_INF("Drained %u records from sample log", drained);
+    }
+#endif
+
+    do {
+      // Free the ring slots before the potentially blocking output
+      count = 0;
+      while (count < OUTPUT_BATCH_SIZE && ring_get(&output_ring, &batch[count])) {
+        count++;
+      }
+      TRACE_BEGIN(OUTPUT, count);
+      timing_t start = latency_now();
+      for (size_t i = 0; i < count; i++) {
+#if FLOG_ENABLED
+        if (!connected) {
+          flog_append(&batch[i]);
+          continue;
+        }
+#endif
+        output_emit(PROTO_TYPE_RECORD, &batch[i]);
+      }
+      output_flush();
+      if (count) {
+        latency_end(LATENCY_OUTPUT, start);
+      }
+      TRACE_END(OUTPUT, count);
+    } while (count == OUTPUT_BATCH_SIZE);
+
+    if (atomic_cas(&output_stats_pending, 1, 0) && connected) {
+      output_emit_stats();
+    }
+    if (atomic_get(&output_command_pending)) {
+      output_emit_reply();
+      atomic_clear(&output_command_pending);
+    }
+    if (atomic_cas(&output_trace_pending, 1, 0)) {
+      trace_dump();
+    }
+  }
+}
+
+/**
+ * @brief Checks the output device and starts the output thread.
+ *
+ */
+int output_init(void) {
+  if (!device_is_ready(uart_dev)) {
+    LOG_ERR("CDC ACM device not ready");
+    return -ENODEV;
+  }
+  if (uart_tx_init(uart_dev) != 0) {
+    return -ENOTSUP;
+  }
+  uart_tx_set_rx(output_rx);
+
+#if FLOG_ENABLED
+  // Without the flash log the records are output regardless of the host
+  if (flog_init() != 0) {
+    LOG_WRN("Sample log not available, records are lost while no host is connected");
+  }
+#endif
+
+#if OUTPUT_FORMAT == OUTPUT_FORMAT_BINARY && OUTPUT_COMPRESS
+  tscodec_init(&output_enc, output_block, sizeof(output_block));
+#endif
+
+  ring_init(&output_ring, output_buf, OUTPUT_RING_SIZE, OUTPUT_RING_POLICY);
+
+  k_thread_create(&output_thread_data, output_stack, K_THREAD_STACK_SIZEOF(output_stack), output_thread, NULL, NULL,
+                  NULL, OUTPUT_PRIORITY, 0, K_NO_WAIT);
+  k_thread_name_set(&output_thread_data, "output");
+
+  return 0;
+}
+
+/**
+ * @brief Queues a record for output, never blocks.
+ *
+ * Must only be called from a single thread, the ring has one producer.
+ *
+ * @return true if the record was queued, false if it was dropped because the ring is full
+ */
+bool output_submit(const sensor_values_t *record) {
+  bool queued = ring_put(&output_ring, record);
+
+  if (ring_level(&output_ring) >= OUTPUT_BATCH_SIZE) {
+    k_sem_give(&output_sem);
+  }
+  return queued;
+}
+
+/**
+ * @brief Requests a PROTO_TYPE_STATS frame from the output thread.
+ *
+ */
+void output_send_stats(void) {
+  atomic_set(&output_stats_pending, 1);
+  k_sem_give(&output_sem);
+}
+
+/**
+ * @brief Requests the record schema from the output thread, see output_emit_schema().
+ *
+ */
+void output_send_schema(void) {
+  atomic_set(&output_schema_pending, 1);
+  k_sem_give(&output_sem);
+}
+
+/**
+ * @brief Requests a dump of the tracepoints on the console from the output thread, see trace_dump().
+ *
+ */
+void output_send_trace(void) {
+  atomic_set(&output_trace_pending, 1);
+  k_sem_give(&output_sem);
+}
+
+/**
+ * @brief Logs the ring statistics.
+ *
+ */
+void output_stats_log(void) {
+  const ring_stats_t *stats = &output_ring.stats;
+
+  LOG_INF("output: %u records, %u overruns, level %u, max level %u/%u", stats->written, stats->overruns,
+          ring_level(&output_ring), stats->max_level, OUTPUT_RING_SIZE);
+
+  const uart_tx_stats_t *tx = uart_tx_stats();
+
+  LOG_INF("tx: %u buffers, %u bytes, %u pending, %u stalls", tx->completed, tx->bytes, uart_tx_pending(),
+          output_stalls);
+#if FLOG_ENABLED
+  const flog_stats_t *log = flog_stats();
+
+  LOG_INF("sample log: %u appended, %u drained, %u overwritten, %u errors", log->appended, log->drained,
+          log->overwritten, log->errors);
+#endif
+}
+
+#if defined(CONFIG_SHELL)
+static int cmd_schema(const struct shell *sh, size_t argc, char **argv) {
+  ARG_UNUSED(argc);
+  ARG_UNUSED(argv);
+
+  static const char *const type_names[] = {"u16", "u32", "f32"};
+  static uint8_t payload[PROTO_SCHEMA_SIZE];
+  uint32_t layout;
+  size_t len = proto_pack_schema(payload, &layout);
+
+  shell_print(sh, "Layout %08x, %u channels, %u bytes", layout, RECORD_CHANNEL_COUNT, len);
+  shell_print(sh, "%-3s %-22s %-4s %-8s %s", "Id", "Column", "Type", "Decimals", "Unit");
+  for (size_t i = 0; i < RECORD_CHANNEL_COUNT; i++) {
+    const record_channel_t *ch = &record_channels[i];
+
+    shell_print(sh, "%-3u %-22s %-4s %-8u %s", i, ch->name, type_names[ch->type], ch->decimals, ch->unit);
+  }
+  output_send_schema();
+  return 0;
+}
+
+SHELL_CMD_REGISTER(schema, NULL, "Print the record schema and send it to the host", cmd_schema);
+#endif
@@ -1,11 +1,11 @@
 /*
  * ----------------------------------------------------------------------
  *
- * File: util.h
+ * File: output.h
  *
- * Last edited: 30.10.2025
+ * Last edited: 16.10.2026
  *
- * Copyright (c) 2025 ETH Zurich and University of Bologna
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
  *
  * Authors:
  * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
@@ -26,11 +26,19 @@
  * limitations under the License.
  */
 
-#ifndef UTIL_H
-#define UTIL_H
 
-#include <stdint.h>
+#ifndef OUTPUT_H
+#define OUTPUT_H
 
-void sync();
+#include <stdbool.h>
 
-#endif /* UTIL_H */
\ No newline at end of file
+#include "record.h"
+
+int output_init(void);
+bool output_submit(const sensor_values_t *record);
+void output_send_stats(void);
+void output_send_schema(void);
+void output_send_trace(void);
+void output_stats_log(void);
+
+#endif /* OUTPUT_H */
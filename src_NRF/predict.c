@@ -0,0 +1,157 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: predict.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdlib.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+
+#include <zephyr/logging/log.h>
+
+#include "config.h"
+#include "predict.h"
+
+LOG_MODULE_REGISTER(predict, LOG_LEVEL_INF);
+
+static predict_t *predict_models[PREDICT_MAX_MODELS];
+static size_t predict_count = 0;
+
+/**
+ * @brief Initializes a model and adds it to the statistics.
+ *
+ * @param model Model to initialize
+ * @param name Name used in the statistics
+ * @param expected_ms Nominal conversion time, 0 if unknown or for sensors converting continuously
+ */
+void predict_init(predict_t *model, const char *name, uint32_t expected_ms) {
+  model->name = name;
+  predict_reset(model, expected_ms);
+
+  __ASSERT(predict_count < PREDICT_MAX_MODELS, "Increase PREDICT_MAX_MODELS");
+  if (predict_count < PREDICT_MAX_MODELS) {
+    predict_models[predict_count++] = model;
+  }
+}
+
+/**
+ * @brief Forgets the learned ready time, e.g. after the conversion time of the sensor was changed.
+ *
+ * The first check happens at the nominal conversion time until the first sample was observed.
+ */
+void predict_reset(predict_t *model, uint32_t expected_ms) {
+  model->offset_us = expected_ms * 1000;
+  model->dev_us = 0;
+  model->learned = false;
+  model->samples = 0;
+  model->checks = 0;
+  model->error_abs_sum_us = 0;
+  model->error_max_us = 0;
+}
+
+/**
+ * @brief Returns the delay after the start of the conversion until the first ready check.
+ *
+ */
+uint32_t predict_wake_ms(const predict_t *model) {
+  int32_t wake_us = model->offset_us;
+
+  if (model->learned) {
+    wake_us -= PREDICT_GUARD * model->dev_us + PREDICT_GUARD_MIN_US;
+  }
+  return MAX(wake_us, 0) / 1000;
+}
+
+/**
+ * @brief Adds an observed ready time to the model.
+ *
+ * The sensor became ready between the last check that found it busy and the first check that found it ready, the
+ * middle of this interval is taken as ready time. When the first check already finds the sensor ready, the true time
+ * is unknown but earlier, and the estimate moves towards an earlier wake-up.
+ *
+ * @param model Model of the sensor
+ * @param busy_us Time of the last check that found the sensor busy, relative to the start of the conversion
+ * @param ready_us Time of the check that found the sensor ready
+ * @param checks Ready checks of this sample, including the successful one
+ */
+void predict_update(predict_t *model, uint32_t busy_us, uint32_t ready_us, uint32_t checks) {
+  int32_t observed = checks > 1 ? (int32_t)(busy_us + (ready_us - busy_us) / 2) : (int32_t)ready_us;
+  int32_t error = observed - model->offset_us;
+
+  if (!model->learned) {
+    // The first observation is only known to the resolution of the checks
+    model->offset_us = observed;
+    model->dev_us = checks > 1 ? (int32_t)(ready_us - busy_us) / 2 : abs(error);
+    model->learned = true;
+  } else {
+    model->offset_us += error / 8;
+    model->dev_us += (abs(error) - model->dev_us) / 4;
+
+    model->error_abs_sum_us += abs(error);
+    model->error_max_us = MAX(model->error_max_us, (uint32_t)abs(error));
+  }
+
+  model->samples++;
+  model->checks += checks;
+}
+
+/**
+ * @brief Logs the prediction error and the ready checks per sample of all models.
+ *
+ */
+void predict_log(void) {
+  for (size_t i = 0; i < predict_count; i++) {
+    const predict_t *model = predict_models[i];
+    uint32_t error_avg_us = model->samples > 1 ? (uint32_t)(model->error_abs_sum_us / (model->samples - 1)) : 0;
+
+    LOG_INF(" - %-10s ready after %6d +- %5d us : error avg/max %u/%u us, %u checks in %u samples", model->name,
+            model->offset_us, model->dev_us, error_avg_us, model->error_max_us, model->checks, model->samples);
+  }
+}
+
+#if defined(CONFIG_SHELL)
+static int cmd_wake(const struct shell *sh, size_t argc, char **argv) {
+  ARG_UNUSED(argc);
+  ARG_UNUSED(argv);
+
+  shell_print(sh, "%-10s %10s %8s %8s %10s %10s %8s", "Sensor", "Ready [us]", "Dev", "Wake", "Err avg", "Err max",
+              "Checks");
+  for (size_t i = 0; i < predict_count; i++) {
+    const predict_t *model = predict_models[i];
+    uint32_t error_avg_us = model->samples > 1 ? (uint32_t)(model->error_abs_sum_us / (model->samples - 1)) : 0;
+    uint32_t checks_x100 = model->samples ? model->checks * 100 / model->samples : 0;
+
+    shell_print(sh, "%-10s %10d %8d %8u %10u %10u %4u.%02u", model->name, model->offset_us, model->dev_us,
+                predict_wake_ms(model) * 1000, error_avg_us, model->error_max_us, checks_x100 / 100,
+                checks_x100 % 100);
+  }
+  return 0;
+}
+
+SHELL_CMD_REGISTER(wake, NULL, "Print the learned ready times and the ready checks per sample", cmd_wake);
+#endif
@@ -0,0 +1,67 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: predict.h
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef PREDICT_H
+#define PREDICT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Ready time prediction
+ *
+ * Learns when a sensor has data ready after its conversion was started, so the acquisition sleeps until shortly
+ * before that time and checks the sensor once or twice instead of polling it throughout the conversion.
+ *
+ * The expected ready time and its mean deviation are smoothed estimates of the observed ready times, like the
+ * round-trip time estimator of TCP. The first check happens PREDICT_GUARD mean deviations before the expected time.
+ * Sensors converting continuously (e.g. the SCD41 in periodic mode) have no conversion to start, for them the model
+ * learns the phase of their data relative to the period of the task.
+ */
+
+typedef struct {
+  const char *name;
+  int32_t offset_us; // Expected ready time after the start of the conversion
+  int32_t dev_us;    // Mean deviation of the ready time
+  bool learned;
+
+  // Statistics since the last reset
+  uint32_t samples;
+  uint32_t checks;          // Ready checks, ideally one per sample
+  uint64_t error_abs_sum_us; // Sum of the absolute prediction errors
+  uint32_t error_max_us;
+} predict_t;
+
+void predict_init(predict_t *model, const char *name, uint32_t expected_ms);
+void predict_reset(predict_t *model, uint32_t expected_ms);
+uint32_t predict_wake_ms(const predict_t *model);
+void predict_update(predict_t *model, uint32_t busy_us, uint32_t ready_us, uint32_t checks);
+void predict_log(void);
+
+#endif /* PREDICT_H */
@@ -0,0 +1,212 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: proto.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/crc.h>
+
+#include "proto.h"
+
+// Commit of the firmware build, set by CMakeLists.txt
+#ifndef FIRMWARE_HASH
+#define FIRMWARE_HASH 0
+#endif
+
+BUILD_ASSERT(PROTO_SCHEMA_SIZE <= PROTO_MAX_PAYLOAD, "Record schema does not fit into one frame");
+BUILD_ASSERT(RECORD_CHANNEL_COUNT <= UINT8_MAX, "Channel ids of the schema are 8 bit");
+
+static uint16_t proto_seq = 0;
+
+static uint8_t *put_u16(uint8_t *buf, uint16_t value) {
+  sys_put_le16(value, buf);
+  return buf + 2;
+}
+
+static uint8_t *put_u32(uint8_t *buf, uint32_t value) {
+  sys_put_le32(value, buf);
+  return buf + 4;
+}
+
+static const uint8_t *get_u16(const uint8_t *buf, uint16_t *value) {
+  *value = sys_get_le16(buf);
+  return buf + 2;
+}
+
+static const uint8_t *get_u32(const uint8_t *buf, uint32_t *value) {
+  *value = sys_get_le32(buf);
+  return buf + 4;
+}
+
+static const uint8_t *get_f32(const uint8_t *buf, float *value) {
+  uint32_t raw = sys_get_le32(buf);
+
+  memcpy(value, &raw, sizeof(*value));
+  return buf + 4;
+}
+
+static uint8_t *put_f32(uint8_t *buf, float value) {
+  uint32_t raw;
+
+  memcpy(&raw, &value, sizeof(raw));
+  return put_u32(buf, raw);
+}
+
+// Every channel of the record in the order of RECORD_CHANNELS, see channels.h
+#define PROTO_PUT(field, type, column, unit, decimals) p = put_##type(p, values->field);
+#define PROTO_GET(field, type, column, unit, decimals) p = get_##type(p, &values->field);
+
+/**
+ * @brief Packs a record into the little-endian wire format.
+ *
+ * @param values Record to pack
+ * @param buf Output buffer of at least PROTO_RECORD_SIZE bytes
+ * @return Number of bytes written
+ */
+size_t proto_pack_record(const sensor_values_t *values, uint8_t *buf) {
+  uint8_t *p = buf;
+
+  RECORD_CHANNELS(PROTO_PUT)
+
+  return p - buf;
+}
+
+/**
+ * @brief Unpacks a record from the little-endian wire format.
+ *
+ * @param buf Input buffer of PROTO_RECORD_SIZE bytes
+ * @param values Unpacked record
+ * @return Number of bytes read
+ */
+size_t proto_unpack_record(const uint8_t *buf, sensor_values_t *values) {
+  const uint8_t *p = buf;
+
+  RECORD_CHANNELS(PROTO_GET)
+
+  return p - buf;
+}
+
+/**
+ * @brief Packs the layout of the records, see PROTO_TYPE_SCHEMA.
+ *
+ * @param buf Output buffer of at least PROTO_SCHEMA_SIZE bytes
+ * @param layout Returns the layout hash, may be NULL
+ * @return Number of bytes written
+ */
+size_t proto_pack_schema(uint8_t *buf, uint32_t *layout) {
+  uint8_t *p = buf + PROTO_SCHEMA_HEADER_SIZE;
+  uint32_t hash;
+
+  for (size_t i = 0; i < RECORD_CHANNEL_COUNT; i++) {
+    const record_channel_t *ch = &record_channels[i];
+    size_t name_len = strlen(ch->name) + 1;
+    size_t unit_len = strlen(ch->unit) + 1;
+
+    *p++ = i;
+    *p++ = (ch->type << 4) | (ch->decimals & 0x0F);
+    memcpy(p, ch->name, name_len);
+    p += name_len;
+    memcpy(p, ch->unit, unit_len);
+    p += unit_len;
+  }
+
+  hash = crc32_ieee(buf + PROTO_SCHEMA_HEADER_SIZE, p - buf - PROTO_SCHEMA_HEADER_SIZE);
+  put_u32(buf, FIRMWARE_HASH);
+  put_u32(buf + 4, hash);
+  buf[8] = RECORD_CHANNEL_COUNT;
+  if (layout) {
+    *layout = hash;
+  }
+  return p - buf;
+}
+
+/**
+ * @brief Encodes a buffer with Consistent Overhead Byte Stuffing.
+ *
+ * @param src Data to encode
+ * @param len Length of the data
+ * @param dst Output buffer of at least len + len / 254 + 1 bytes
+ * @return Number of bytes written, the output contains no 0x00
+ */
+size_t cobs_encode(const uint8_t *src, size_t len, uint8_t *dst) {
+  size_t code_idx = 0;
+  size_t out = 1;
+  uint8_t code = 1;
+
+  for (size_t i = 0; i < len; i++) {
+    if (src[i] != 0) {
+      dst[out++] = src[i];
+      code++;
+    }
+    if (src[i] == 0 || code == 0xFF) {
+      dst[code_idx] = code;
+      code_idx = out++;
+      code = 1;
+    }
+  }
+  dst[code_idx] = code;
+
+  return out;
+}
+
+/**
+ * @brief Builds a complete, delimited frame around a payload.
+ *
+ * @param type Frame type
+ * @param payload Payload of at most PROTO_MAX_PAYLOAD bytes
+ * @param len Length of the payload
+ * @param out Output buffer of at least PROTO_MAX_ENCODED bytes
+ * @return Number of bytes to transmit, 0 if the payload is too large
+ */
+size_t proto_frame(proto_type_t type, const uint8_t *payload, size_t len, uint8_t *out) {
+  uint8_t frame[PROTO_MAX_FRAME];
+  size_t n = 0;
+
+  if (len > PROTO_MAX_PAYLOAD) {
+    return 0;
+  }
+
+  frame[n++] = PROTO_VERSION;
+  frame[n++] = type;
+  sys_put_le16(proto_seq++, &frame[n]);
+  n += 2;
+  memcpy(&frame[n], payload, len);
+  n += len;
+  sys_put_le16(crc16_itu_t(0xFFFF, frame, n), &frame[n]);
+  n += 2;
+
+  // The leading delimiter terminates any text that was written to the port before the frame
+  size_t encoded = 0;
+  out[encoded++] = 0x00;
+  encoded += cobs_encode(frame, n, &out[encoded]);
+  out[encoded++] = 0x00;
+
+  return encoded;
+}
@@ -0,0 +1,100 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: proto.h
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef PROTO_H
+#define PROTO_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "record.h"
+
+/*
+ * Binary output protocol
+ *
+ * Every frame is COBS encoded and enclosed in 0x00 delimiters, so the host can resynchronize on any delimiter and
+ * text (e.g. log messages) on the same port is discarded by the CRC check. All values are little-endian.
+ *
+ *   u8  version   PROTO_VERSION
+ *   u8  type      proto_type_t
+ *   u16 seq       Incremented for every frame, gaps indicate lost frames
+ *   ... payload
+ *   u16 crc       CRC-16/CCITT-FALSE over all preceding bytes
+ *
+ * The payload of PROTO_TYPE_RECORD and PROTO_TYPE_BACKLOG is sensor_values_t packed in declaration order without
+ * padding, floats are transmitted as IEEE 754 single precision. The fields depend on the enabled sensors and are
+ * described by the PROTO_TYPE_SCHEMA frame, so the host builds its parser from the device it is connected to. The block
+ * types carry several records compressed with tscodec, see tscodec.h.
+ */
+
+#define PROTO_VERSION 2 // 2: MAX77654 supply and energy fields
+
+#define PROTO_HEADER_SIZE 4
+#define PROTO_CRC_SIZE 2
+#define PROTO_FIELD_SIZE(field, type, column, unit, decimals) +RECORD_SIZE_##type
+#define PROTO_RECORD_SIZE (0 RECORD_CHANNELS(PROTO_FIELD_SIZE)) // 72 with all sensors enabled
+
+/*
+ * Payload of PROTO_TYPE_SCHEMA, sent on connect, every OUTPUT_SCHEMA_INTERVAL records and with the `schema` command:
+ *
+ *   u32 firmware  FIRMWARE_HASH, commit of the firmware build
+ *   u32 layout    CRC-32 of the channel descriptors, equal layouts decode with the same parser
+ *   u8  count     Channels, each described by
+ *     u8  id        Index of the channel in the record
+ *     u8  format    record_type_t in the upper, decimals of the fixed-point output in the lower nibble
+ *     str column    Null-terminated CSV column
+ *     str unit      Null-terminated unit
+ */
+#define PROTO_SCHEMA_HEADER_SIZE 9
+#define PROTO_SCHEMA_CHANNEL_SIZE(field, type, column, unit, decimals) +2 + sizeof(column) + sizeof(unit)
+#define PROTO_SCHEMA_SIZE (PROTO_SCHEMA_HEADER_SIZE RECORD_CHANNELS(PROTO_SCHEMA_CHANNEL_SIZE))
+
+#define PROTO_MAX_PAYLOAD 512
+#define PROTO_MAX_FRAME (PROTO_HEADER_SIZE + PROTO_MAX_PAYLOAD + PROTO_CRC_SIZE)
+// COBS adds one byte every 254 bytes plus the leading code byte, the frame is enclosed in two delimiters
+#define PROTO_MAX_ENCODED (PROTO_MAX_FRAME + PROTO_MAX_FRAME / 254 + 1 + 2)
+
+typedef enum {
+  PROTO_TYPE_RECORD = 0x01,        // Live record
+  PROTO_TYPE_BACKLOG = 0x02,       // Record from the flash log, recorded while no host was connected
+  PROTO_TYPE_RECORD_BLOCK = 0x03,  // tscodec block of live records
+  PROTO_TYPE_BACKLOG_BLOCK = 0x04, // tscodec block of records from the flash log
+  PROTO_TYPE_STATS = 0x05,         // Latency summary of the acquisition stages, see latency_pack()
+  PROTO_TYPE_SCHEMA = 0x06,        // Layout of the records, see proto_pack_schema()
+  PROTO_TYPE_REPLY = 0x07,         // Text reply to a command received on the port, see cfg_command()
+} proto_type_t;
+
+size_t proto_pack_record(const sensor_values_t *values, uint8_t *buf);
+size_t proto_unpack_record(const uint8_t *buf, sensor_values_t *values);
+size_t proto_pack_schema(uint8_t *buf, uint32_t *layout);
+size_t proto_frame(proto_type_t type, const uint8_t *payload, size_t len, uint8_t *out);
+
+size_t cobs_encode(const uint8_t *src, size_t len, uint8_t *dst);
+
+#endif /* PROTO_H */
@@ -0,0 +1,72 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: record.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#include <math.h>
+#include <string.h>
+
+#include "record.h"
+
+#define RECORD_CHANNEL(field, type, column, unit, decimals)                                                            \
+  {column, unit, offsetof(sensor_values_t, field), RECORD_TYPE_##type, decimals},
+
+const record_channel_t record_channels[RECORD_CHANNEL_COUNT] = {RECORD_CHANNELS(RECORD_CHANNEL)};
+
+/**
+ * @brief Marks the channels in a byte range of the record as missing, see RECORD_MISSING_*.
+ *
+ * @param record Record to modify
+ * @param offset First byte of the range, as of a sensor_driver_t
+ * @param size Length of the range
+ */
+void record_set_missing(sensor_values_t *record, size_t offset, size_t size) {
+  static const uint16_t missing_u16 = RECORD_MISSING_U16;
+  static const uint32_t missing_u32 = RECORD_MISSING_U32;
+  static const float missing_f32 = NAN;
+
+  for (size_t i = 0; i < RECORD_CHANNEL_COUNT; i++) {
+    const record_channel_t *ch = &record_channels[i];
+    uint8_t *field = (uint8_t *)record + ch->offset;
+
+    if (ch->offset < offset || ch->offset >= offset + size) {
+      continue;
+    }
+    switch (ch->type) {
+    case RECORD_U16:
+      memcpy(field, &missing_u16, sizeof(missing_u16));
+      break;
+    case RECORD_U32:
+      memcpy(field, &missing_u32, sizeof(missing_u32));
+      break;
+    case RECORD_F32:
+      memcpy(field, &missing_f32, sizeof(missing_f32));
+      break;
+    }
+  }
+}
@@ -0,0 +1,88 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: record.h
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef RECORD_H
+#define RECORD_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "channels.h"
+
+// Fields of a sensor that failed its last conversion, floats are NAN
+#define RECORD_MISSING_U16 UINT16_MAX
+#define RECORD_MISSING_U32 UINT32_MAX
+
+// C type, size and record_type_t of the channel types in RECORD_CHANNELS
+#define RECORD_CTYPE_u16 uint16_t
+#define RECORD_CTYPE_u32 uint32_t
+#define RECORD_CTYPE_f32 float
+#define RECORD_SIZE_u16 2
+#define RECORD_SIZE_u32 4
+#define RECORD_SIZE_f32 4
+#define RECORD_TYPE_u16 RECORD_U16
+#define RECORD_TYPE_u32 RECORD_U32
+#define RECORD_TYPE_f32 RECORD_F32
+
+#define RECORD_FIELD(field, type, column, unit, decimals) RECORD_CTYPE_##type field;
+typedef struct sensor_values {
+  RECORD_CHANNELS(RECORD_FIELD)
+} __attribute__((aligned(4))) sensor_values_t;
+#undef RECORD_FIELD
+
+/*
+ * Channel schema
+ *
+ * Describes every field of sensor_values_t in declaration order, the CSV formatters and the missing markers of a
+ * failed sensor are derived from it. Generated from RECORD_CHANNELS, see channels.h.
+ */
+
+#define RECORD_CHANNEL_ID(field, type, column, unit, decimals) RECORD_CHANNEL_##field,
+typedef enum { RECORD_CHANNELS(RECORD_CHANNEL_ID) RECORD_CHANNEL_COUNT } record_channel_id_t;
+#undef RECORD_CHANNEL_ID
+
+typedef enum {
+  RECORD_U16,
+  RECORD_U32,
+  RECORD_F32,
+} record_type_t;
+
+typedef struct {
+  const char *name; // CSV column
+  const char *unit; // See channels.h
+  size_t offset;    // In sensor_values_t
+  record_type_t type;
+  uint8_t decimals; // Decimals of a float in the fixed-point CSV output, the resolution of the sensor
+} record_channel_t;
+
+extern const record_channel_t record_channels[RECORD_CHANNEL_COUNT];
+
+void record_set_missing(sensor_values_t *record, size_t offset, size_t size);
+
+#endif /* RECORD_H */
@@ -0,0 +1,108 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: ring.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/util.h>
+
+#include "ring.h"
+
+/**
+ * @brief Initializes an empty ring.
+ *
+ * @param ring Ring to initialize
+ * @param buf Storage for the records
+ * @param size Number of records in buf, must be a power of two
+ * @param policy Behaviour when the ring is full
+ */
+void ring_init(ring_t *ring, sensor_values_t *buf, uint32_t size, ring_policy_t policy) {
+  __ASSERT(IS_POWER_OF_TWO(size), "Ring size must be a power of two");
+
+  ring->buf = buf;
+  ring->size = size;
+  ring->policy = policy;
+  atomic_set(&ring->head, 0);
+  atomic_set(&ring->tail, 0);
+  ring->stats = (ring_stats_t){0};
+}
+
+/**
+ * @brief Appends a record, must only be called from the producer.
+ *
+ * @return true if the record was stored, false if it was dropped
+ */
+bool ring_put(ring_t *ring, const sensor_values_t *record) {
+  uint32_t head = atomic_get(&ring->head);
+  uint32_t tail = atomic_get(&ring->tail);
+
+  if (head - tail >= ring->size) {
+    ring->stats.overruns++;
+    if (ring->policy == RING_POLICY_DROP) {
+      return false;
+    }
+    // Release the oldest record. If the consumer claimed it first, the slot is free anyway.
+    atomic_cas(&ring->tail, tail, tail + 1);
+  }
+
+  ring->buf[head & (ring->size - 1)] = *record;
+  // Publish the record only after it is completely written
+  atomic_set(&ring->head, head + 1);
+
+  ring->stats.written++;
+  ring->stats.max_level = MAX(ring->stats.max_level, head + 1 - atomic_get(&ring->tail));
+  return true;
+}
+
+/**
+ * @brief Removes the oldest record, must only be called from the consumer.
+ *
+ * @return true if a record was copied, false if the ring is empty
+ */
+bool ring_get(ring_t *ring, sensor_values_t *record) {
+  while (true) {
+    uint32_t tail = atomic_get(&ring->tail);
+
+    if (tail == (uint32_t)atomic_get(&ring->head)) {
+      return false;
+    }
+
+    *record = ring->buf[tail & (ring->size - 1)];
+    // If the producer advanced tail while copying, the slot may have been overwritten
+    if (atomic_cas(&ring->tail, tail, tail + 1)) {
+      return true;
+    }
+  }
+}
+
+/**
+ * @brief Returns the number of records currently in the ring.
+ *
+ */
+uint32_t ring_level(ring_t *ring) {
+  return (uint32_t)atomic_get(&ring->head) - (uint32_t)atomic_get(&ring->tail);
+}
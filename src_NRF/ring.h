@@ -0,0 +1,74 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: ring.h
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef RING_H
+#define RING_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <zephyr/sys/atomic.h>
+
+#include "record.h"
+
+/*
+ * Lock-free single-producer/single-consumer ring of records
+ *
+ * head and tail are free-running counters, the slot of an index is index & (size - 1). The producer only writes head,
+ * the consumer only writes tail. With RING_POLICY_OVERWRITE the producer also advances tail when the ring is full, so
+ * the consumer claims a record by a compare-and-swap on tail after copying it and retries if the record was overwritten
+ * in the meantime.
+ */
+
+typedef enum {
+  RING_POLICY_DROP,      // Discard the new record when the ring is full
+  RING_POLICY_OVERWRITE, // Discard the oldest record when the ring is full
+} ring_policy_t;
+
+typedef struct {
+  uint32_t written;   // Records accepted by ring_put
+  uint32_t overruns;  // Records lost because the ring was full
+  uint32_t max_level; // Highest fill level seen by the producer
+} ring_stats_t;
+
+typedef struct {
+  sensor_values_t *buf;
+  uint32_t size;
+  ring_policy_t policy;
+  atomic_t head;
+  atomic_t tail;
+  ring_stats_t stats;
+} ring_t;
+
+void ring_init(ring_t *ring, sensor_values_t *buf, uint32_t size, ring_policy_t policy);
+bool ring_put(ring_t *ring, const sensor_values_t *record);
+bool ring_get(ring_t *ring, sensor_values_t *record);
+uint32_t ring_level(ring_t *ring);
+
+#endif /* RING_H */
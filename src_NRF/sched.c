@@ -0,0 +1,207 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: sched.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+
+#include <zephyr/logging/log.h>
+
+#include "config.h"
+#include "sched.h"
+
+LOG_MODULE_REGISTER(sched, LOG_LEVEL_INF);
+
+K_THREAD_STACK_ARRAY_DEFINE(sched_stacks, SCHED_QUEUE_COUNT, SCHED_STACK_SIZE);
+static struct k_work_q sched_wq[SCHED_QUEUE_COUNT];
+
+static const char *const sched_wq_names[SCHED_QUEUE_COUNT] = {
+    [SCHED_QUEUE_DEFAULT] = "sched",
+    [SCHED_QUEUE_I2CA] = "acq_i2ca",
+    [SCHED_QUEUE_I2CB] = "acq_i2cb",
+};
+
+static void sched_stats_update(sched_stats_t *stats, int64_t late_ticks) {
+  int32_t jitter_us = (int32_t)k_ticks_to_us_near64(late_ticks);
+
+  if (stats->runs == 0 || jitter_us < stats->jitter_min_us) {
+    stats->jitter_min_us = jitter_us;
+  }
+  if (stats->runs == 0 || jitter_us > stats->jitter_max_us) {
+    stats->jitter_max_us = jitter_us;
+  }
+  stats->jitter_sum_us += jitter_us;
+  stats->runs++;
+}
+
+static void sched_work_handler(struct k_work *work) {
+  struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+  sched_task_t *task = CONTAINER_OF(dwork, sched_task_t, work);
+
+  // Only the first run of a period is accounted, retries are expected to be late
+  if (task->retry == 0) {
+    sched_stats_update(&task->stats, k_uptime_ticks() - task->deadline);
+  }
+  task->retry = 0;
+  atomic_clear(&task->waiting);
+  task->stats.wakeups++;
+
+  task->fn(task);
+
+  int64_t period = k_ms_to_ticks_ceil64(task->period_ms);
+  int64_t next = task->deadline + period;
+
+  // Honour a retry only if it happens before the next period is released
+  if (task->retry != 0 && task->retry < next) {
+    atomic_set(&task->waiting, 1);
+    k_work_schedule_for_queue(task->queue, dwork, K_TIMEOUT_ABS_TICKS(task->retry));
+    return;
+  }
+  task->retry = 0;
+
+  // The next deadline is derived from the previous one and not from the current time, so the execution time of
+  // the task does not accumulate as drift. Periods that already passed are skipped.
+  int64_t now = k_uptime_ticks();
+  if (next <= now) {
+    int64_t missed = (now - next) / period + 1;
+    next += missed * period;
+    task->stats.overruns += (uint32_t)missed;
+  }
+  task->deadline = next;
+
+  k_work_schedule_for_queue(task->queue, dwork, K_TIMEOUT_ABS_TICKS(next));
+}
+
+/**
+ * @brief Starts the work queues executing the scheduled tasks.
+ *
+ */
+void sched_init(void) {
+  for (size_t i = 0; i < SCHED_QUEUE_COUNT; i++) {
+    struct k_work_queue_config cfg = {
+        .name = sched_wq_names[i],
+        .no_yield = false,
+    };
+
+    k_work_queue_start(&sched_wq[i], sched_stacks[i], K_THREAD_STACK_SIZEOF(sched_stacks[i]), SCHED_PRIORITY, &cfg);
+  }
+}
+
+/**
+ * @brief Initializes a periodic task.
+ *
+ * @param task Task to initialize
+ * @param name Name used in the statistics
+ * @param period_ms Period between two absolute deadlines
+ * @param queue Work queue executing the task, tasks on the same queue never run concurrently
+ * @param fn Function executed once per period
+ * @param user_data Opaque pointer available to fn
+ */
+void sched_task_init(sched_task_t *task, const char *name, uint32_t period_ms, sched_queue_t queue, sched_fn_t fn,
+                     void *user_data) {
+  task->name = name;
+  task->period_ms = MAX(period_ms, 1);
+  task->queue = &sched_wq[queue];
+  task->fn = fn;
+  task->user_data = user_data;
+  task->deadline = 0;
+  task->retry = 0;
+  atomic_clear(&task->waiting);
+  sched_stats_reset(task);
+
+  k_work_init_delayable(&task->work, sched_work_handler);
+}
+
+/**
+ * @brief Releases the first period of a task at an absolute time.
+ *
+ * @param task Task to start
+ * @param epoch Absolute time of the first deadline in ticks, use the same epoch for tasks that should be aligned
+ */
+void sched_task_start(sched_task_t *task, int64_t epoch) {
+  task->deadline = epoch;
+  task->retry = 0;
+  k_work_schedule_for_queue(task->queue, &task->work, K_TIMEOUT_ABS_TICKS(epoch));
+}
+
+/**
+ * @brief Cancels a task and waits until a running instance has finished.
+ *
+ */
+void sched_task_stop(sched_task_t *task) {
+  struct k_work_sync sync;
+
+  k_work_cancel_delayable_sync(&task->work, &sync);
+}
+
+/**
+ * @brief Changes the period of a task, the deadline already scheduled is kept.
+ *
+ */
+void sched_task_set_period(sched_task_t *task, uint32_t period_ms) { task->period_ms = MAX(period_ms, 1); }
+
+/**
+ * @brief Requests another run of the task within the current period.
+ *
+ * Must only be called from the task function. The retry is dropped if it would happen after the next deadline.
+ *
+ * @param task Task to run again
+ * @param delay_ms Delay relative to now
+ */
+void sched_task_defer(sched_task_t *task, uint32_t delay_ms) {
+  task->retry = MAX(k_uptime_ticks() + k_ms_to_ticks_ceil64(delay_ms), 1);
+}
+
+/**
+ * @brief Runs a retry requested with sched_task_defer() right away, e.g. from a data-ready interrupt.
+ *
+ * Safe to call from an ISR. Does nothing while the task waits for its next period, so a late event never releases a
+ * period early.
+ */
+void sched_task_wake(sched_task_t *task) {
+  if (atomic_get(&task->waiting)) {
+    k_work_reschedule_for_queue(task->queue, &task->work, K_NO_WAIT);
+  }
+}
+
+/**
+ * @brief Returns the absolute deadline of the current period in ms since boot.
+ *
+ */
+uint32_t sched_task_deadline_ms(const sched_task_t *task) { return (uint32_t)k_ticks_to_ms_floor64(task->deadline); }
+
+void sched_stats_reset(sched_task_t *task) { memset(&task->stats, 0, sizeof(task->stats)); }
+
+void sched_stats_log(const sched_task_t *task) {
+  const sched_stats_t *stats = &task->stats;
+  int32_t jitter_avg_us = stats->runs ? (int32_t)(stats->jitter_sum_us / stats->runs) : 0;
+
+  LOG_INF(" - %-10s %6u ms : runs %u, overruns %u, jitter min/avg/max %d/%d/%d us", task->name, task->period_ms,
+          stats->runs, stats->overruns, stats->jitter_min_us, jitter_avg_us, stats->jitter_max_us);
+}
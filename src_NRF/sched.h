@@ -0,0 +1,98 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: sched.h
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SCHED_H
+#define SCHED_H
+
+#include <stdint.h>
+
+#include <zephyr/kernel.h>
+
+typedef struct sched_task sched_task_t;
+
+/**
+ * @brief Work queues executing the tasks.
+ *
+ * Every I2C controller has its own acquisition thread, so both buses transfer concurrently and a slow sensor on one
+ * bus does not delay the sensors on the other one.
+ */
+typedef enum {
+  SCHED_QUEUE_DEFAULT, // Tasks not bound to a bus, e.g. the record output
+  SCHED_QUEUE_I2CA,    // ISM330DHCX, LIS2DUXS12, MAX77654
+  SCHED_QUEUE_I2CB,    // SCD41, SGP41, ILPS28QSW, BH1730FVC, AS7331
+  SCHED_QUEUE_COUNT,
+} sched_queue_t;
+
+typedef void (*sched_fn_t)(sched_task_t *task);
+
+/**
+ * @brief Release jitter statistics of a task.
+ *
+ * Jitter is the delay between the absolute deadline of a period and the moment the task actually started executing.
+ */
+typedef struct {
+  uint32_t runs;
+  uint32_t wakeups;  // Executions of the task function, runs plus the retries requested with sched_task_defer()
+  uint32_t overruns; // Periods skipped because the task was still busy with an older one
+  int32_t jitter_min_us;
+  int32_t jitter_max_us;
+  int64_t jitter_sum_us;
+} sched_stats_t;
+
+struct sched_task {
+  const char *name;
+  uint32_t period_ms;
+  sched_fn_t fn;
+  void *user_data;
+
+  int64_t deadline; // Absolute deadline of the current period in ticks
+  int64_t retry;    // Absolute time of a retry requested with sched_task_defer(), 0 if none
+  atomic_t waiting; // Set while a retry is scheduled, read by sched_task_wake()
+  sched_stats_t stats;
+
+  struct k_work_q *queue;
+  struct k_work_delayable work;
+};
+
+void sched_init(void);
+
+void sched_task_init(sched_task_t *task, const char *name, uint32_t period_ms, sched_queue_t queue, sched_fn_t fn,
+                     void *user_data);
+void sched_task_start(sched_task_t *task, int64_t epoch);
+void sched_task_stop(sched_task_t *task);
+void sched_task_set_period(sched_task_t *task, uint32_t period_ms);
+void sched_task_defer(sched_task_t *task, uint32_t delay_ms);
+void sched_task_wake(sched_task_t *task);
+
+uint32_t sched_task_deadline_ms(const sched_task_t *task);
+
+void sched_stats_reset(sched_task_t *task);
+void sched_stats_log(const sched_task_t *task);
+
+#endif /* SCHED_H */
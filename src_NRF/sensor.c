@@ -0,0 +1,381 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: sensor.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/kernel.h>
+
+#include <zephyr/logging/log.h>
+
+#include "cfg.h"
+#include "config.h"
+#include "sensor.h"
+#include "sensor_rtio.h"
+
+#include "as7331_sensor.h"
+#include "bh1730fvc_sensor.h"
+#include "bme688_sensor.h"
+#include "ilps28qsw_sensor.h"
+#include "ism330dhcx_sensor.h"
+#include "lis2duxs12_sensor.h"
+#include "max77654_sensor.h"
+#include "max_m10s_sensor.h"
+#include "scd41_sensor.h"
+#include "sgp41_sensor.h"
+
+LOG_MODULE_REGISTER(sensor, LOG_LEVEL_INF);
+
+// Hook of a sensor with a Zephyr driver, the RTIO backend with SENSOR_RTIO, the wrapper otherwise, see sensor_rtio.h
+#define SENSOR_HOOK(rtio, wrapper) (SENSOR_RTIO ? (rtio) : (wrapper))
+
+// BME688 conversions run on the bus the sensor is connected to
+#define BME688_QUEUE                                                                                                   \
+  (DT_SAME_NODE(DT_BUS(DT_INST(0, bosch_bme680)), DT_ALIAS(i2ca)) ? SCHED_QUEUE_I2CA : SCHED_QUEUE_I2CB)
+
+// ----------------- SCD41 (CO2 Sensor) --------------------------------------------------------------------------------
+#if SCD41_ENABLED
+static bool scd41_gated = false;
+
+// A gated SCD41 measures in single-shot mode, the periodic mode would convert while nobody reads
+static void scd41_set_gated(bool gated) {
+  scd41_gated = gated;
+  single_shot_scd41(gated);
+}
+
+static int scd41_read(sensor_values_t *values) {
+  return collect_scd41(&values->scd41_co2, &values->scd41_temperature, &values->scd41_humidity);
+}
+
+static int scd41_power_off(void) {
+  // Fails if the periodic measurement is not running, the supply is cut anyway. A gated sensor is idle
+  if (!scd41_gated) {
+    scd4x_stop_periodic_measurement();
+  }
+  return poweroff_scd41();
+}
+
+static uint32_t scd41_interval_ms(void) { return SCD41_INTERVAL; }
+
+// Periodic mode draws 15 mA on average, a gated sample costs the discarded single shot after power-up
+static const gating_model_t scd41_gating = {
+    .warmup_ms = SCD41_SINGLE_SHOT_TIME + SCD41_RETRY_TIME,
+    .warmup_ua = 15000,
+    .idle_ua = 15000,
+    .conversion_ms = SCD41_SINGLE_SHOT_TIME,
+};
+
+SENSOR_RTIO_HOOKS(scd41, SENSOR_SCD41)
+
+static adapt_channel_t scd41_adapt[] = {ADAPT_CHANNEL(scd41_co2, ADAPT_U16, ADAPT_SCD41_CO2)};
+#endif
+
+// ----------------- SGP41 (VOC Sensor) --------------------------------------------------------------------------------
+#if SGP41_ENABLED
+// Humidity and temperature compensation, 50 %RH and 25 °C
+static const uint16_t default_rh = 0x8000;
+static const uint16_t default_t = 0x6666;
+
+static int sgp41_configure(void) {
+  uint16_t sraw_voc;
+
+  // The heater conditions the sensor until the first measurement, see SGP41_CONDITIONING_TIME
+  return sgp41_execute_conditioning(default_rh, default_t, &sraw_voc);
+}
+
+static int sgp41_trigger(void) { return start_sgp41(default_rh, default_t); }
+
+static int sgp41_read(sensor_values_t *values) { return collect_sgp41(&values->sgp41_voc, &values->sgp41_nox); }
+
+static int sgp41_power_off(void) {
+  sgp41_turn_heater_off();
+  return poweroff_sgp41();
+}
+
+static uint32_t sgp41_conversion_ms(void) { return SGP41_MEASURE_TIME; }
+
+// The hotplate stays on between two measurements, a gated sensor has to condition it again after power-up
+static const gating_model_t sgp41_gating = {
+    .warmup_ms = SGP41_CONDITIONING_TIME,
+    .warmup_ua = 3400,
+    .idle_ua = 3400,
+};
+
+SENSOR_RTIO_HOOKS(sgp41, SENSOR_SGP41)
+
+static adapt_channel_t sgp41_adapt[] = {ADAPT_CHANNEL(sgp41_voc, ADAPT_U16, ADAPT_SGP41_VOC)};
+#endif
+
+// ----------------- ILPS28QSW (Pressure Sensor) -----------------------------------------------------------------------
+#if ILPS28QSW_ENABLED
+static int ilps28qsw_configure(void) {
+  return configure_ilps28qsw(cfg_get(CFG_ILPS28QSW_ODR), cfg_get(CFG_ILPS28QSW_AVG));
+}
+
+static int ilps28qsw_read(sensor_values_t *values) {
+  return collect_ilps28qsw(&values->ilps28qsw_pressure, &values->ilps28qsw_temperature);
+}
+
+static uint32_t ilps28qsw_interval_ms(void) { return 1000 / cfg_get(CFG_ILPS28QSW_ODR); }
+
+SENSOR_RTIO_HOOKS(ilps28qsw, SENSOR_ILPS28QSW)
+
+static adapt_channel_t ilps28qsw_adapt[] = {ADAPT_CHANNEL(ilps28qsw_pressure, ADAPT_F32, ADAPT_ILPS28QSW_PRESSURE)};
+#endif
+
+// ----------------- BME688 (Environmental Sensor) ---------------------------------------------------------------------
+#if BME688_ENABLED
+static int bme688_read(sensor_values_t *values) {
+  return collect_bme688(&values->bme688_temperature, &values->bme688_pressure, &values->bme688_humidity,
+                        &values->bme688_gas_resistance);
+}
+
+static uint32_t bme688_conversion_ms(void) { return BME688_CONVERSION_TIME; }
+
+static adapt_channel_t bme688_adapt[] = {
+    ADAPT_CHANNEL(bme688_temperature, ADAPT_F32, ADAPT_BME688_TEMPERATURE),
+    ADAPT_CHANNEL(bme688_humidity, ADAPT_F32, ADAPT_BME688_HUMIDITY),
+};
+#endif
+
+// ----------------- BH1730FVC (Ambient Light Sensor) ------------------------------------------------------------------
+#if BH1730FVC_ENABLED
+static int bh1730_configure(void) { return configure_bh1730(cfg_get(CFG_BH1730_GAIN), cfg_get(CFG_BH1730_INT)); }
+
+static int bh1730_read(sensor_values_t *values) {
+  return collect_bh1730(&values->bh1730_visible, &values->bh1730_ir, &values->bh1730_lux);
+}
+
+static uint32_t bh1730_interval_ms(void) { return DIV_ROUND_UP(integration_bh1730(), 1000); }
+
+SENSOR_RTIO_HOOKS(bh1730, SENSOR_BH1730FVC)
+
+static adapt_channel_t bh1730_adapt[] = {ADAPT_CHANNEL(bh1730_lux, ADAPT_U32, ADAPT_BH1730_LUX)};
+#endif
+
+// ----------------- AS7331 (UV Sensor) --------------------------------------------------------------------------------
+#if AS7331_ENABLED
+static int as7331_init(void) {
+  // The reset only takes effect while the sensor is powered up, it has to be powered up again afterwards
+  if (init_as7331() != NO_ERROR || reset_as7331() != NO_ERROR) {
+    return -1;
+  }
+  return init_as7331();
+}
+
+static int as7331_configure(void) { return configure_as7331(cfg_get(CFG_AS7331_GAIN), cfg_get(CFG_AS7331_TIME)); }
+
+static int as7331_read(sensor_values_t *values) {
+  return collect_as7331(&values->as7331_temp, &values->as7331_uva, &values->as7331_uvb, &values->as7331_uvc);
+}
+
+SENSOR_RTIO_HOOKS(as7331, SENSOR_AS7331)
+
+// Waiting for a command in the configuration state draws about 1 mA, the power-up only takes the reset sequence
+static const gating_model_t as7331_gating = {
+    .warmup_ua = 1500,
+    .idle_ua = 1000,
+};
+
+static adapt_channel_t as7331_adapt[] = {ADAPT_CHANNEL(as7331_uva, ADAPT_U16, ADAPT_AS7331_UVA)};
+#endif
+
+// ----------------- MAX-M10S (GNSS) -----------------------------------------------------------------------------------
+static int max_m10s_power_off(void) {
+  poweroff_max_m10s();
+  return 0;
+}
+
+// ----------------- Registry ------------------------------------------------------------------------------------------
+const sensor_driver_t sensor_registry[SENSOR_COUNT] = {
+#if SCD41_ENABLED
+    [SENSOR_SCD41] = {.name = "SCD41",
+                      .power_on = poweron_scd41,
+                      .init = init_scd41,
+                      .configure = SENSOR_HOOK(scd41_rtio_configure, configure_scd41),
+                      .trigger = SENSOR_HOOK(scd41_rtio_trigger, start_scd41),
+                      .ready = SENSOR_HOOK(scd41_rtio_ready, ready_scd41),
+                      .read = SENSOR_HOOK(scd41_rtio_read, scd41_read),
+                      .power_off = scd41_power_off,
+                      .test = test_scd41,
+                      .set_gated = SENSOR_HOOK(NULL, scd41_set_gated),
+                      .conversion_ms = SENSOR_HOOK(NULL, conversion_scd41),
+                      .interval_ms = SENSOR_HOOK(scd41_rtio_conversion_ms, scd41_interval_ms),
+                      .period_ms = SCD41_PERIOD,
+                      .poll_ms = SCD41_RETRY_TIME,
+                      .queue = SCHED_QUEUE_I2CB,
+                      .trace_id = TRACE_SCD41,
+                      .latency = LATENCY_SCD41_START,
+                      SENSOR_FIELDS(scd41_co2, scd41_humidity),
+                      SENSOR_ADAPT(scd41_adapt),
+                      .gating = SENSOR_HOOK(NULL, &scd41_gating)},
+#endif
+#if SGP41_ENABLED
+    [SENSOR_SGP41] = {.name = "SGP41",
+                      .power_on = poweron_sgp41,
+                      .configure = SENSOR_HOOK(sgp41_rtio_configure, sgp41_configure),
+                      .trigger = SENSOR_HOOK(sgp41_rtio_trigger, sgp41_trigger),
+                      .ready = SENSOR_HOOK(sgp41_rtio_ready, ready_sgp41),
+                      .read = SENSOR_HOOK(sgp41_rtio_read, sgp41_read),
+                      .power_off = sgp41_power_off,
+                      .test = test_sgp41,
+                      .conversion_ms = SENSOR_HOOK(sgp41_rtio_conversion_ms, sgp41_conversion_ms),
+                      .period_ms = SGP41_PERIOD,
+                      .warmup_ms = SGP41_CONDITIONING_TIME,
+                      .queue = SCHED_QUEUE_I2CB,
+                      .trace_id = TRACE_SGP41,
+                      .latency = LATENCY_SGP41_START,
+                      SENSOR_FIELDS(sgp41_voc, sgp41_nox),
+                      SENSOR_ADAPT(sgp41_adapt),
+                      .gating = SENSOR_HOOK(NULL, &sgp41_gating)},
+#endif
+#if ILPS28QSW_ENABLED
+    [SENSOR_ILPS28QSW] = {.name = "ILPS28QSW",
+                          .configure = SENSOR_HOOK(ilps28qsw_rtio_configure, ilps28qsw_configure),
+                          .trigger = SENSOR_HOOK(ilps28qsw_rtio_trigger, start_ilps28qsw),
+                          .ready = SENSOR_HOOK(ilps28qsw_rtio_ready, ready_ilps28qsw),
+                          .read = SENSOR_HOOK(ilps28qsw_rtio_read, ilps28qsw_read),
+                          .test = test_ilpS28qsw,
+                          .interval_ms = SENSOR_HOOK(ilps28qsw_rtio_conversion_ms, ilps28qsw_interval_ms),
+                          .cfg_mask = BIT(CFG_ILPS28QSW_ODR) | BIT(CFG_ILPS28QSW_AVG),
+                          .period_ms = ILPS28QSW_PERIOD,
+                          .queue = SCHED_QUEUE_I2CB,
+                          .drdy = SENSOR_HOOK(DRDY_NONE, DRDY_ILPS28QSW),
+                          .trace_id = TRACE_ILPS28QSW,
+                          .latency = LATENCY_ILPS28QSW_START,
+                          SENSOR_FIELDS(ilps28qsw_pressure, ilps28qsw_temperature),
+                          SENSOR_ADAPT(ilps28qsw_adapt)},
+#endif
+#if BME688_ENABLED
+    [SENSOR_BME688] = {.name = "BME688",
+                       .trigger = start_bme688,
+                       .ready = ready_bme688,
+                       .read = bme688_read,
+                       .test = test_bme688,
+                       .conversion_ms = bme688_conversion_ms,
+                       .period_ms = BME688_PERIOD,
+                       .queue = BME688_QUEUE,
+                       .trace_id = TRACE_BME688,
+                       .latency = LATENCY_BME688_START,
+                       SENSOR_FIELDS(bme688_temperature, bme688_gas_resistance),
+                       SENSOR_ADAPT(bme688_adapt)},
+#endif
+#if BH1730FVC_ENABLED
+    [SENSOR_BH1730FVC] = {.name = "BH1730FVC",
+                          .init = poweron_bh1730,
+                          .configure = SENSOR_HOOK(bh1730_rtio_configure, bh1730_configure),
+                          .trigger = SENSOR_HOOK(bh1730_rtio_trigger, start_bh1730),
+                          .ready = SENSOR_HOOK(bh1730_rtio_ready, ready_bh1730),
+                          .read = SENSOR_HOOK(bh1730_rtio_read, bh1730_read),
+                          .power_off = poweroff_bh1730,
+                          .test = test_bh1730fvc,
+                          .interval_ms = SENSOR_HOOK(bh1730_rtio_conversion_ms, bh1730_interval_ms),
+                          .cfg_mask = BIT(CFG_BH1730_GAIN) | BIT(CFG_BH1730_INT),
+                          .period_ms = BH1730_PERIOD,
+                          .queue = SCHED_QUEUE_I2CB,
+                          .trace_id = TRACE_BH1730FVC,
+                          .latency = LATENCY_BH1730FVC_START,
+                          SENSOR_FIELDS(bh1730_visible, bh1730_lux),
+                          SENSOR_ADAPT(bh1730_adapt)},
+#endif
+#if AS7331_ENABLED
+    [SENSOR_AS7331] = {.name = "AS7331",
+                       .power_on = poweron_as7331,
+                       .init = as7331_init,
+                       .configure = SENSOR_HOOK(as7331_rtio_configure, as7331_configure),
+                       .trigger = SENSOR_HOOK(as7331_rtio_trigger, start_as7331),
+                       .ready = SENSOR_HOOK(as7331_rtio_ready, ready_as7331),
+                       .read = SENSOR_HOOK(as7331_rtio_read, as7331_read),
+                       .power_off = poweroff_as7331,
+                       .test = test_as7331,
+                       .conversion_ms = SENSOR_HOOK(as7331_rtio_conversion_ms, conversion_as7331),
+                       .cfg_mask = BIT(CFG_AS7331_GAIN) | BIT(CFG_AS7331_TIME),
+                       .period_ms = AS7331_PERIOD,
+                       .queue = SCHED_QUEUE_I2CB,
+                       .drdy = SENSOR_HOOK(DRDY_NONE, DRDY_AS7331),
+                       .trace_id = TRACE_AS7331,
+                       .latency = LATENCY_AS7331_START,
+                       SENSOR_FIELDS(as7331_temp, as7331_uvc),
+                       SENSOR_ADAPT(as7331_adapt),
+                       .gating = SENSOR_HOOK(NULL, &as7331_gating)},
+#endif
+    [SENSOR_ISM330DHCX] = {.name = "ISM330DHCX", .test = test_ism330dhcx},
+    [SENSOR_LIS2DUXS12] = {.name = "LIS2DUXS12", .test = test_lis2duxs12},
+    [SENSOR_MAX77654] = {.name = "MAX77654", .test = test_max77654},
+    [SENSOR_MAX_M10S] = {.name = "MAX-M10S", .power_off = max_m10s_power_off}, // Test disabled, only powered off
+};
+
+/**
+ * @brief Powers on several sensors behind a single settle delay.
+ *
+ * The supply and bus switches of all sensors are turned on first, the sensors are then brought up with init() after
+ * one SENSOR_SETTLE_TIME instead of a settle delay per sensor.
+ *
+ * @param mask BIT() of the sensor_id_t of every sensor
+ * @return 0 on success, the error of the last sensor failing otherwise
+ */
+int sensor_power_up(uint32_t mask) {
+  bool settle = false;
+  int error = NO_ERROR;
+  int rc;
+
+  for (size_t i = 0; i < SENSOR_COUNT; i++) {
+    const sensor_driver_t *driver = &sensor_registry[i];
+
+    if (!(mask & BIT(i)) || !driver->power_on) {
+      continue;
+    }
+    rc = driver->power_on();
+    if (rc != NO_ERROR) {
+      LOG_ERR(" * Error %d powering on %s", rc, driver->name);
+      mask &= ~BIT(i);
+      error = rc;
+      continue;
+    }
+    settle = true;
+  }
+
+  if (settle) {
+    k_msleep(SENSOR_SETTLE_TIME);
+  }
+
+  for (size_t i = 0; i < SENSOR_COUNT; i++) {
+    const sensor_driver_t *driver = &sensor_registry[i];
+
+    if (!(mask & BIT(i)) || !driver->init) {
+      continue;
+    }
+    rc = driver->init();
+    if (rc != NO_ERROR) {
+      LOG_ERR(" * Error %d initializing %s", rc, driver->name);
+      error = rc;
+    }
+  }
+  return error;
+}
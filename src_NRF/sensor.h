@@ -0,0 +1,133 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: sensor.h
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SENSOR_H
+#define SENSOR_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "adapt.h"
+#include "config.h"
+#include "drdy.h"
+#include "gating.h"
+#include "latency.h"
+#include "record.h"
+#include "sched.h"
+#include "trace.h"
+
+/*
+ * Sensor registry
+ *
+ * Every part on the board is described by one entry of sensor_registry[]: how it is powered, configured, triggered
+ * and read, the fields of the record it fills and the policy of its sampling period. The acquisition, the boot
+ * sequence and the self-test iterate over the registry, so adding a sensor means adding one driver and one entry.
+ *
+ * The first SENSOR_ACQ_COUNT entries are sampled into the record, the remaining parts are only tested at boot.
+ * Sensors disabled in config.h have neither an id nor an entry, so their driver is never referenced and their record
+ * channels are left out, see channels.h.
+ */
+
+typedef enum {
+#if SCD41_ENABLED
+  SENSOR_SCD41,
+#endif
+#if SGP41_ENABLED
+  SENSOR_SGP41,
+#endif
+#if ILPS28QSW_ENABLED
+  SENSOR_ILPS28QSW,
+#endif
+#if BME688_ENABLED
+  SENSOR_BME688,
+#endif
+#if BH1730FVC_ENABLED
+  SENSOR_BH1730FVC,
+#endif
+#if AS7331_ENABLED
+  SENSOR_AS7331,
+#endif
+  SENSOR_ACQ_COUNT,
+  SENSOR_ISM330DHCX = SENSOR_ACQ_COUNT,
+  SENSOR_LIS2DUXS12,
+  SENSOR_MAX77654,
+  SENSOR_MAX_M10S,
+  SENSOR_COUNT,
+} sensor_id_t;
+
+// Byte range of sensor_values_t written by the read function of a sensor
+#define SENSOR_FIELDS(first, last)                                                                                     \
+  .offset = offsetof(sensor_values_t, first),                                                                          \
+  .size = offsetof(sensor_values_t, last) + sizeof(((sensor_values_t *)0)->last) - offsetof(sensor_values_t, first)
+
+#define SENSOR_ADAPT(channels) .adapt = channels, .adapt_count = ARRAY_SIZE(channels)
+
+/**
+ * @brief Driver of one sensor.
+ *
+ * All functions return 0 on success and run on the queue of the bus of the sensor, except during boot. Unused
+ * functions are NULL.
+ */
+typedef struct {
+  const char *name;
+
+  int (*power_on)(void);  // Switches the supply and connects the sensor to the bus, returns without waiting
+  int (*init)(void);      // Brings the sensor up once the supply has settled, see sensor_power_up()
+  int (*configure)(void); // Applies the runtime parameters in cfg_mask and the measurement mode
+  int (*trigger)(void);   // Starts a conversion, NULL for parts that are only tested
+  int (*ready)(bool *ready);
+  int (*read)(sensor_values_t *values); // Writes the fields in [offset, offset + size)
+  int (*power_off)(void);               // Cuts the supply even if the sensor does not respond
+  void (*test)(void);                   // Self-test at boot, powered on
+  void (*set_gated)(bool gated);        // Selects the measurement mode of the next configure(), powered off or idle
+
+  uint32_t (*conversion_ms)(void); // Conversion time of the applied configuration, NULL or 0 if converting continuously
+  uint32_t (*interval_ms)(void);   // Output interval of a continuously converting sensor
+
+  uint32_t cfg_mask;
+  uint32_t period_ms; // Period without adaptive sampling, 0 follows the runtime sampling time, see ACQ_PERIOD_INTERVAL
+  uint32_t poll_ms;   // Interval of the ready checks after the expected conversion time, 0 for ACQ_POLL_TIME
+  uint32_t warmup_ms; // Time after power_on() before the first conversion is valid
+  sched_queue_t queue;
+  drdy_src_t drdy; // Data-ready line waking the ready check, DRDY_NONE to only poll
+  trace_event_t trace_id;
+  latency_stage_t latency; // First of the LATENCY_SENSOR_* stages
+  size_t offset;
+  size_t size;
+  adapt_channel_t *adapt; // Channels choosing the period with ADAPT_ENABLED
+  size_t adapt_count;
+  const gating_model_t *gating; // Switched off between samples if worthwhile, NULL if always on, see gating.h
+} sensor_driver_t;
+
+extern const sensor_driver_t sensor_registry[SENSOR_COUNT];
+
+int sensor_power_up(uint32_t mask);
+
+#endif /* SENSOR_H */
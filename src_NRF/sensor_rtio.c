@@ -0,0 +1,349 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: sensor_rtio.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#include <math.h>
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/kernel.h>
+#include <zephyr/rtio/rtio.h>
+
+#include <zephyr/logging/log.h>
+
+#include "cfg.h"
+#include "sensei_sensor.h"
+#include "sensor.h"
+#include "sensor_rtio.h"
+
+LOG_MODULE_REGISTER(sensor_rtio, LOG_LEVEL_INF);
+
+// Samples of the drivers are small, see sensei_sensor_frame_t
+#define SENSOR_RTIO_BLOCK_SIZE 64
+
+RTIO_DEFINE_WITH_MEMPOOL(sensor_rtio_ctx, SENSOR_RTIO_BUFFERS, SENSOR_RTIO_BUFFERS, SENSOR_RTIO_BUFFERS,
+                         SENSOR_RTIO_BLOCK_SIZE, sizeof(void *));
+
+// The sensor is read on the queue of its bus, the node has to sit on the controller behind the alias
+#define SENSOR_RTIO_NODE(compat) DT_COMPAT_GET_ANY_STATUS_OKAY(compat)
+#define SENSOR_RTIO_CHECK(compat, alias)                                                                               \
+  BUILD_ASSERT(DT_HAS_COMPAT_STATUS_OKAY(compat), #compat " node missing, see sensors.overlay");                       \
+  BUILD_ASSERT(DT_SAME_NODE(DT_BUS(SENSOR_RTIO_NODE(compat)), DT_ALIAS(alias)), #compat " is not on " #alias)
+
+// Channel of the driver written to a field of the record, scaled to the unit of the record channel
+typedef struct {
+  uint16_t chan;
+  record_channel_id_t field;
+  float scale;
+} sensor_rtio_field_t;
+
+typedef struct {
+  const struct device *dev;
+  struct rtio_iodev *iodev;
+  const sensor_rtio_field_t *fields;
+  size_t field_count;
+} sensor_rtio_sensor_t;
+
+#define SENSOR_RTIO_SENSOR(compat, iodev_name, field_table)                                                            \
+  {DEVICE_DT_GET(SENSOR_RTIO_NODE(compat)), &iodev_name, field_table, ARRAY_SIZE(field_table)}
+
+#if SCD41_ENABLED
+SENSOR_RTIO_CHECK(sensei_scd41, i2cb);
+SENSOR_DT_READ_IODEV(scd41_iodev, SENSOR_RTIO_NODE(sensei_scd41), {SENSOR_CHAN_ALL, 0});
+static const sensor_rtio_field_t scd41_fields[] = {
+    {SENSOR_CHAN_CO2, RECORD_CHANNEL_scd41_co2, 1.0f},
+    {SENSOR_CHAN_AMBIENT_TEMP, RECORD_CHANNEL_scd41_temperature, 1.0f},
+    {SENSOR_CHAN_HUMIDITY, RECORD_CHANNEL_scd41_humidity, 1.0f},
+};
+#endif
+
+#if SGP41_ENABLED
+SENSOR_RTIO_CHECK(sensei_sgp41, i2cb);
+SENSOR_DT_READ_IODEV(sgp41_iodev, SENSOR_RTIO_NODE(sensei_sgp41), {SENSOR_CHAN_ALL, 0});
+static const sensor_rtio_field_t sgp41_fields[] = {
+    {SENSEI_SENSOR_CHAN_SRAW_VOC, RECORD_CHANNEL_sgp41_voc, 1.0f},
+    {SENSEI_SENSOR_CHAN_SRAW_NOX, RECORD_CHANNEL_sgp41_nox, 1.0f},
+};
+#endif
+
+#if ILPS28QSW_ENABLED
+SENSOR_RTIO_CHECK(sensei_ilps28qsw, i2cb);
+SENSOR_DT_READ_IODEV(ilps28qsw_iodev, SENSOR_RTIO_NODE(sensei_ilps28qsw), {SENSOR_CHAN_ALL, 0});
+static const sensor_rtio_field_t ilps28qsw_fields[] = {
+    {SENSOR_CHAN_PRESS, RECORD_CHANNEL_ilps28qsw_pressure, 10.0f}, // kPa to hPa
+    {SENSOR_CHAN_AMBIENT_TEMP, RECORD_CHANNEL_ilps28qsw_temperature, 1.0f},
+};
+#endif
+
+#if BH1730FVC_ENABLED
+SENSOR_RTIO_CHECK(sensei_bh1730fvc, i2cb);
+SENSOR_DT_READ_IODEV(bh1730fvc_iodev, SENSOR_RTIO_NODE(sensei_bh1730fvc), {SENSOR_CHAN_ALL, 0});
+static const sensor_rtio_field_t bh1730fvc_fields[] = {
+    {SENSEI_SENSOR_CHAN_VISIBLE, RECORD_CHANNEL_bh1730_visible, 1.0f},
+    {SENSOR_CHAN_IR, RECORD_CHANNEL_bh1730_ir, 1.0f},
+    {SENSOR_CHAN_LIGHT, RECORD_CHANNEL_bh1730_lux, 1.0f},
+};
+#endif
+
+#if AS7331_ENABLED
+SENSOR_RTIO_CHECK(sensei_as7331, i2cb);
+SENSOR_DT_READ_IODEV(as7331_iodev, SENSOR_RTIO_NODE(sensei_as7331), {SENSOR_CHAN_ALL, 0});
+static const sensor_rtio_field_t as7331_fields[] = {
+    {SENSOR_CHAN_DIE_TEMP, RECORD_CHANNEL_as7331_temp, 1.0f},
+    {SENSEI_SENSOR_CHAN_UVA, RECORD_CHANNEL_as7331_uva, 1.0f},
+    {SENSEI_SENSOR_CHAN_UVB, RECORD_CHANNEL_as7331_uvb, 1.0f},
+    {SENSEI_SENSOR_CHAN_UVC, RECORD_CHANNEL_as7331_uvc, 1.0f},
+};
+#endif
+
+static const sensor_rtio_sensor_t sensors[SENSOR_ACQ_COUNT] = {
+#if SCD41_ENABLED
+    [SENSOR_SCD41] = SENSOR_RTIO_SENSOR(sensei_scd41, scd41_iodev, scd41_fields),
+#endif
+#if SGP41_ENABLED
+    [SENSOR_SGP41] = SENSOR_RTIO_SENSOR(sensei_sgp41, sgp41_iodev, sgp41_fields),
+#endif
+#if ILPS28QSW_ENABLED
+    [SENSOR_ILPS28QSW] = SENSOR_RTIO_SENSOR(sensei_ilps28qsw, ilps28qsw_iodev, ilps28qsw_fields),
+#endif
+#if BH1730FVC_ENABLED
+    [SENSOR_BH1730FVC] = SENSOR_RTIO_SENSOR(sensei_bh1730fvc, bh1730fvc_iodev, bh1730fvc_fields),
+#endif
+#if AS7331_ENABLED
+    [SENSOR_AS7331] = SENSOR_RTIO_SENSOR(sensei_as7331, as7331_iodev, as7331_fields),
+#endif
+};
+
+/**
+ * @brief Completion of the last read of a sensor.
+ *
+ * A read is pending from the submission until its completion is decoded by sensor_rtio_read(). Completions are
+ * collected for all sensors by whichever bus queue checks first.
+ */
+typedef struct {
+  bool pending;
+  bool done;
+  int result;
+  uint8_t *buf;
+  uint32_t buf_len;
+} sensor_rtio_slot_t;
+
+static sensor_rtio_slot_t slots[SENSOR_ACQ_COUNT];
+static K_MUTEX_DEFINE(slots_lock);
+
+static void sensor_rtio_release(sensor_rtio_slot_t *slot) {
+  if (slot->buf) {
+    rtio_release_buffer(&sensor_rtio_ctx, slot->buf, slot->buf_len);
+  }
+  *slot = (sensor_rtio_slot_t){0};
+}
+
+/**
+ * @brief Moves all completions of the context to the slots of their sensors.
+ *
+ */
+static void sensor_rtio_drain(void) {
+  struct rtio_cqe *cqe;
+
+  while ((cqe = rtio_cqe_consume(&sensor_rtio_ctx)) != NULL) {
+    sensor_rtio_slot_t *slot = &slots[(uintptr_t)cqe->userdata];
+
+    slot->done = true;
+    slot->result = cqe->result;
+    if (cqe->result >= 0 && rtio_cqe_get_mempool_buffer(&sensor_rtio_ctx, cqe, &slot->buf, &slot->buf_len) != 0) {
+      slot->result = -ENOMEM;
+    }
+    rtio_cqe_release(&sensor_rtio_ctx, cqe);
+  }
+}
+
+/**
+ * @brief Reinitializes the part and applies the runtime parameters of its sensor.
+ *
+ * A parameter change therefore restarts the part, like a recovery does.
+ */
+int sensor_rtio_configure(int id) {
+  const struct device *dev = sensors[id].dev;
+  struct sensor_value init = {0};
+
+  int rc = sensor_attr_set(dev, SENSOR_CHAN_ALL, (enum sensor_attribute)SENSEI_SENSOR_ATTR_INIT, &init);
+  if (rc) {
+    LOG_ERR("%s Error %d initializing", dev->name, rc);
+    return rc;
+  }
+
+  switch (id) {
+#if ILPS28QSW_ENABLED
+  case SENSOR_ILPS28QSW: {
+    struct sensor_value odr = {.val1 = cfg_get(CFG_ILPS28QSW_ODR)};
+    struct sensor_value avg = {.val1 = cfg_get(CFG_ILPS28QSW_AVG)};
+
+    rc = sensor_attr_set(dev, SENSOR_CHAN_ALL, SENSOR_ATTR_SAMPLING_FREQUENCY, &odr);
+    if (rc == 0) {
+      rc = sensor_attr_set(dev, SENSOR_CHAN_ALL, (enum sensor_attribute)SENSEI_SENSOR_ATTR_AVERAGING, &avg);
+    }
+    break;
+  }
+#endif
+#if BH1730FVC_ENABLED
+  case SENSOR_BH1730FVC: {
+    struct sensor_value gain = {.val1 = cfg_get(CFG_BH1730_GAIN)};
+    struct sensor_value integration = {.val1 = cfg_get(CFG_BH1730_INT)};
+
+    rc = sensor_attr_set(dev, SENSOR_CHAN_ALL, (enum sensor_attribute)SENSEI_SENSOR_ATTR_GAIN, &gain);
+    if (rc == 0) {
+      rc = sensor_attr_set(dev, SENSOR_CHAN_ALL, (enum sensor_attribute)SENSEI_SENSOR_ATTR_INTEGRATION, &integration);
+    }
+    break;
+  }
+#endif
+#if AS7331_ENABLED
+  case SENSOR_AS7331: {
+    struct sensor_value gain = {.val1 = cfg_get(CFG_AS7331_GAIN)};
+    struct sensor_value time = {.val1 = cfg_get(CFG_AS7331_TIME)};
+
+    rc = sensor_attr_set(dev, SENSOR_CHAN_ALL, (enum sensor_attribute)SENSEI_SENSOR_ATTR_GAIN, &gain);
+    if (rc == 0) {
+      rc = sensor_attr_set(dev, SENSOR_CHAN_ALL, (enum sensor_attribute)SENSEI_SENSOR_ATTR_INTEGRATION, &time);
+    }
+    break;
+  }
+#endif
+  default:
+    break;
+  }
+
+  if (rc) {
+    LOG_ERR("%s Error %d configuring", dev->name, rc);
+  }
+  return rc;
+}
+
+/**
+ * @brief Submits a read of all channels of the sensor, the driver starts the conversion.
+ *
+ */
+int sensor_rtio_trigger(int id) {
+  sensor_rtio_slot_t *slot = &slots[id];
+  int rc;
+
+  k_mutex_lock(&slots_lock, K_FOREVER);
+  sensor_rtio_drain();
+  if (slot->pending && !slot->done) {
+    // The read of a conversion that timed out is still in flight, the driver fails it on its own timeout
+    rc = -EBUSY;
+  } else {
+    sensor_rtio_release(slot);
+    rc = sensor_read_async_mempool(sensors[id].iodev, &sensor_rtio_ctx, (void *)(uintptr_t)id);
+    slot->pending = rc == 0;
+  }
+  k_mutex_unlock(&slots_lock);
+  return rc;
+}
+
+int sensor_rtio_ready(int id, bool *ready) {
+  sensor_rtio_slot_t *slot = &slots[id];
+  int rc = 0;
+
+  k_mutex_lock(&slots_lock, K_FOREVER);
+  sensor_rtio_drain();
+  *ready = slot->done;
+  if (slot->done && slot->result < 0) {
+    rc = slot->result;
+    sensor_rtio_release(slot);
+  }
+  k_mutex_unlock(&slots_lock);
+  return rc;
+}
+
+static void sensor_rtio_store(sensor_values_t *values, record_channel_id_t field, float value) {
+  const record_channel_t *ch = &record_channels[field];
+  uint8_t *dst = (uint8_t *)values + ch->offset;
+
+  switch (ch->type) {
+  case RECORD_U16: {
+    uint16_t v = (uint16_t)CLAMP(lroundf(value), 0, RECORD_MISSING_U16 - 1);
+    memcpy(dst, &v, sizeof(v));
+    break;
+  }
+  case RECORD_U32: {
+    uint32_t v = (uint32_t)CLAMP(llroundf(value), 0, RECORD_MISSING_U32 - 1);
+    memcpy(dst, &v, sizeof(v));
+    break;
+  }
+  case RECORD_F32:
+    memcpy(dst, &value, sizeof(value));
+    break;
+  }
+}
+
+/**
+ * @brief Decodes the completed read of the sensor into its fields of the record.
+ *
+ */
+int sensor_rtio_read(int id, sensor_values_t *values) {
+  const sensor_rtio_sensor_t *sensor = &sensors[id];
+  sensor_rtio_slot_t *slot = &slots[id];
+  const struct sensor_decoder_api *decoder = NULL;
+  int rc;
+
+  k_mutex_lock(&slots_lock, K_FOREVER);
+  rc = slot->done && slot->buf ? sensor_get_decoder(sensor->dev, &decoder) : -ENODATA;
+  for (size_t i = 0; rc == 0 && i < sensor->field_count; i++) {
+    const sensor_rtio_field_t *field = &sensor->fields[i];
+    struct sensor_chan_spec spec = {.chan_type = field->chan, .chan_idx = 0};
+    struct sensor_q31_data q31;
+    uint32_t fit = 0;
+
+    if (decoder->decode(slot->buf, spec, &fit, 1, &q31) != 1) {
+      rc = -EIO;
+      break;
+    }
+    sensor_rtio_store(values, field->field, ldexpf((float)q31.readings[0].value, q31.shift - 31) * field->scale);
+  }
+  sensor_rtio_release(slot);
+  k_mutex_unlock(&slots_lock);
+  return rc;
+}
+
+/**
+ * @brief Returns the conversion time or output interval of the applied configuration of the part.
+ *
+ */
+uint32_t sensor_rtio_conversion_ms(int id) {
+  struct sensor_value val;
+
+  if (sensor_attr_get(sensors[id].dev, SENSOR_CHAN_ALL, (enum sensor_attribute)SENSEI_SENSOR_ATTR_CONVERSION_TIME,
+                      &val) != 0) {
+    return 0;
+  }
+  return DIV_ROUND_UP(val.val1, 1000);
+}
@@ -0,0 +1,75 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: sensor_rtio.h
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SENSOR_RTIO_H
+#define SENSOR_RTIO_H
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "config.h"
+#include "record.h"
+
+/*
+ * RTIO acquisition
+ *
+ * With SENSOR_RTIO the sensors with a Zephyr driver (compatibles sensei,<part>, see sensors.overlay) are acquired
+ * over RTIO instead of their wrappers in sensors/. The trigger of the registry submits a sensor_read() and returns,
+ * the driver starts the conversion and completes the read from its own work queue once the sample is available. The
+ * ready check drains all completions of the context at once, so one check collects every sensor that finished in
+ * the meantime, and the read only decodes the buffer into the fields of the record. Power switching, warm-up and
+ * the self-test stay with the wrappers.
+ *
+ * sensor_id_t is passed as int so the header does not depend on sensor.h.
+ */
+
+#if SENSOR_RTIO
+int sensor_rtio_configure(int id);
+int sensor_rtio_trigger(int id);
+int sensor_rtio_ready(int id, bool *ready);
+int sensor_rtio_read(int id, sensor_values_t *values);
+uint32_t sensor_rtio_conversion_ms(int id);
+#else
+static inline int sensor_rtio_configure(int id) { return -ENOTSUP; }
+static inline int sensor_rtio_trigger(int id) { return -ENOTSUP; }
+static inline int sensor_rtio_ready(int id, bool *ready) { return -ENOTSUP; }
+static inline int sensor_rtio_read(int id, sensor_values_t *values) { return -ENOTSUP; }
+static inline uint32_t sensor_rtio_conversion_ms(int id) { return 0; }
+#endif
+
+// Registry hooks of a sensor acquired over RTIO, see SENSOR_HOOK in sensor.c
+#define SENSOR_RTIO_HOOKS(part, id)                                                                                    \
+  static int part##_rtio_configure(void) { return sensor_rtio_configure(id); }                                         \
+  static int part##_rtio_trigger(void) { return sensor_rtio_trigger(id); }                                             \
+  static int part##_rtio_ready(bool *ready) { return sensor_rtio_ready(id, ready); }                                   \
+  static int part##_rtio_read(sensor_values_t *values) { return sensor_rtio_read(id, values); }                        \
+  static uint32_t part##_rtio_conversion_ms(void) { return sensor_rtio_conversion_ms(id); }
+
+#endif /* SENSOR_RTIO_H */
@@ -3,7 +3,7 @@
  *
  * File: as7331_sensor.c
  *
- * Last edited: 30.10.2025
+ * Last edited: 16.10.2026
  *
  * Copyright (c) 2025 ETH Zurich and University of Bologna
  *
@@ -36,6 +36,8 @@
 #include "as7331_reg.h"
 #include "as7331_sensor.h"
 #include "config.h"
+#include "drdy.h"
+#include "fmt.h"
 #include "i2c_helpers.h"
 
 #define GPIO_NODE_i2c_as7331_en DT_NODELABEL(gpio_ext_i2c_as7331_en)
@@ -51,6 +53,9 @@ LOG_MODULE_DECLARE(sensors, LOG_LEVEL_INF);
 i2c_ctx_t as7331_i2c_ctx;
 as7331_t as7331_ctx;
 
+// Conversion time of the applied configuration as 2^time ms
+static uint8_t as7331_time = AS7331_TIME;
+
 as7331_reg_osrstat_t print_as7331_status(as7331_t *as7331_ctx) {
   as7331_reg_osrstat_t status = {0};
 
@@ -193,8 +198,9 @@ void test_as7331() {
     LOG_ERR(" * Error reading all");
   } else {
     float temp = all.temp * 0.05f - 66.9f;
+    char text[FMT_FIXED_MAX_LEN + 1];
 
-    LOG_INF(" - Temp                                : %.2f °C" SPACES, temp);
+    LOG_INF(" - Temp                                : %s °C" SPACES, fmt_fixed_str(text, temp, 2));
     LOG_INF(" - UVA                                 : %u" SPACES, all.uva);
     LOG_INF(" - UVB                                 : %u" SPACES, all.uvb);
     LOG_INF(" - UVC                                 : %u" SPACES, all.uvc);
@@ -203,9 +209,129 @@ void test_as7331() {
   gpio_pin_toggle_dt(&gpio_debug_1);
 }
 
+/**
+ * @brief Configures the powered AS7331 for one-shot conversions in command mode.
+ *
+ * @param gain ADCGain = 2^(11-gain), 0 - 11
+ * @param time Conversion time of 2^time ms, 0 - 15
+ * @return 0 on success, negative on error
+ */
+int configure_as7331(uint8_t gain, uint8_t time) {
+  MMODE mmode = AS7331_CMD_MODE; // choices are modes are CONT, CMD, SYNS, SYND
+  CCLK cclk = AS7331_1024;       // choices are 1.024, 2.048, 4.096, or 8.192 MHz
+  uint8_t sb = 0x00;             // standby enabled 0x01 (to save power), standby disabled 0x00
+  uint8_t break_time = 255;      // sample time == 8 us x breakTime (0 - 255, or 0 - 2040 us range), CONT or SYNX modes
+
+  int error = as7331_set_configuration_mode(&as7331_ctx);
+  if (error) {
+    LOG_ERR(" * AS7331 Error %d setting configuration mode", error);
+    return error;
+  }
+
+  error = as7331_init(&as7331_ctx, mmode, cclk, sb, break_time, gain, time);
+  if (error) {
+    LOG_ERR(" * AS7331 Error %d initializing sensor", error);
+    return error;
+  }
+
+  error = as7331_set_measurement_mode(&as7331_ctx);
+  if (error) {
+    LOG_ERR(" * AS7331 Error %d setting measurement mode", error);
+    return error;
+  }
+  as7331_time = time;
+  LOG_INF("AS7331 gain %u, conversion time %u ms", gain, 1U << time);
+  return 0;
+}
+
+/**
+ * @brief Returns the conversion time of the applied configuration in ms.
+ *
+ */
+uint32_t conversion_as7331() { return 1U << as7331_time; }
+
+/**
+ * @brief Resets the powered AS7331, it has to be powered up again afterwards.
+ *
+ * @return 0 on success, negative on error
+ */
+int reset_as7331() {
+  int error = as7331_reset(&as7331_ctx);
+  if (error) {
+    LOG_ERR(" * AS7331 Error %d resetting", error);
+    return error;
+  }
+  return 0;
+}
+
+/**
+ * @brief Starts a one-shot conversion of the AS7331 in command mode.
+ *
+ * @return 0 on success, negative on error
+ */
+int start_as7331() {
+  drdy_arm(DRDY_AS7331);
+
+  int error = as7331_start_measurement(&as7331_ctx);
+  if (error) {
+    LOG_ERR(" * AS7331 Error %d starting one-shot measurement", error);
+    return error;
+  }
+  return 0;
+}
+
+/**
+ * @brief Checks whether the conversion of the AS7331 has finished.
+ *
+ * Uses the READY line if available, the status register otherwise.
+ *
+ * @return 0 on success, negative on error
+ */
+int ready_as7331(bool *ready) {
+  if (drdy_available(DRDY_AS7331)) {
+    *ready = drdy_pending(DRDY_AS7331);
+    return 0;
+  }
+
+  as7331_reg_osrstat_t status;
+  int error = as7331_get_status(&as7331_ctx, &status);
+  if (error) {
+    LOG_ERR(" * AS7331 Error %d getting status", error);
+    return error;
+  }
+
+  *ready = status.ndata;
+  return 0;
+}
+
+/**
+ * @brief Reads the temperature and the UVA, UVB and UVC channels of the AS7331.
+ *
+ * @return 0 on success, negative on error
+ */
+int collect_as7331(float *temperature, uint16_t *uva, uint16_t *uvb, uint16_t *uvc) {
+  struct {
+    uint16_t temp;
+    uint16_t uva;
+    uint16_t uvb;
+    uint16_t uvc;
+  } all;
+
+  int error = as7331_read_all(&as7331_ctx, (uint16_t *)&all);
+  if (error) {
+    LOG_ERR(" * AS7331 Error %d reading all values", error);
+    return error;
+  }
+
+  *temperature = all.temp * 0.05f - 66.9f;
+  *uva = all.uva;
+  *uvb = all.uvb;
+  *uvc = all.uvc;
+  return 0;
+}
+
 int poweron_as7331() {
   LOG_INF("Power On AS7331 (UV Sensor)" SPACES);
-  int error = NO_ERROR;
 
   as7331_i2c_ctx.i2c_handle = i2c_b;
   as7331_i2c_ctx.i2c_addr = AS7331_I2C_ADD;
@@ -221,13 +347,18 @@ int poweron_as7331() {
     return -1;
   }
 
-  // Wait for I2C bus to be ready
-  k_msleep(100);
+  return 0;
+}
 
-  error = as7331_power_up(&as7331_ctx);
+/**
+ * @brief Leaves the power-down state of the AS7331 once the bus has settled after poweron_as7331().
+ *
+ * @return 0 on success, negative on error
+ */
+int init_as7331() {
+  int error = as7331_power_up(&as7331_ctx);
   if (error) {
     LOG_ERR(" * Error powering up AS7331");
-    k_msleep(1000);
     return -1;
   }
 
@@ -239,12 +370,10 @@ int poweroff_as7331() {
 
   int error = NO_ERROR;
 
-  // Power down
+  // Power down, the sensor is disconnected from the bus even if it does not respond
   error = as7331_power_down(&as7331_ctx);
   if (error) {
     LOG_ERR(" * Error powering down AS7331");
-    k_msleep(1000);
-    return -1;
   }
 
   // Disconnect sensor from I2C bus
@@ -253,5 +382,5 @@ int poweroff_as7331() {
     k_msleep(1000);
     return -1;
   }
-  return 0;
+  return error ? -1 : 0;
 }
\ No newline at end of file
@@ -3,7 +3,7 @@
  *
  * File: as7331_sensor.h
  *
- * Last edited: 30.10.2025
+ * Last edited: 16.10.2026
  *
  * Copyright (c) 2025 ETH Zurich and University of Bologna
  *
@@ -29,11 +29,22 @@
 #ifndef AS7331_SENSOR_H
 #define AS7331_SENSOR_H
 
+#include <stdbool.h>
+#include <stdint.h>
+
 #include "as7331_reg.h"
 
 void test_as7331();
 int poweroff_as7331();
 int poweron_as7331();
+int init_as7331();
+int configure_as7331(uint8_t gain, uint8_t time);
+uint32_t conversion_as7331();
+int reset_as7331();
+
+int start_as7331();
+int ready_as7331(bool *ready);
+int collect_as7331(float *temperature, uint16_t *uva, uint16_t *uvb, uint16_t *uvc);
 
 as7331_reg_osrstat_t print_as7331_status(as7331_t *sensor);
 
@@ -3,7 +3,7 @@
  *
  * File: bh1730fvc_sensor.c
  *
- * Last edited: 30.10.2025
+ * Last edited: 16.10.2026
  *
  * Copyright (c) 2025 ETH Zurich and University of Bologna
  *
@@ -58,7 +58,8 @@ void test_bh1730fvc() {
     LOG_ERR(" * Error initializing BH1730FVC");
     return;
   } else {
-    LOG_INF(" - Integration Time                    : %.2f ms" SPACES, (bh1730_ctx.integration_time_us / 1000.f));
+    LOG_INF(" - Integration Time                    : %u.%02u ms" SPACES, bh1730_ctx.integration_time_us / 1000,
+            bh1730_ctx.integration_time_us % 1000 / 10);
     LOG_INF(" - Gain                                : x%d" SPACES, bh1730_ctx.gain);
   }
 
@@ -128,6 +129,101 @@ int poweron_bh1730() {
   return 0;
 }
 
+/**
+ * @brief Changes gain and integration time of the powered BH1730FVC.
+ *
+ * @param gain Gain of 1, 2, 64 or 128
+ * @param integration ITIME value, e.g. BH1730_INT_50MS
+ * @return 0 on success, negative on error
+ */
+int configure_bh1730(uint32_t gain, uint8_t integration) {
+  int error;
+
+  switch (gain) {
+  case 1:
+    error = bh1730_init(&bh1730_ctx, BH1730_GAIN_X1, integration);
+    break;
+  case 2:
+    error = bh1730_init(&bh1730_ctx, BH1730_GAIN_X2, integration);
+    break;
+  case 64:
+    error = bh1730_init(&bh1730_ctx, BH1730_GAIN_X64, integration);
+    break;
+  case 128:
+    error = bh1730_init(&bh1730_ctx, BH1730_GAIN_X128, integration);
+    break;
+  default:
+    return -EINVAL;
+  }
+
+  if (error) {
+    LOG_ERR(" * BH1730FVC Error %d configuring gain x%u, ITIME %u", error, gain, integration);
+    return error;
+  }
+  LOG_INF("BH1730FVC gain x%d, integration time %u us", bh1730_ctx.gain, bh1730_ctx.integration_time_us);
+  return 0;
+}
+
+/**
+ * @brief Returns the integration time of the applied configuration in us.
+ *
+ */
+uint32_t integration_bh1730() { return bh1730_ctx.integration_time_us; }
+
+/**
+ * @brief Starts a conversion of the BH1730FVC.
+ *
+ * The sensor integrates continuously after bh1730_init(), nothing has to be triggered.
+ *
+ * @return 0 on success, negative on error
+ */
+int start_bh1730() { return 0; }
+
+/**
+ * @brief Checks whether the BH1730FVC finished an integration since the last read.
+ *
+ * @return 0 on success, negative on error
+ */
+int ready_bh1730(bool *ready) {
+  uint8_t valid = false;
+
+  int error = bh1730_valid(&bh1730_ctx, &valid);
+  if (error) {
+    LOG_ERR(" * BH1730FVC Error %d reading valid status", error);
+    return error;
+  }
+
+  *ready = valid;
+  return 0;
+}
+
+/**
+ * @brief Reads the visible and IR channels and the computed illuminance of the BH1730FVC.
+ *
+ * @return 0 on success, negative on error
+ */
+int collect_bh1730(uint16_t *visible, uint16_t *ir, uint32_t *lux) {
+  int error = bh1730_read_visible(&bh1730_ctx, visible);
+  if (error) {
+    LOG_ERR(" * BH1730FVC Error %d reading visible light", error);
+    return error;
+  }
+
+  error = bh1730_read_ir(&bh1730_ctx, ir);
+  if (error) {
+    LOG_ERR(" * BH1730FVC Error %d reading IR light", error);
+    return error;
+  }
+
+  error = bh1730_read_lux(&bh1730_ctx, lux);
+  if (error) {
+    LOG_ERR(" * BH1730FVC Error %d reading lux", error);
+    return error;
+  }
+
+  return 0;
+}
+
 int poweroff_bh1730() {
   LOG_INF("Power Off BH1730FVC (Light Sensor)" SPACES);
   int error = NO_ERROR;
@@ -3,7 +3,7 @@
  *
  * File: bh1730fvc_sensor.h
  *
- * Last edited: 30.10.2025
+ * Last edited: 16.10.2026
  *
  * Copyright (c) 2025 ETH Zurich and University of Bologna
  *
@@ -29,11 +29,20 @@
 #ifndef BH1730FVC_SENSOR_H
 #define BH1730FVC_SENSOR_H
 
+#include <stdbool.h>
+#include <stdint.h>
+
 #include "bh1730fvc_reg.h"
 
 void test_bh1730fvc();
 
 int poweron_bh1730();
 int poweroff_bh1730();
+int configure_bh1730(uint32_t gain, uint8_t integration);
+uint32_t integration_bh1730();
+
+int start_bh1730();
+int ready_bh1730(bool *ready);
+int collect_bh1730(uint16_t *visible, uint16_t *ir, uint32_t *lux);
 
 #endif // BH1730FVC_SENSOR_H
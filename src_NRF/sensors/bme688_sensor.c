@@ -3,7 +3,7 @@
  *
  * File: bme688_sensor.c
  *
- * Last edited: 30.10.2025
+ * Last edited: 16.10.2026
  *
  * Copyright (c) 2025 ETH Zurich and University of Bologna
  *
@@ -26,8 +26,11 @@
  * limitations under the License.
  */
 
+#include <errno.h>
+
 #include <zephyr/device.h>
 #include <zephyr/drivers/sensor.h>
+#include <zephyr/kernel.h>
 
 #include <zephyr/drivers/gpio.h>
 
@@ -36,22 +39,46 @@
 
 #include "bme688_sensor.h"
 #include "config.h"
+#include "devpm.h"
 #include "i2c_helpers.h"
 
 static const struct device *const bme_dev = DEVICE_DT_GET_ONE(bosch_bme680);
+static const struct device *const bme_bus = DEVICE_DT_GET(DT_BUS(DT_INST(0, bosch_bme680)));
 
 #define GPIO_NODE_debug_signal_1 DT_NODELABEL(gpio_debug_signal_1)
 static const struct gpio_dt_spec gpio_debug_1 = GPIO_DT_SPEC_GET(GPIO_NODE_debug_signal_1, gpios);
 
 LOG_MODULE_DECLARE(sensors, LOG_LEVEL_INF);
 
+// The Zephyr driver blocks in sensor_sample_fetch() for the whole forced mode conversion, so the fetch is executed on
+// a dedicated work queue to let the caller continue with other sensors in the meantime.
+K_THREAD_STACK_DEFINE(bme688_stack, BME688_STACK_SIZE);
+static struct k_work_q bme688_wq;
+static struct k_work bme688_work;
+static bool bme688_wq_started = false;
+
+static atomic_t bme688_busy = ATOMIC_INIT(0);
+static int bme688_result;
+
+// The Zephyr driver transfers on its bus directly, the bus is held for the whole fetch, see devpm.h
+static void bme688_fetch(struct k_work *work) {
+  bme688_result = devpm_get(bme_bus);
+  if (bme688_result >= 0) {
+    bme688_result = sensor_sample_fetch(bme_dev);
+    devpm_put(bme_bus);
+  }
+  atomic_clear(&bme688_busy);
+}
+
 void test_bme688() {
   LOG_INF("Testing BME680 (Environmental Sensor)");
 
   struct sensor_value temp, press, humidity, gas_res;
 
   gpio_pin_toggle_dt(&gpio_debug_1);
+  devpm_get(bme_bus);
   sensor_sample_fetch(bme_dev);
+  devpm_put(bme_bus);
   sensor_channel_get(bme_dev, SENSOR_CHAN_AMBIENT_TEMP, &temp);
   sensor_channel_get(bme_dev, SENSOR_CHAN_PRESS, &press);
   sensor_channel_get(bme_dev, SENSOR_CHAN_HUMIDITY, &humidity);
@@ -62,4 +89,64 @@ void test_bme688() {
   LOG_INF(" - Pressure                            : %d.%06d kPa" SPACES, press.val1, press.val2);
   LOG_INF(" - Humidity                            : %d.%06d %%" SPACES, humidity.val1, humidity.val2);
   LOG_INF(" - Gas Resistance                      : %d.%06d ohm" SPACES, gas_res.val1, gas_res.val2);
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Starts a forced mode conversion of the BME688 in the background.
+ *
+ * @return 0 on success, -EBUSY if the previous conversion is still running
+ */
+int start_bme688() {
+  if (!bme688_wq_started) {
+    struct k_work_queue_config cfg = {.name = "bme688"};
+    k_work_queue_start(&bme688_wq, bme688_stack, K_THREAD_STACK_SIZEOF(bme688_stack), BME688_PRIORITY, &cfg);
+    k_work_init(&bme688_work, bme688_fetch);
+    bme688_wq_started = true;
+  }
+
+  if (!atomic_cas(&bme688_busy, 0, 1)) {
+    return -EBUSY;
+  }
+
+  k_work_submit_to_queue(&bme688_wq, &bme688_work);
+  return 0;
+}
+
+/**
+ * @brief Checks whether the conversion started with start_bme688() has finished.
+ *
+ * @return 0 on success, negative on error
+ */
+int ready_bme688(bool *ready) {
+  *ready = !atomic_get(&bme688_busy);
+  return 0;
+}
+
+/**
+ * @brief Reads the result of the conversion started with start_bme688().
+ *
+ * @param temperature Temperature in °C
+ * @param pressure Pressure in kPa
+ * @param humidity Relative humidity in %
+ * @param gas_resistance Gas resistance in ohm
+ * @return 0 on success, negative on error
+ */
+int collect_bme688(float *temperature, float *pressure, float *humidity, float *gas_resistance) {
+  struct sensor_value temp, press, hum, gas_res;
+
+  if (bme688_result) {
+    LOG_ERR(" * BME688 Error %d fetching sample", bme688_result);
+    return bme688_result;
+  }
+
+  sensor_channel_get(bme_dev, SENSOR_CHAN_AMBIENT_TEMP, &temp);
+  sensor_channel_get(bme_dev, SENSOR_CHAN_PRESS, &press);
+  sensor_channel_get(bme_dev, SENSOR_CHAN_HUMIDITY, &hum);
+  sensor_channel_get(bme_dev, SENSOR_CHAN_GAS_RES, &gas_res);
+
+  *temperature = temp.val1 + (temp.val2 / 1000000.0);
+  *pressure = press.val1 + (press.val2 / 1000000.0);
+  *humidity = hum.val1 + (hum.val2 / 1000000.0);
+  *gas_resistance = gas_res.val1 + (gas_res.val2 / 1000000.0);
+  return 0;
+}
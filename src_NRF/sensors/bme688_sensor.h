@@ -3,7 +3,7 @@
  *
  * File: bme688_sensor.h
  *
- * Last edited: 30.10.2025
+ * Last edited: 16.10.2026
  *
  * Copyright (c) 2025 ETH Zurich and University of Bologna
  *
@@ -29,6 +29,13 @@
 #ifndef BME688_SENSOR_H
 #define BME688_SENSOR_H
 
+#include <stdbool.h>
+#include <stdint.h>
+
 void test_bme688();
 
+int start_bme688();
+int ready_bme688(bool *ready);
+int collect_bme688(float *temperature, float *pressure, float *humidity, float *gas_resistance);
+
 #endif // BME688_SENSOR_H
\ No newline at end of file
@@ -3,7 +3,7 @@
  *
  * File: ilps28qsw_sensor.c
  *
- * Last edited: 30.10.2025
+ * Last edited: 16.10.2026
  *
  * Copyright (c) 2025 ETH Zurich and University of Bologna
  *
@@ -34,6 +34,8 @@
 #include <zephyr/logging/log_ctrl.h>
 
 #include "config.h"
+#include "drdy.h"
+#include "fmt.h"
 #include "i2c_helpers.h"
 #include "ilps28qsw_sensor.h"
 
@@ -122,12 +124,154 @@ void test_ilpS28qsw() {
 
   /* Read pressure and temperature */
   ilps28qsw_data_t data;
+  char text[FMT_FIXED_MAX_LEN + 1];
   error = ilps28qsw_data_get(&ilps28qsw_ctx, &ilps28qsw_md, &data);
   if (error) {
     LOG_ERR(" * Error %d getting data", error);
   } else {
-    LOG_INF(" - Pressure                            : %4.2f kPa" SPACES, data.pressure.hpa / 10.0);
-    LOG_INF(" - Temperature                         : %4.2f °C" SPACES, data.heat.deg_c);
+    LOG_INF(" - Pressure                            : %4s kPa" SPACES, fmt_fixed_str(text, data.pressure.hpa / 10, 2));
+    LOG_INF(" - Temperature                         : %4s °C" SPACES, fmt_fixed_str(text, data.heat.deg_c, 2));
   }
   gpio_pin_toggle_dt(&gpio_debug_1);
 }
+
+/**
+ * @brief Changes output data rate and averaging of the ILPS28QSW.
+ *
+ * The sensor passes through power-down, so the new rate applies from the next sample.
+ *
+ * @param odr Output data rate of 1, 4, 10, 25, 50, 75, 100 or 200 Hz
+ * @param avg Samples averaged per output, 4 - 512 in powers of two
+ * @return 0 on success, negative on error
+ */
+int configure_ilps28qsw(uint32_t odr, uint32_t avg) {
+  static const struct {
+    uint32_t hz;
+    uint8_t odr;
+  } odrs[] = {
+      {1, ILPS28QSW_1Hz},   {4, ILPS28QSW_4Hz},   {10, ILPS28QSW_10Hz},   {25, ILPS28QSW_25Hz},
+      {50, ILPS28QSW_50Hz}, {75, ILPS28QSW_75Hz}, {100, ILPS28QSW_100Hz}, {200, ILPS28QSW_200Hz},
+  };
+  static const struct {
+    uint32_t samples;
+    uint8_t avg;
+  } avgs[] = {
+      {4, ILPS28QSW_4_AVG},   {8, ILPS28QSW_8_AVG},     {16, ILPS28QSW_16_AVG},   {32, ILPS28QSW_32_AVG},
+      {64, ILPS28QSW_64_AVG}, {128, ILPS28QSW_128_AVG}, {256, ILPS28QSW_256_AVG}, {512, ILPS28QSW_512_AVG},
+  };
+  ilps28qsw_md_t md = ilps28qsw_md;
+  size_t i, j;
+
+  for (i = 0; i < ARRAY_SIZE(odrs); i++) {
+    if (odrs[i].hz == odr) {
+      break;
+    }
+  }
+  for (j = 0; j < ARRAY_SIZE(avgs); j++) {
+    if (avgs[j].samples == avg) {
+      break;
+    }
+  }
+  if (i == ARRAY_SIZE(odrs) || j == ARRAY_SIZE(avgs)) {
+    return -EINVAL;
+  }
+
+  ilps28qsw_i2c_ctx.i2c_handle = i2c_b;
+  ilps28qsw_i2c_ctx.i2c_addr = 0x5C;
+
+  ilps28qsw_ctx.write_reg = i2c_write_reg;
+  ilps28qsw_ctx.read_reg = i2c_read_reg;
+  ilps28qsw_ctx.handle = &ilps28qsw_i2c_ctx;
+
+  md.odr = ILPS28QSW_ONE_SHOT;
+  int32_t error = ilps28qsw_mode_set(&ilps28qsw_ctx, &md);
+  if (error) {
+    LOG_ERR(" * ILPS28QSW Error %d entering power-down", error);
+    return error;
+  }
+
+  md.odr = odrs[i].odr;
+  md.avg = avgs[j].avg;
+  md.lpf = ILPS28QSW_LPF_ODR_DIV_4;
+  md.fs = ILPS28QSW_1260hPa;
+  error = ilps28qsw_mode_set(&ilps28qsw_ctx, &md);
+  if (error) {
+    LOG_ERR(" * ILPS28QSW Error %d setting mode", error);
+    return error;
+  }
+
+  // Route data-ready to the INT pin, ready_ilps28qsw() only waits for the line when it exists
+  if (drdy_available(DRDY_ILPS28QSW)) {
+    ilps28qsw_ctrl_reg4_t ctrl_reg4;
+
+    error = ilps28qsw_read_reg(&ilps28qsw_ctx, ILPS28QSW_CTRL_REG4, (uint8_t *)&ctrl_reg4, 1);
+    if (error == 0) {
+      ctrl_reg4.drdy = PROPERTY_ENABLE;
+      ctrl_reg4.drdy_pls = PROPERTY_DISABLE;
+      error = ilps28qsw_write_reg(&ilps28qsw_ctx, ILPS28QSW_CTRL_REG4, (uint8_t *)&ctrl_reg4, 1);
+    }
+    if (error) {
+      LOG_ERR(" * ILPS28QSW Error %d routing data-ready", error);
+      return error;
+    }
+  }
+
+  ilps28qsw_md = md;
+  LOG_INF("ILPS28QSW ODR %u Hz, %u samples averaged", odr, avg);
+  return 0;
+}
+
+/**
+ * @brief Starts a conversion of the ILPS28QSW.
+ *
+ * The sensor converts continuously at the configured ODR, nothing has to be triggered.
+ *
+ * @return 0 on success, negative on error
+ */
+int start_ilps28qsw() { return 0; }
+
+/**
+ * @brief Checks whether a new pressure sample of the ILPS28QSW is available.
+ *
+ * Uses the data-ready line if available, the status register otherwise.
+ *
+ * @return 0 on success, negative on error
+ */
+int ready_ilps28qsw(bool *ready) {
+  if (drdy_available(DRDY_ILPS28QSW)) {
+    *ready = drdy_pending(DRDY_ILPS28QSW);
+    return 0;
+  }
+
+  ilps28qsw_stat_t status;
+  int32_t error = ilps28qsw_status_get(&ilps28qsw_ctx, &status);
+  if (error) {
+    LOG_ERR(" * ILPS28QSW Error %d getting status", error);
+    return error;
+  }
+
+  *ready = status.drdy_pres;
+  return 0;
+}
+
+/**
+ * @brief Reads pressure and temperature of the ILPS28QSW.
+ *
+ * @param pressure Pressure in hPa
+ * @param temperature Temperature in °C
+ * @return 0 on success, negative on error
+ */
+int collect_ilps28qsw(float *pressure, float *temperature) {
+  ilps28qsw_data_t data;
+
+  drdy_arm(DRDY_ILPS28QSW);
+  int32_t error = ilps28qsw_data_get(&ilps28qsw_ctx, &ilps28qsw_md, &data);
+  if (error) {
+    LOG_ERR(" * ILPS28QSW Error %d getting data", error);
+    return error;
+  }
+
+  *pressure = data.pressure.hpa;
+  *temperature = data.heat.deg_c;
+  return 0;
+}
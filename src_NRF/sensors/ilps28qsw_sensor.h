@@ -3,7 +3,7 @@
  *
  * File: ilps28qsw_sensor.h
  *
- * Last edited: 30.10.2025
+ * Last edited: 16.10.2026
  *
  * Copyright (c) 2025 ETH Zurich and University of Bologna
  *
@@ -29,8 +29,17 @@
 #ifndef ILPS28QSW_SENSOR_H
 #define ILPS28QSW_SENSOR_H
 
+#include <stdbool.h>
+#include <stdint.h>
+
 #include "ilps28qsw_reg.h"
 
 void test_ilpS28qsw();
 
+int configure_ilps28qsw(uint32_t odr, uint32_t avg);
+
+int start_ilps28qsw();
+int ready_ilps28qsw(bool *ready);
+int collect_ilps28qsw(float *pressure, float *temperature);
+
 #endif // ILPS28QSW_SENSOR_H
\ No newline at end of file
@@ -34,6 +34,7 @@
 #include <zephyr/logging/log_ctrl.h>
 
 #include "config.h"
+#include "fmt.h"
 #include "i2c_helpers.h"
 #include "ism330dhcx_sensor.h"
 
@@ -180,6 +181,7 @@ void test_ism330dhcx() {
   float sensitivity = 0.0f;
   int16_t data_raw[3];
   float Acceleration[3];
+  char text[FMT_FIXED_MAX_LEN + 1];
 
   /* Get accelerometer sensitivity */
   error = ism330dhcx_xl_sensitivity(&ism330dhcx_ctx, &sensitivity);
@@ -199,9 +201,9 @@ void test_ism330dhcx() {
   Acceleration[1] = (data_raw[1] * sensitivity);
   Acceleration[2] = (data_raw[2] * sensitivity);
 
-  LOG_INF(" - Acceleration X                      : % 7.2f mg" SPACES, Acceleration[0]);
-  LOG_INF(" - Acceleration Y                      : % 7.2f mg" SPACES, Acceleration[1]);
-  LOG_INF(" - Acceleration Z                      : % 7.2f mg" SPACES, Acceleration[2]);
+  LOG_INF(" - Acceleration X                      : %7s mg" SPACES, fmt_fixed_str(text, Acceleration[0], 2));
+  LOG_INF(" - Acceleration Y                      : %7s mg" SPACES, fmt_fixed_str(text, Acceleration[1], 2));
+  LOG_INF(" - Acceleration Z                      : %7s mg" SPACES, fmt_fixed_str(text, Acceleration[2], 2));
 
   /* Get gyroscope sensitivity */
   error = ism330dhcx_gy_sensitivity(&ism330dhcx_ctx, &sensitivity);
@@ -221,8 +223,8 @@ void test_ism330dhcx() {
   Gyroscope[1] = (data_raw[1] * sensitivity);
   Gyroscope[2] = (data_raw[2] * sensitivity);
 
-  LOG_INF(" - Gyroscope X                         : % 10.2f °/s" SPACES, Gyroscope[0] / 1000.f);
-  LOG_INF(" - Gyroscope Y                         : % 10.2f °/s" SPACES, Gyroscope[1] / 1000.f);
-  LOG_INF(" - Gyroscope Z                         : % 10.2f °/s" SPACES, Gyroscope[2] / 1000.f);
+  LOG_INF(" - Gyroscope X                         : %10s °/s" SPACES, fmt_fixed_str(text, Gyroscope[0] / 1000.f, 2));
+  LOG_INF(" - Gyroscope Y                         : %10s °/s" SPACES, fmt_fixed_str(text, Gyroscope[1] / 1000.f, 2));
+  LOG_INF(" - Gyroscope Z                         : %10s °/s" SPACES, fmt_fixed_str(text, Gyroscope[2] / 1000.f, 2));
   gpio_pin_toggle_dt(&gpio_debug_1);
 }
\ No newline at end of file
@@ -34,6 +34,7 @@
 #include <zephyr/logging/log_ctrl.h>
 
 #include "config.h"
+#include "fmt.h"
 #include "i2c_helpers.h"
 #include "lis2duxs12_sensor.h"
 
@@ -102,13 +103,14 @@ void test_lis2duxs12() {
   }
 
   lis2duxs12_xl_data_t data_xl;
+  char text[FMT_FIXED_MAX_LEN + 1];
   error = lis2duxs12_xl_data_get(&lis2duxs12_ctx, &md, &data_xl);
   if (error != NO_ERROR) {
     LOG_ERR(" * Error %d getting data", error);
   } else {
-    LOG_INF(" - Acceleration X                      : % 7.2f mg" SPACES, data_xl.mg[0]);
-    LOG_INF(" - Acceleration Y                      : % 7.2f mg" SPACES, data_xl.mg[1]);
-    LOG_INF(" - Acceleration Z                      : % 7.2f mg" SPACES, data_xl.mg[2]);
+    LOG_INF(" - Acceleration X                      : %7s mg" SPACES, fmt_fixed_str(text, data_xl.mg[0], 2));
+    LOG_INF(" - Acceleration Y                      : %7s mg" SPACES, fmt_fixed_str(text, data_xl.mg[1], 2));
+    LOG_INF(" - Acceleration Z                      : %7s mg" SPACES, fmt_fixed_str(text, data_xl.mg[2], 2));
   }
 
   lis2duxs12_outt_data_t data_temp;
@@ -116,7 +118,7 @@ void test_lis2duxs12() {
   if (error != NO_ERROR) {
     LOG_ERR(" * Error %d getting temperature", error);
   } else {
-    LOG_INF(" - Temperature                         : %3.2f °C" SPACES, data_temp.heat.deg_c);
+    LOG_INF(" - Temperature                         : %3s °C" SPACES, fmt_fixed_str(text, data_temp.heat.deg_c, 2));
   }
   gpio_pin_toggle_dt(&gpio_debug_1);
 }
\ No newline at end of file
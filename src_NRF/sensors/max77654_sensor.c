@@ -32,6 +32,7 @@
 #include <zephyr/logging/log_ctrl.h>
 
 #include "config.h"
+#include "devpm.h"
 #include "i2c_helpers.h"
 #include "max77654_sensor.h"
 
@@ -39,6 +40,8 @@
 
 LOG_MODULE_DECLARE(sensors, LOG_LEVEL_INF);
 
+static const struct device *const i2c_a = DEVICE_DT_GET(DT_ALIAS(i2ca));
+
 void test_max77654() {
   LOG_INF("Testing MAX77654 (PMIC)" SPACES);
 
@@ -78,6 +81,7 @@ void test_max77654() {
   for (uint32_t i = 0; i < sizeof(value_names) / sizeof(value_names[0]); i++) {
     if (max77654_measure(&pmic_h, value_names[i].index, &value) != E_MAX77654_SUCCESS) {
       LOG_ERR(" * PMIC measure failed!");
+      k_mutex_unlock(&pwr_mutex);
       return;
     }
     LOG_INF(" - %s: %i %s" SPACES, value_names[i].name, value, value_names[i].unit);
@@ -85,3 +89,43 @@ void test_max77654() {
 
   k_mutex_unlock(&pwr_mutex);
 }
+
+/**
+ * @brief Measures the supply and battery channels used by the energy meter.
+ *
+ * The PMIC is shared with the power management, the measurement holds pwr_mutex and a reference on its bus.
+ *
+ * @param vsys VSYS voltage in mV
+ * @param vbat Battery voltage in mV
+ * @param charge Battery charge current in % of the fast-charge current
+ * @param discharge Battery discharge current in mA, measured with the given full scale range
+ */
+int measure_max77654(int *vsys, int *vbat, int *charge, int *discharge, int discharge_range) {
+  const struct {
+    int index;
+    int *value;
+  } channels[] = {
+      {MAX77654_VSYS, vsys},
+      {MAX77654_BATT_V, vbat},
+      {MAX77654_BATT_I_CHG, charge},
+      {discharge_range, discharge},
+  };
+  int error = devpm_get(i2c_a);
+
+  if (error < 0) {
+    return error;
+  }
+  error = NO_ERROR;
+  k_mutex_lock(&pwr_mutex, K_FOREVER);
+  for (size_t i = 0; i < ARRAY_SIZE(channels); i++) {
+    if (max77654_measure(&pmic_h, channels[i].index, channels[i].value) != E_MAX77654_SUCCESS) {
+      LOG_ERR(" * MAX77654 Error measuring channel %d", channels[i].index);
+      error = -EIO;
+      break;
+    }
+  }
+  k_mutex_unlock(&pwr_mutex);
+  devpm_put(i2c_a);
+
+  return error;
+}
@@ -33,4 +33,6 @@
 
 void test_max77654();
 
+int measure_max77654(int *vsys, int *vbat, int *charge, int *discharge, int discharge_range);
+
 #endif // MAX77654_SENSOR_H
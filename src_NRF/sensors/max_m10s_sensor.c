@@ -81,7 +81,7 @@ bool keepGoingCallback(uDeviceHandle_t devHandle) {
   }
 
   int32_t time_diff = time_now - firstTime;
-  LOG_DBG("MAX-M10S keep going callback: %8.1fs", (float)time_diff / 1000);
+  LOG_DBG("MAX-M10S keep going callback: %6d ms", time_diff);
 
   // Return false after 20s timeout
   if (time_diff > MAX_M10S_TIMEOUT) {
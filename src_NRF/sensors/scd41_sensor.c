@@ -3,7 +3,7 @@
  *
  * File: scd41_sensor.c
  *
- * Last edited: 30.10.2025
+ * Last edited: 16.10.2026
  *
  * Copyright (c) 2025 ETH Zurich and University of Bologna
  *
@@ -34,6 +34,7 @@
 #include <zephyr/logging/log_ctrl.h>
 
 #include "config.h"
+#include "fmt.h"
 #include "i2c_helpers.h"
 #include "scd41_sensor.h"
 
@@ -48,6 +49,9 @@ static const struct gpio_dt_spec gpio_I2C_SCD41_EN = GPIO_DT_SPEC_GET(GPIO_NODE_
 #define GPIO_NODE_debug_signal_1 DT_NODELABEL(gpio_debug_signal_1)
 static const struct gpio_dt_spec gpio_debug_1 = GPIO_DT_SPEC_GET(GPIO_NODE_debug_signal_1, gpios);
 
+static bool scd41_single_shot = false;
+static int64_t scd41_start_time = 0;
+
 void test_scd41() {
   LOG_INF("Testing SCD41 (CO2 Sensor)" SPACES);
 
@@ -104,13 +108,15 @@ void test_scd41() {
   uint16_t co2_concentration;
   uint32_t temperature;
   uint32_t relative_humidity;
+  char text[FMT_FIXED_MAX_LEN + 1];
   error = scd4x_read_measurement(&co2_concentration, &temperature, &relative_humidity);
   if (error != NO_ERROR) {
     LOG_ERR(" * Error %d reading measurement", error);
   } else {
     LOG_INF(" - CO2                                 : %u ppm" SPACES, co2_concentration);
-    LOG_INF(" - Temperature                         : %.2f °C" SPACES, (float)(temperature / 1000.0f));
-    LOG_INF(" - Humidity                            : %.2f %% RH" SPACES, (float)(relative_humidity / 1000.0f));
+    LOG_INF(" - Temperature                         : %s °C" SPACES, fmt_fixed_str(text, temperature / 1000.0f, 2));
+    LOG_INF(" - Humidity                            : %s %% RH" SPACES,
+            fmt_fixed_str(text, relative_humidity / 1000.0f, 2));
   }
   gpio_pin_toggle_dt(&gpio_debug_1);
 }
@@ -118,7 +124,6 @@ void test_scd41() {
 int poweron_scd41() {
   LOG_INF("Power On SCD41 (CO2 Sensor)" SPACES);
 
-  int16_t error_i16 = NO_ERROR;
   int32_t error_i32 = NO_ERROR;
 
   // Power up SCD41
@@ -137,11 +142,19 @@ int poweron_scd41() {
     return -1;
   }
 
-  // Wait for I2C bus to be ready
-  k_msleep(100);
+  return 0;
+}
+
+/**
+ * @brief Brings up the SCD41 once the supply and the bus have settled after poweron_scd41().
+ *
+ * @return 0 on success, negative on error
+ */
+int init_scd41() {
+  int16_t error_i16 = NO_ERROR;
 
   // Initialize SCD41 driver
-  scd4x_init(0x62);
+  scd4x_init(SCD41_I2C_ADDR);
 
   // Wait for SCD41 to be ready
   error_i16 = scd4x_wake_up();
@@ -152,16 +165,113 @@ int poweron_scd41() {
   return 0;
 }
 
+/**
+ * @brief Selects the periodic or the single-shot measurement mode.
+ *
+ * Takes effect with the next configure_scd41(), the sensor has to be idle or powered off.
+ */
+void single_shot_scd41(bool enable) { scd41_single_shot = enable; }
+
+/**
+ * @brief Starts the periodic measurement, in single-shot mode the first measurement after power-up.
+ *
+ * The first single-shot reading after waking up the sensor is not valid, its conversion is the warm-up of a gated
+ * SCD41 and the result is never read.
+ *
+ * @return 0 on success, negative on error
+ */
+int configure_scd41() {
+  if (!scd41_single_shot) {
+    return scd4x_start_periodic_measurement();
+  }
+  return start_scd41();
+}
+
+/**
+ * @brief Returns the conversion time of the selected mode, 0 in periodic mode where the sensor converts on its own.
+ *
+ */
+uint32_t conversion_scd41() { return scd41_single_shot ? SCD41_SINGLE_SHOT_TIME : 0; }
+
+/**
+ * @brief Starts a conversion of the SCD41.
+ *
+ * In periodic measurement mode the sensor converts on its own 5s clock, nothing has to be triggered. A single shot is
+ * started without the 5s sleep of scd4x_measure_single_shot().
+ *
+ * @return 0 on success, negative on error
+ */
+int start_scd41() {
+  uint8_t buffer[2];
+
+  if (!scd41_single_shot) {
+    return 0;
+  }
+
+  uint16_t offset = sensirion_i2c_add_command_to_buffer(&buffer[0], 0, SCD41_CMD_MEASURE_SINGLE_SHOT);
+  int16_t error = sensirion_i2c_write_data(SCD41_I2C_ADDR, &buffer[0], offset);
+  if (error != NO_ERROR) {
+    LOG_ERR(" * SCD41 Error %d starting single shot", error);
+    return error;
+  }
+
+  scd41_start_time = k_uptime_get();
+  return 0;
+}
+
+/**
+ * @brief Checks whether a new measurement of the SCD41 is available.
+ *
+ * The sensor does not acknowledge any command while a single shot is converting, so the status is only read after
+ * the conversion time.
+ *
+ * @return 0 on success, negative on error
+ */
+int ready_scd41(bool *ready) {
+  if (scd41_single_shot && (k_uptime_get() - scd41_start_time) < SCD41_SINGLE_SHOT_TIME) {
+    *ready = false;
+    return 0;
+  }
+
+  int16_t error = scd4x_get_data_ready_status(ready);
+  if (error != NO_ERROR) {
+    LOG_ERR(" * SCD41 Error %d getting data ready status", error);
+    return error;
+  }
+  return 0;
+}
+
+/**
+ * @brief Reads the measurement of the SCD41.
+ *
+ * @param co2 CO2 concentration in ppm
+ * @param temperature Temperature in °C
+ * @param humidity Relative humidity in %
+ * @return 0 on success, negative on error
+ */
+int collect_scd41(uint16_t *co2, float *temperature, float *humidity) {
+  int32_t temperature_m_deg_c, humidity_m_percent_rh;
+
+  int16_t error = scd4x_read_measurement(co2, &temperature_m_deg_c, &humidity_m_percent_rh);
+  if (error != NO_ERROR) {
+    LOG_ERR(" * SCD41 Error %d reading measurement", error);
+    return error;
+  }
+
+  *temperature = temperature_m_deg_c / 1000.0f;
+  *humidity = humidity_m_percent_rh / 1000.0f;
+  return 0;
+}
+
 int poweroff_scd41() {
   int16_t error = NO_ERROR;
 
   LOG_INF("Power Off SCD41 (CO2 Sensor)" SPACES);
 
+  // The supply is cut even if the sensor does not respond, this is how a hung sensor is recovered
   error = scd4x_power_down();
   if (error != NO_ERROR) {
     LOG_ERR(" * Error %d powering down SCD41", error);
-    k_msleep(1000);
-    return -1;
   }
 
   // Power down SCD41
@@ -177,5 +287,5 @@ int poweroff_scd41() {
     return -1;
   }
 
-  return 0;
+  return error != NO_ERROR ? -1 : 0;
 }
@@ -3,7 +3,7 @@
  *
  * File: scd41_sensor.h
  *
- * Last edited: 30.10.2025
+ * Last edited: 16.10.2026
  *
  * Copyright (c) 2025 ETH Zurich and University of Bologna
  *
@@ -29,14 +29,30 @@
 #ifndef SCD41_SENSOR_H
 #define SCD41_SENSOR_H
 
+#include <stdbool.h>
+#include <stdint.h>
+
 #include "sensirion_common.h"
 #include "sensirion_i2c.h"
 #include "sensirion_i2c_hal.h"
 
 #include "scd4x_i2c.h"
 
+#define SCD41_I2C_ADDR 0x62
+#define SCD41_CMD_MEASURE_SINGLE_SHOT 0x219D
+#define SCD41_SINGLE_SHOT_TIME 5000 // ms, the sensor does not respond meanwhile
+
 void test_scd41();
 int poweron_scd41();
+int init_scd41();
 int poweroff_scd41();
 
+void single_shot_scd41(bool enable);
+int configure_scd41();
+uint32_t conversion_scd41();
+
+int start_scd41();
+int ready_scd41(bool *ready);
+int collect_scd41(uint16_t *co2, float *temperature, float *humidity);
+
 #endif // SCD41_SENSOR_H
\ No newline at end of file
@@ -3,7 +3,7 @@
  *
  * File: sgp41_sensor.c
  *
- * Last edited: 30.10.2025
+ * Last edited: 16.10.2026
  *
  * Copyright (c) 2025 ETH Zurich and University of Bologna
  *
@@ -46,6 +46,8 @@ static const struct gpio_dt_spec gpio_debug_1 = GPIO_DT_SPEC_GET(GPIO_NODE_debug
 
 LOG_MODULE_DECLARE(sensors, LOG_LEVEL_INF);
 
+static int64_t sgp41_start_time;
+
 void test_sgp41() {
   LOG_INF("Testing SGP41 (VOC Sensor)" SPACES);
 
@@ -96,6 +98,64 @@ void test_sgp41() {
   gpio_pin_toggle_dt(&gpio_debug_1);
 }
 
+/**
+ * @brief Sends the measure raw signals command without waiting for the result.
+ *
+ * Same as sgp41_measure_raw_signals(), but the 50ms conversion is not spent sleeping in the I2C HAL.
+ *
+ * @param relative_humidity Compensation humidity in ticks
+ * @param temperature Compensation temperature in ticks
+ * @return 0 on success, negative on error
+ */
+int start_sgp41(uint16_t relative_humidity, uint16_t temperature) {
+  uint8_t buffer[8];
+  uint16_t offset = 0;
+
+  offset = sensirion_i2c_add_command_to_buffer(&buffer[0], offset, SGP41_CMD_MEASURE_RAW_SIGNALS);
+  offset = sensirion_i2c_add_uint16_t_to_buffer(&buffer[0], offset, relative_humidity);
+  offset = sensirion_i2c_add_uint16_t_to_buffer(&buffer[0], offset, temperature);
+
+  int16_t error = sensirion_i2c_write_data(SGP41_I2C_ADDR, &buffer[0], offset);
+  if (error != NO_ERROR) {
+    LOG_ERR(" * SGP41 Error %d starting measurement", error);
+    return error;
+  }
+
+  sgp41_start_time = k_uptime_get();
+  return 0;
+}
+
+/**
+ * @brief Checks whether the conversion started with start_sgp41() has finished.
+ *
+ * The SGP41 has no status register, the conversion time is fixed.
+ *
+ * @return 0 on success, negative on error
+ */
+int ready_sgp41(bool *ready) {
+  *ready = (k_uptime_get() - sgp41_start_time) >= SGP41_MEASURE_TIME;
+  return 0;
+}
+
+/**
+ * @brief Reads the raw signals of the conversion started with start_sgp41().
+ *
+ * @return 0 on success, negative on error
+ */
+int collect_sgp41(uint16_t *sraw_voc, uint16_t *sraw_nox) {
+  uint8_t buffer[6];
+
+  int16_t error = sensirion_i2c_read_data_inplace(SGP41_I2C_ADDR, &buffer[0], 4);
+  if (error != NO_ERROR) {
+    LOG_ERR(" * SGP41 Error %d reading signals", error);
+    return error;
+  }
+
+  *sraw_voc = sensirion_common_bytes_to_uint16_t(&buffer[0]);
+  *sraw_nox = sensirion_common_bytes_to_uint16_t(&buffer[2]);
+  return 0;
+}
+
 int poweron_sgp41() {
   LOG_INF("Power On SGP41 (VOC Sensor)" SPACES);
 
@@ -111,8 +171,6 @@ int poweron_sgp41() {
     k_msleep(1000);
     return -1;
   }
-  // Wait for I2C bus to be ready
-  k_msleep(100);
 
   return 0;
 }
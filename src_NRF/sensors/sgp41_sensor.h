@@ -3,7 +3,7 @@
  *
  * File: sgp41_sensor.h
  *
- * Last edited: 30.10.2025
+ * Last edited: 16.10.2026
  *
  * Copyright (c) 2025 ETH Zurich and University of Bologna
  *
@@ -29,14 +29,26 @@
 #ifndef SGP41_SENSOR_H
 #define SGP41_SENSOR_H
 
+#include <stdbool.h>
+#include <stdint.h>
+
 #include "sensirion_common.h"
 #include "sensirion_i2c.h"
 #include "sensirion_i2c_hal.h"
 
 #include "sgp41_i2c.h"
 
+#define SGP41_I2C_ADDR 0x59
+#define SGP41_CMD_MEASURE_RAW_SIGNALS 0x2619
+#define SGP41_MEASURE_TIME 50         // ms
+#define SGP41_CONDITIONING_TIME 10000 // ms, heater conditioning after power-up
+
 void test_sgp41();
 int poweroff_sgp41();
 int poweron_sgp41();
 
+int start_sgp41(uint16_t relative_humidity, uint16_t temperature);
+int ready_sgp41(bool *ready);
+int collect_sgp41(uint16_t *sraw_voc, uint16_t *sraw_nox);
+
 #endif // SGP41_SENSOR_H
\ No newline at end of file
@@ -0,0 +1,275 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: emul_as7331.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#define DT_DRV_COMPAT sensei_as7331
+
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/emul.h>
+#include <zephyr/drivers/i2c_emul.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+
+#include "emul_sensor.h"
+
+// Configuration state, 8 bit registers
+#define AS7331_EMUL_OSR 0x00
+#define AS7331_EMUL_AGEN 0x02
+#define AS7331_EMUL_CREG1 0x06
+#define AS7331_EMUL_CREG3 0x08
+#define AS7331_EMUL_CONFIG_REGS 0x0C
+
+// Measurement state, 16 bit registers mapped to bytes from AS7331_EMUL_OUT
+#define AS7331_EMUL_OUT 0x80
+#define AS7331_EMUL_OUT_STATUS 1
+#define AS7331_EMUL_OUT_TEMP 2
+#define AS7331_EMUL_OUT_MRES1 4
+#define AS7331_EMUL_OUT_SIZE 16
+
+#define AS7331_EMUL_DOS_MASK 0x07 // OSR
+#define AS7331_EMUL_DOS_CONFIG 0x02
+#define AS7331_EMUL_DOS_MEASURE 0x03
+#define AS7331_EMUL_SW_RES BIT(3)
+#define AS7331_EMUL_PD BIT(6)
+#define AS7331_EMUL_SS BIT(7)
+#define AS7331_EMUL_POWERSTATE BIT(0) // STATUS
+#define AS7331_EMUL_NOTREADY BIT(2)
+#define AS7331_EMUL_NDATA BIT(3)
+#define AS7331_EMUL_LDATA BIT(4)
+#define AS7331_EMUL_MRESOF BIT(6)
+
+#define AS7331_EMUL_MMODE_CMD 0x00
+
+// Irradiance of the modelled source per channel, scaled to counts at gain 11 and 1 ms conversion time
+#define AS7331_EMUL_UVA 500.0f
+#define AS7331_EMUL_UVB 150.0f
+#define AS7331_EMUL_UVC 20.0f
+
+static const uint8_t as7331_emul_defaults[AS7331_EMUL_CONFIG_REGS] = {
+    [AS7331_EMUL_OSR] = AS7331_EMUL_PD | AS7331_EMUL_DOS_CONFIG,
+    [AS7331_EMUL_AGEN] = 0x21,
+    [AS7331_EMUL_CREG1] = 0xA6,
+    [0x07] = 0x40,
+    [AS7331_EMUL_CREG3] = 0x50,
+    [0x09] = 0x19,
+    [0x0A] = 0x01,
+    [0x0B] = 0x71,
+};
+
+struct as7331_emul_data {
+  const struct emul *target;
+  struct k_timer timer;
+  struct k_spinlock lock;
+  uint8_t regs[AS7331_EMUL_CONFIG_REGS];
+  uint8_t status;
+  uint8_t out[AS7331_EMUL_OUT_SIZE];
+  uint32_t seed;
+};
+
+struct as7331_emul_cfg {
+  struct gpio_dt_spec bus;
+  struct gpio_dt_spec ready;
+};
+
+static bool as7331_emul_measuring(struct as7331_emul_data *data) {
+  return (data->regs[AS7331_EMUL_OSR] & AS7331_EMUL_DOS_MASK) == AS7331_EMUL_DOS_MEASURE;
+}
+
+static void as7331_emul_reset(struct as7331_emul_data *data) {
+  k_timer_stop(&data->timer);
+  memcpy(data->regs, as7331_emul_defaults, sizeof(data->regs));
+  memset(data->out, 0, sizeof(data->out));
+  data->status = AS7331_EMUL_POWERSTATE;
+}
+
+/**
+ * @brief Returns the conversion time of 2^TIME clock periods of 1.024 MHz, shorter with a faster CCLK.
+ *
+ */
+static uint32_t as7331_emul_conversion_us(struct as7331_emul_data *data) {
+  uint8_t time = data->regs[AS7331_EMUL_CREG1] & 0x0F;
+  uint8_t cclk = data->regs[AS7331_EMUL_CREG3] & 0x03;
+
+  return (1000U << time) >> cclk;
+}
+
+static uint16_t as7331_emul_counts(struct as7331_emul_data *data, float irradiance) {
+  uint8_t gain = data->regs[AS7331_EMUL_CREG1] >> 4;
+  float counts = irradiance * (1U << (11 - MIN(gain, 11))) * (as7331_emul_conversion_us(data) / 1000.0f) / 1024.0f;
+
+  if (counts >= UINT16_MAX) {
+    data->status |= AS7331_EMUL_MRESOF;
+    return UINT16_MAX;
+  }
+  return (uint16_t)MAX(counts, 0.0f);
+}
+
+/**
+ * @brief Completes a conversion, latches the results and raises READY.
+ *
+ */
+static void as7331_emul_sample(struct k_timer *timer) {
+  struct as7331_emul_data *data = CONTAINER_OF(timer, struct as7331_emul_data, timer);
+  const struct as7331_emul_cfg *cfg = data->target->cfg;
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+  float temperature = emul_wave(28.0f, 1.0f, 3600, 1200) + emul_noise(&data->seed, 0.05f);
+  float uv = emul_wave(1.0f, 0.5f, 1800, 0);
+
+  sys_put_le16((uint16_t)((temperature + 66.9f) / 0.05f), &data->out[AS7331_EMUL_OUT_TEMP]);
+  for (int i = 0; i < 3; i++) {
+    static const float irradiance[] = {AS7331_EMUL_UVA, AS7331_EMUL_UVB, AS7331_EMUL_UVC};
+    float value = irradiance[i] * uv + emul_noise(&data->seed, irradiance[i] / 100.0f);
+
+    sys_put_le16(as7331_emul_counts(data, value), &data->out[AS7331_EMUL_OUT_MRES1 + 2 * i]);
+  }
+
+  if (data->status & AS7331_EMUL_NDATA) {
+    data->status |= AS7331_EMUL_LDATA;
+  }
+  data->status = (data->status & ~AS7331_EMUL_NOTREADY) | AS7331_EMUL_NDATA;
+  data->regs[AS7331_EMUL_OSR] &= ~AS7331_EMUL_SS;
+  k_spin_unlock(&data->lock, key);
+
+  emul_line_drive(&cfg->ready, true);
+}
+
+static void as7331_emul_write_osr(struct as7331_emul_data *data, uint8_t value) {
+  const struct as7331_emul_cfg *cfg = data->target->cfg;
+  uint8_t dos = value & AS7331_EMUL_DOS_MASK;
+
+  if (value & AS7331_EMUL_SW_RES) {
+    as7331_emul_reset(data);
+    return;
+  }
+  // Only the configuration and measurement state are valid, the state is kept otherwise
+  if (dos != AS7331_EMUL_DOS_CONFIG && dos != AS7331_EMUL_DOS_MEASURE) {
+    value = (value & ~AS7331_EMUL_DOS_MASK) | (data->regs[AS7331_EMUL_OSR] & AS7331_EMUL_DOS_MASK);
+  }
+  data->regs[AS7331_EMUL_OSR] = value;
+  WRITE_BIT(data->status, 0, value & AS7331_EMUL_PD);
+
+  if ((value & AS7331_EMUL_SS) && !(value & AS7331_EMUL_PD) && as7331_emul_measuring(data) &&
+      (data->regs[AS7331_EMUL_CREG3] >> 6) == AS7331_EMUL_MMODE_CMD) {
+    data->status |= AS7331_EMUL_NOTREADY;
+    emul_line_drive(&cfg->ready, false);
+    k_timer_start(&data->timer, K_USEC(as7331_emul_conversion_us(data)), K_NO_WAIT);
+  }
+}
+
+/**
+ * @brief Maps the register address, in measurement state every address selects a 16 bit result.
+ *
+ */
+static uint8_t as7331_emul_pointer(const struct emul *target, uint8_t byte) {
+  struct as7331_emul_data *data = target->data;
+
+  return as7331_emul_measuring(data) ? AS7331_EMUL_OUT + 2 * MIN(byte, AS7331_EMUL_OUT_SIZE / 2) : byte;
+}
+
+static uint8_t as7331_emul_read(const struct emul *target, uint8_t reg) {
+  struct as7331_emul_data *data = target->data;
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+  uint8_t value = 0;
+
+  if (reg >= AS7331_EMUL_OUT) {
+    uint8_t offset = reg - AS7331_EMUL_OUT;
+
+    if (offset == 0) {
+      value = data->regs[AS7331_EMUL_OSR];
+    } else if (offset == AS7331_EMUL_OUT_STATUS) {
+      value = data->status;
+    } else if (offset < AS7331_EMUL_OUT_SIZE) {
+      value = data->out[offset];
+      // Reading the results clears the new data and overwrite flags
+      data->status &= ~(AS7331_EMUL_NDATA | AS7331_EMUL_LDATA | AS7331_EMUL_MRESOF);
+    }
+  } else if (reg < AS7331_EMUL_CONFIG_REGS) {
+    value = data->regs[reg];
+  }
+  k_spin_unlock(&data->lock, key);
+  return value;
+}
+
+static void as7331_emul_write(const struct emul *target, uint8_t reg, uint8_t value) {
+  struct as7331_emul_data *data = target->data;
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+  if (reg == AS7331_EMUL_OSR || reg == AS7331_EMUL_OUT) {
+    as7331_emul_write_osr(data, value);
+  } else if (reg < AS7331_EMUL_CONFIG_REGS && reg != AS7331_EMUL_AGEN) {
+    // The configuration registers are written in configuration state only
+    if (!as7331_emul_measuring(data)) {
+      data->regs[reg] = value;
+    }
+  }
+  k_spin_unlock(&data->lock, key);
+}
+
+static bool as7331_emul_present(const struct emul *target) {
+  const struct as7331_emul_cfg *cfg = target->cfg;
+
+  return emul_line_on(&cfg->bus);
+}
+
+static const emul_regmap_api_t as7331_emul_regmap = {
+    .pointer = as7331_emul_pointer,
+    .read = as7331_emul_read,
+    .write = as7331_emul_write,
+    .present = as7331_emul_present,
+};
+
+static int as7331_emul_transfer(const struct emul *target, struct i2c_msg *msgs, int num_msgs, int addr) {
+  return emul_regmap_transfer(target, &as7331_emul_regmap, msgs, num_msgs);
+}
+
+static const struct i2c_emul_api as7331_emul_api = {
+    .transfer = as7331_emul_transfer,
+};
+
+static int as7331_emul_init(const struct emul *target, const struct device *parent) {
+  struct as7331_emul_data *data = target->data;
+
+  data->target = target;
+  data->seed = 0xA5733;
+  k_timer_init(&data->timer, as7331_emul_sample, NULL);
+  as7331_emul_reset(data);
+  return 0;
+}
+
+#define AS7331_EMUL(n)                                                                                                 \
+  static struct as7331_emul_data as7331_emul_data_##n;                                                                 \
+  static const struct as7331_emul_cfg as7331_emul_cfg_##n = {                                                          \
+      .bus = EMUL_LINE(gpio_ext_i2c_as7331_en),                                                                        \
+      .ready = EMUL_LINE(gpio_ext_as7331_ready),                                                                       \
+  };                                                                                                                   \
+  EMUL_DT_INST_DEFINE(n, as7331_emul_init, &as7331_emul_data_##n, &as7331_emul_cfg_##n, &as7331_emul_api, NULL)
+
+DT_INST_FOREACH_STATUS_OKAY(AS7331_EMUL)
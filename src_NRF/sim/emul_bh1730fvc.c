@@ -0,0 +1,186 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: emul_bh1730fvc.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#define DT_DRV_COMPAT sensei_bh1730fvc
+
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/emul.h>
+#include <zephyr/drivers/i2c_emul.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+
+#include "emul_sensor.h"
+
+#define BH1730_EMUL_CONTROL 0x00
+#define BH1730_EMUL_TIMING 0x01
+#define BH1730_EMUL_TH_UP 0x05
+#define BH1730_EMUL_GAIN 0x07
+#define BH1730_EMUL_ID 0x12
+#define BH1730_EMUL_DATA0 0x14
+#define BH1730_EMUL_DATA1 0x16
+#define BH1730_EMUL_SINK 0x1F // Pointer of a special command, writes and reads go nowhere
+
+#define BH1730_EMUL_CMD BIT(7) // Command byte
+#define BH1730_EMUL_SPECIAL (BIT(6) | BIT(5))
+#define BH1730_EMUL_SOFT_RESET 0x04
+#define BH1730_EMUL_POWER BIT(0) // CONTROL
+#define BH1730_EMUL_ADC_EN BIT(1)
+#define BH1730_EMUL_ONE_TIME BIT(3)
+#define BH1730_EMUL_ADC_VALID BIT(4)
+#define BH1730_EMUL_READ_ONLY (BIT(4) | BIT(5))
+
+#define BH1730_EMUL_PART_ID 0x70
+#define BH1730_EMUL_ITIME_DEFAULT 0xDA
+#define BH1730_EMUL_STEP_NS 2699200    // Integration time per ITIME step, 964 cycles of the 2.8us internal clock
+#define BH1730_EMUL_IR_RATIO 0.2f      // DATA1 / DATA0 of the modelled light source
+#define BH1730_EMUL_LUX_FACTOR 0.7434f // 1.290 - 2.733 * IR ratio, lux formula of the datasheet for a ratio < 0.26
+
+static const uint8_t bh1730_emul_gain[] = {1, 2, 64, 128};
+
+struct bh1730_emul_data {
+  struct k_timer timer;
+  struct k_spinlock lock;
+  uint8_t regs[BH1730_EMUL_SINK + 1];
+  uint32_t seed;
+};
+
+static void bh1730_emul_reset(struct bh1730_emul_data *data) {
+  k_timer_stop(&data->timer);
+  memset(data->regs, 0, sizeof(data->regs));
+  data->regs[BH1730_EMUL_TIMING] = BH1730_EMUL_ITIME_DEFAULT;
+  data->regs[BH1730_EMUL_TH_UP] = 0xFF;
+  data->regs[BH1730_EMUL_TH_UP + 1] = 0xFF;
+  data->regs[BH1730_EMUL_ID] = BH1730_EMUL_PART_ID;
+}
+
+static uint32_t bh1730_emul_integration_us(struct bh1730_emul_data *data) {
+  return (256U - data->regs[BH1730_EMUL_TIMING]) * (BH1730_EMUL_STEP_NS / 1000U);
+}
+
+/**
+ * @brief Completes an integration, latches both channels and sets ADC_VALID.
+ *
+ * The counts grow with gain and integration time, as the lux formula of the datasheet expects.
+ */
+static void bh1730_emul_sample(struct k_timer *timer) {
+  struct bh1730_emul_data *data = CONTAINER_OF(timer, struct bh1730_emul_data, timer);
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+  uint8_t *regs = data->regs;
+
+  float lux = emul_wave(300.0f, 200.0f, 900, 0) + emul_noise(&data->seed, 2.0f);
+  float scale = bh1730_emul_gain[regs[BH1730_EMUL_GAIN] & 0x03] * (bh1730_emul_integration_us(data) / 1000.0f) /
+                (BH1730_EMUL_LUX_FACTOR * 102.6f);
+  uint32_t visible = MIN((uint32_t)(MAX(lux, 0.0f) * scale), UINT16_MAX);
+
+  sys_put_le16(visible, &regs[BH1730_EMUL_DATA0]);
+  sys_put_le16((uint16_t)(visible * BH1730_EMUL_IR_RATIO), &regs[BH1730_EMUL_DATA1]);
+  regs[BH1730_EMUL_CONTROL] |= BH1730_EMUL_ADC_VALID;
+  if (regs[BH1730_EMUL_CONTROL] & BH1730_EMUL_ONE_TIME) {
+    regs[BH1730_EMUL_CONTROL] &= ~BH1730_EMUL_ADC_EN;
+    k_timer_stop(&data->timer);
+  }
+  k_spin_unlock(&data->lock, key);
+}
+
+/**
+ * @brief Decodes the command byte, a special command is executed immediately.
+ *
+ */
+static uint8_t bh1730_emul_pointer(const struct emul *target, uint8_t byte) {
+  struct bh1730_emul_data *data = target->data;
+
+  if (!(byte & BH1730_EMUL_CMD)) {
+    return BH1730_EMUL_SINK;
+  }
+  if ((byte & BH1730_EMUL_SPECIAL) == BH1730_EMUL_SPECIAL) {
+    if ((byte & 0x1F) == BH1730_EMUL_SOFT_RESET) {
+      k_spinlock_key_t key = k_spin_lock(&data->lock);
+      bh1730_emul_reset(data);
+      k_spin_unlock(&data->lock, key);
+    }
+    return BH1730_EMUL_SINK;
+  }
+  return byte & 0x1F;
+}
+
+static uint8_t bh1730_emul_read(const struct emul *target, uint8_t reg) {
+  struct bh1730_emul_data *data = target->data;
+
+  return reg < BH1730_EMUL_SINK ? data->regs[reg] : 0;
+}
+
+static void bh1730_emul_write(const struct emul *target, uint8_t reg, uint8_t value) {
+  struct bh1730_emul_data *data = target->data;
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+  if (reg == BH1730_EMUL_CONTROL) {
+    data->regs[reg] = value & ~BH1730_EMUL_READ_ONLY;
+    // Every write with the ADC enabled starts a new integration
+    if ((value & (BH1730_EMUL_POWER | BH1730_EMUL_ADC_EN)) == (BH1730_EMUL_POWER | BH1730_EMUL_ADC_EN)) {
+      k_timeout_t integration = K_USEC(bh1730_emul_integration_us(data));
+      k_timer_start(&data->timer, integration, integration);
+    } else {
+      k_timer_stop(&data->timer);
+    }
+  } else if (reg != BH1730_EMUL_ID && reg < BH1730_EMUL_DATA0) {
+    data->regs[reg] = value;
+  }
+  k_spin_unlock(&data->lock, key);
+}
+
+static const emul_regmap_api_t bh1730_emul_regmap = {
+    .pointer = bh1730_emul_pointer,
+    .read = bh1730_emul_read,
+    .write = bh1730_emul_write,
+};
+
+static int bh1730_emul_transfer(const struct emul *target, struct i2c_msg *msgs, int num_msgs, int addr) {
+  return emul_regmap_transfer(target, &bh1730_emul_regmap, msgs, num_msgs);
+}
+
+static const struct i2c_emul_api bh1730_emul_api = {
+    .transfer = bh1730_emul_transfer,
+};
+
+static int bh1730_emul_init(const struct emul *target, const struct device *parent) {
+  struct bh1730_emul_data *data = target->data;
+
+  data->seed = 0xB1730;
+  k_timer_init(&data->timer, bh1730_emul_sample, NULL);
+  bh1730_emul_reset(data);
+  return 0;
+}
+
+#define BH1730_EMUL(n)                                                                                                 \
+  static struct bh1730_emul_data bh1730_emul_data_##n;                                                                 \
+  EMUL_DT_INST_DEFINE(n, bh1730_emul_init, &bh1730_emul_data_##n, NULL, &bh1730_emul_api, NULL)
+
+DT_INST_FOREACH_STATUS_OKAY(BH1730_EMUL)
@@ -0,0 +1,240 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: emul_bme688.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#define DT_DRV_COMPAT bosch_bme680
+
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/emul.h>
+#include <zephyr/drivers/i2c_emul.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+
+#include "emul_sensor.h"
+
+#define BME688_EMUL_RES_HEAT_VAL 0x00
+#define BME688_EMUL_RES_HEAT_RANGE 0x02
+#define BME688_EMUL_RANGE_SW_ERR 0x04
+#define BME688_EMUL_FIELD0 0x1D
+#define BME688_EMUL_PRESS_MSB 0x1F
+#define BME688_EMUL_TEMP_MSB 0x22
+#define BME688_EMUL_HUM_MSB 0x25
+#define BME688_EMUL_GAS_R_MSB 0x2A
+#define BME688_EMUL_GAS_R_MSB_688 0x2C
+#define BME688_EMUL_CTRL_FIRST 0x50 // IDAC_HEAT_0
+#define BME688_EMUL_GAS_WAIT0 0x64
+#define BME688_EMUL_CTRL_GAS_1 0x71
+#define BME688_EMUL_CTRL_HUM 0x72
+#define BME688_EMUL_CTRL_MEAS 0x74
+#define BME688_EMUL_PAR_T2 0x8A
+#define BME688_EMUL_PAR_P1 0x8E
+#define BME688_EMUL_CHIP_ID 0xD0
+#define BME688_EMUL_RESET 0xE0
+#define BME688_EMUL_PAR_H2 0xE1
+#define BME688_EMUL_PAR_H1_LSB 0xE2
+#define BME688_EMUL_PAR_H1 0xE3
+#define BME688_EMUL_PAR_T1 0xE9
+#define BME688_EMUL_VARIANT_ID 0xF0
+
+#define BME688_EMUL_ID 0x61
+#define BME688_EMUL_VARIANT 0x01
+#define BME688_EMUL_SOFT_RESET 0xB6
+#define BME688_EMUL_MODE_FORCED 0x01          // CTRL_MEAS
+#define BME688_EMUL_RUN_GAS (BIT(4) | BIT(5)) // CTRL_GAS_1, BME680 and BME688 position
+#define BME688_EMUL_NEW_DATA BIT(7)           // MEAS_STATUS_0
+#define BME688_EMUL_GAS_MEASURING BIT(6)
+#define BME688_EMUL_MEASURING BIT(5)
+#define BME688_EMUL_GAS_VALID BIT(5) // GAS_R_LSB
+#define BME688_EMUL_HEAT_STAB BIT(4)
+
+// Calibration of the emulated part, the remaining coefficients are zero so the compensation inverts in closed form
+#define BME688_EMUL_T1 26000
+#define BME688_EMUL_T2 26000
+#define BME688_EMUL_P1 36000
+#define BME688_EMUL_H1 700
+#define BME688_EMUL_H2 1024
+
+#define BME688_EMUL_GAS_ADC 512
+#define BME688_EMUL_GAS_RANGE 5
+
+static const uint8_t bme688_emul_oversampling[] = {0, 1, 2, 4, 8, 16, 16, 16};
+
+struct bme688_emul_data {
+  const struct emul *target;
+  struct k_timer timer;
+  struct k_spinlock lock;
+  uint8_t regs[256];
+  uint32_t seed;
+};
+
+static void bme688_emul_reset(struct bme688_emul_data *data) {
+  uint8_t *regs = data->regs;
+
+  k_timer_stop(&data->timer);
+  memset(regs, 0, sizeof(data->regs));
+  regs[BME688_EMUL_CHIP_ID] = BME688_EMUL_ID;
+  regs[BME688_EMUL_VARIANT_ID] = BME688_EMUL_VARIANT;
+  regs[BME688_EMUL_RES_HEAT_VAL] = 0x2D;
+  regs[BME688_EMUL_RES_HEAT_RANGE] = 0x10;
+  regs[BME688_EMUL_RANGE_SW_ERR] = 0x00;
+  sys_put_le16(BME688_EMUL_T1, &regs[BME688_EMUL_PAR_T1]);
+  sys_put_le16(BME688_EMUL_T2, &regs[BME688_EMUL_PAR_T2]);
+  sys_put_le16(BME688_EMUL_P1, &regs[BME688_EMUL_PAR_P1]);
+  regs[BME688_EMUL_PAR_H1] = BME688_EMUL_H1 >> 4;
+  regs[BME688_EMUL_PAR_H1_LSB] = ((BME688_EMUL_H2 & 0x0F) << 4) | (BME688_EMUL_H1 & 0x0F);
+  regs[BME688_EMUL_PAR_H2] = BME688_EMUL_H2 >> 4;
+}
+
+/**
+ * @brief Returns the duration of a forced mode measurement, the TPH conversion followed by the heater phase.
+ *
+ */
+static uint32_t bme688_emul_duration_us(struct bme688_emul_data *data) {
+  const uint8_t *regs = data->regs;
+  uint32_t cycles = bme688_emul_oversampling[regs[BME688_EMUL_CTRL_MEAS] >> 5] +
+                    bme688_emul_oversampling[(regs[BME688_EMUL_CTRL_MEAS] >> 2) & 0x07] +
+                    bme688_emul_oversampling[regs[BME688_EMUL_CTRL_HUM] & 0x07];
+  uint32_t duration_us = cycles * 1963 + 477 * 9 + 500;
+
+  if (regs[BME688_EMUL_CTRL_GAS_1] & BME688_EMUL_RUN_GAS) {
+    uint8_t wait = regs[BME688_EMUL_GAS_WAIT0];
+
+    duration_us += ((wait & 0x3F) << (2 * (wait >> 6))) * 1000U;
+  }
+  return duration_us;
+}
+
+static void bme688_emul_put20(uint8_t *reg, uint32_t value) {
+  reg[0] = (value >> 12) & 0xFF;
+  reg[1] = (value >> 4) & 0xFF;
+  reg[2] = (value << 4) & 0xF0;
+}
+
+/**
+ * @brief Completes a forced mode measurement with the raw values that compensate to the modelled environment.
+ *
+ */
+static void bme688_emul_sample(struct k_timer *timer) {
+  struct bme688_emul_data *data = CONTAINER_OF(timer, struct bme688_emul_data, timer);
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+  uint8_t *regs = data->regs;
+
+  float temperature = emul_wave(24.0f, 1.5f, 3600, 0) + emul_noise(&data->seed, 0.01f);
+  float pressure = emul_wave(96500.0f, 200.0f, 600, 0) + emul_noise(&data->seed, 2.0f);
+  float humidity = emul_wave(45.0f, 5.0f, 3600, 1800) + emul_noise(&data->seed, 0.05f);
+
+  int32_t t_fine = (int32_t)(temperature * 5120.0f);
+  uint32_t adc_temp = (uint32_t)((int64_t)t_fine * 2048 / BME688_EMUL_T2 + 2 * BME688_EMUL_T1) << 3;
+  uint32_t adc_press = 1048576 - (uint32_t)(pressure * BME688_EMUL_P1 / 6250.0f);
+  uint32_t adc_hum = (uint32_t)(humidity * 1000.0f / 3.90625f) + BME688_EMUL_H1 * 16;
+
+  bme688_emul_put20(&regs[BME688_EMUL_PRESS_MSB], adc_press);
+  bme688_emul_put20(&regs[BME688_EMUL_TEMP_MSB], adc_temp);
+  sys_put_be16(MIN(adc_hum, UINT16_MAX), &regs[BME688_EMUL_HUM_MSB]);
+
+  uint8_t gas_lsb = ((BME688_EMUL_GAS_ADC & 0x03) << 6) | BME688_EMUL_GAS_RANGE;
+  if (regs[BME688_EMUL_CTRL_GAS_1] & BME688_EMUL_RUN_GAS) {
+    gas_lsb |= BME688_EMUL_GAS_VALID | BME688_EMUL_HEAT_STAB;
+  }
+  regs[BME688_EMUL_GAS_R_MSB] = regs[BME688_EMUL_GAS_R_MSB_688] = BME688_EMUL_GAS_ADC >> 2;
+  regs[BME688_EMUL_GAS_R_MSB + 1] = regs[BME688_EMUL_GAS_R_MSB_688 + 1] = gas_lsb;
+
+  regs[BME688_EMUL_FIELD0] = BME688_EMUL_NEW_DATA;
+  regs[BME688_EMUL_CTRL_MEAS] &= ~0x03;
+  k_spin_unlock(&data->lock, key);
+}
+
+static uint8_t bme688_emul_read(const struct emul *target, uint8_t reg) {
+  struct bme688_emul_data *data = target->data;
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+  uint8_t value = data->regs[reg];
+
+  k_spin_unlock(&data->lock, key);
+  return value;
+}
+
+static void bme688_emul_write(const struct emul *target, uint8_t reg, uint8_t value) {
+  struct bme688_emul_data *data = target->data;
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+  switch (reg) {
+  case BME688_EMUL_RESET:
+    if (value == BME688_EMUL_SOFT_RESET) {
+      bme688_emul_reset(data);
+    }
+    break;
+  case BME688_EMUL_CTRL_MEAS:
+    data->regs[reg] = value;
+    if ((value & 0x03) == BME688_EMUL_MODE_FORCED) {
+      data->regs[BME688_EMUL_FIELD0] = BME688_EMUL_MEASURING;
+      if (data->regs[BME688_EMUL_CTRL_GAS_1] & BME688_EMUL_RUN_GAS) {
+        data->regs[BME688_EMUL_FIELD0] |= BME688_EMUL_GAS_MEASURING;
+      }
+      k_timer_start(&data->timer, K_USEC(bme688_emul_duration_us(data)), K_NO_WAIT);
+    }
+    break;
+  default:
+    // Heater and control registers, identification, calibration and the measurement field are read only
+    if (reg >= BME688_EMUL_CTRL_FIRST && reg < BME688_EMUL_PAR_T2) {
+      data->regs[reg] = value;
+    }
+    break;
+  }
+  k_spin_unlock(&data->lock, key);
+}
+
+static const emul_regmap_api_t bme688_emul_regmap = {
+    .read = bme688_emul_read,
+    .write = bme688_emul_write,
+};
+
+static int bme688_emul_transfer(const struct emul *target, struct i2c_msg *msgs, int num_msgs, int addr) {
+  return emul_regmap_transfer(target, &bme688_emul_regmap, msgs, num_msgs);
+}
+
+static const struct i2c_emul_api bme688_emul_api = {
+    .transfer = bme688_emul_transfer,
+};
+
+static int bme688_emul_init(const struct emul *target, const struct device *parent) {
+  struct bme688_emul_data *data = target->data;
+
+  data->target = target;
+  data->seed = 0xB688;
+  k_timer_init(&data->timer, bme688_emul_sample, NULL);
+  bme688_emul_reset(data);
+  return 0;
+}
+
+#define BME688_EMUL(n)                                                                                                 \
+  static struct bme688_emul_data bme688_emul_data_##n;                                                                 \
+  EMUL_DT_INST_DEFINE(n, bme688_emul_init, &bme688_emul_data_##n, NULL, &bme688_emul_api, NULL)
+
+DT_INST_FOREACH_STATUS_OKAY(BME688_EMUL)
@@ -0,0 +1,228 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: emul_ilps28qsw.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#define DT_DRV_COMPAT sensei_ilps28qsw
+
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/emul.h>
+#include <zephyr/drivers/i2c_emul.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+
+#include "emul_sensor.h"
+
+#define ILPS28QSW_EMUL_WHO_AM_I 0x0F
+#define ILPS28QSW_EMUL_CTRL_REG1 0x10
+#define ILPS28QSW_EMUL_CTRL_REG2 0x11
+#define ILPS28QSW_EMUL_CTRL_REG3 0x12
+#define ILPS28QSW_EMUL_CTRL_REG4 0x13
+#define ILPS28QSW_EMUL_STATUS 0x27
+#define ILPS28QSW_EMUL_PRESS_OUT_XL 0x28
+#define ILPS28QSW_EMUL_PRESS_OUT_H 0x2A
+#define ILPS28QSW_EMUL_TEMP_OUT_L 0x2B
+#define ILPS28QSW_EMUL_TEMP_OUT_H 0x2C
+
+#define ILPS28QSW_EMUL_ID 0xB4
+#define ILPS28QSW_EMUL_IF_ADD_INC BIT(0) // CTRL_REG3
+#define ILPS28QSW_EMUL_ONESHOT BIT(0)    // CTRL_REG2
+#define ILPS28QSW_EMUL_SWRESET BIT(2)
+#define ILPS28QSW_EMUL_FS_MODE BIT(6)
+#define ILPS28QSW_EMUL_BOOT BIT(7)
+#define ILPS28QSW_EMUL_DRDY BIT(5) // CTRL_REG4
+#define ILPS28QSW_EMUL_DRDY_PLS BIT(6)
+#define ILPS28QSW_EMUL_P_DA BIT(0) // STATUS
+#define ILPS28QSW_EMUL_T_DA BIT(1)
+#define ILPS28QSW_EMUL_P_OR BIT(4)
+#define ILPS28QSW_EMUL_T_OR BIT(5)
+
+// Output data rates of CTRL_REG1 ODR[6:3] in mHz, 0 is one-shot mode
+static const uint32_t ilps28qsw_emul_odr[] = {0, 1000, 4000, 10000, 25000, 50000, 75000, 100000, 200000};
+
+struct ilps28qsw_emul_data {
+  const struct emul *target;
+  struct k_timer timer;
+  struct k_spinlock lock;
+  uint8_t regs[256];
+  uint32_t seed;
+};
+
+struct ilps28qsw_emul_cfg {
+  struct gpio_dt_spec drdy;
+};
+
+static void ilps28qsw_emul_reset(struct ilps28qsw_emul_data *data) {
+  k_timer_stop(&data->timer);
+  memset(data->regs, 0, sizeof(data->regs));
+  data->regs[ILPS28QSW_EMUL_WHO_AM_I] = ILPS28QSW_EMUL_ID;
+  data->regs[ILPS28QSW_EMUL_CTRL_REG3] = ILPS28QSW_EMUL_IF_ADD_INC;
+}
+
+/**
+ * @brief Returns the duration of a one-shot conversion, it grows with the number of averaged samples.
+ *
+ */
+static k_timeout_t ilps28qsw_emul_conversion(struct ilps28qsw_emul_data *data) {
+  uint32_t samples = 4U << (data->regs[ILPS28QSW_EMUL_CTRL_REG1] & 0x07);
+
+  return K_USEC(250 + 75 * samples);
+}
+
+/**
+ * @brief Completes a conversion, latches the output registers and raises the data-ready flags and line.
+ *
+ */
+static void ilps28qsw_emul_sample(struct k_timer *timer) {
+  struct ilps28qsw_emul_data *data = CONTAINER_OF(timer, struct ilps28qsw_emul_data, timer);
+  const struct ilps28qsw_emul_cfg *cfg = data->target->cfg;
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+  uint8_t *regs = data->regs;
+
+  float pressure = emul_wave(965.0f, 2.0f, 600, 0) + emul_noise(&data->seed, 0.02f);
+  float temperature = emul_wave(24.0f, 1.0f, 3600, 300) + emul_noise(&data->seed, 0.02f);
+  float sensitivity = (regs[ILPS28QSW_EMUL_CTRL_REG2] & ILPS28QSW_EMUL_FS_MODE) ? 2048.0f : 4096.0f;
+  int32_t raw_pressure = (int32_t)(pressure * sensitivity);
+
+  regs[ILPS28QSW_EMUL_PRESS_OUT_XL] = raw_pressure & 0xFF;
+  regs[ILPS28QSW_EMUL_PRESS_OUT_XL + 1] = (raw_pressure >> 8) & 0xFF;
+  regs[ILPS28QSW_EMUL_PRESS_OUT_H] = (raw_pressure >> 16) & 0xFF;
+  sys_put_le16((int16_t)(temperature * 100.0f), &regs[ILPS28QSW_EMUL_TEMP_OUT_L]);
+
+  uint8_t status = regs[ILPS28QSW_EMUL_STATUS];
+  if (status & ILPS28QSW_EMUL_P_DA) {
+    status |= ILPS28QSW_EMUL_P_OR;
+  }
+  if (status & ILPS28QSW_EMUL_T_DA) {
+    status |= ILPS28QSW_EMUL_T_OR;
+  }
+  regs[ILPS28QSW_EMUL_STATUS] = status | ILPS28QSW_EMUL_P_DA | ILPS28QSW_EMUL_T_DA;
+  regs[ILPS28QSW_EMUL_CTRL_REG2] &= ~ILPS28QSW_EMUL_ONESHOT;
+
+  uint8_t ctrl4 = regs[ILPS28QSW_EMUL_CTRL_REG4];
+  k_spin_unlock(&data->lock, key);
+
+  if (ctrl4 & ILPS28QSW_EMUL_DRDY) {
+    emul_line_drive(&cfg->drdy, true);
+    if (ctrl4 & ILPS28QSW_EMUL_DRDY_PLS) {
+      emul_line_drive(&cfg->drdy, false);
+    }
+  }
+}
+
+static uint8_t ilps28qsw_emul_read(const struct emul *target, uint8_t reg) {
+  const struct ilps28qsw_emul_cfg *cfg = target->cfg;
+  struct ilps28qsw_emul_data *data = target->data;
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+  uint8_t value = data->regs[reg];
+
+  // Reading the most significant byte of an output clears its flags and the latched data-ready line
+  if (reg == ILPS28QSW_EMUL_PRESS_OUT_H) {
+    data->regs[ILPS28QSW_EMUL_STATUS] &= ~(ILPS28QSW_EMUL_P_DA | ILPS28QSW_EMUL_P_OR);
+  } else if (reg == ILPS28QSW_EMUL_TEMP_OUT_H) {
+    data->regs[ILPS28QSW_EMUL_STATUS] &= ~(ILPS28QSW_EMUL_T_DA | ILPS28QSW_EMUL_T_OR);
+  }
+  bool pending = data->regs[ILPS28QSW_EMUL_STATUS] & ILPS28QSW_EMUL_P_DA;
+  k_spin_unlock(&data->lock, key);
+
+  if (reg == ILPS28QSW_EMUL_PRESS_OUT_H && !pending) {
+    emul_line_drive(&cfg->drdy, false);
+  }
+  return value;
+}
+
+static void ilps28qsw_emul_write(const struct emul *target, uint8_t reg, uint8_t value) {
+  struct ilps28qsw_emul_data *data = target->data;
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+  switch (reg) {
+  case ILPS28QSW_EMUL_CTRL_REG1: {
+    uint8_t odr = (value >> 3) & 0x0F;
+    uint32_t period_us = odr < ARRAY_SIZE(ilps28qsw_emul_odr) ? emul_period_us(ilps28qsw_emul_odr[odr]) : 0;
+
+    data->regs[reg] = value;
+    if (period_us) {
+      k_timer_start(&data->timer, K_USEC(period_us), K_USEC(period_us));
+    } else {
+      k_timer_stop(&data->timer);
+    }
+    break;
+  }
+  case ILPS28QSW_EMUL_CTRL_REG2:
+    if (value & (ILPS28QSW_EMUL_SWRESET | ILPS28QSW_EMUL_BOOT)) {
+      ilps28qsw_emul_reset(data);
+      break;
+    }
+    data->regs[reg] = value;
+    if ((value & ILPS28QSW_EMUL_ONESHOT) && (data->regs[ILPS28QSW_EMUL_CTRL_REG1] & 0x78) == 0) {
+      k_timer_start(&data->timer, ilps28qsw_emul_conversion(data), K_NO_WAIT);
+    }
+    break;
+  default:
+    // WHO_AM_I, STATUS and the outputs are read only
+    if (reg != ILPS28QSW_EMUL_WHO_AM_I && (reg < ILPS28QSW_EMUL_STATUS || reg > ILPS28QSW_EMUL_TEMP_OUT_H)) {
+      data->regs[reg] = value;
+    }
+    break;
+  }
+  k_spin_unlock(&data->lock, key);
+}
+
+static const emul_regmap_api_t ilps28qsw_emul_regmap = {
+    .read = ilps28qsw_emul_read,
+    .write = ilps28qsw_emul_write,
+};
+
+static int ilps28qsw_emul_transfer(const struct emul *target, struct i2c_msg *msgs, int num_msgs, int addr) {
+  return emul_regmap_transfer(target, &ilps28qsw_emul_regmap, msgs, num_msgs);
+}
+
+static const struct i2c_emul_api ilps28qsw_emul_api = {
+    .transfer = ilps28qsw_emul_transfer,
+};
+
+static int ilps28qsw_emul_init(const struct emul *target, const struct device *parent) {
+  struct ilps28qsw_emul_data *data = target->data;
+
+  data->target = target;
+  data->seed = 0x28C5;
+  k_timer_init(&data->timer, ilps28qsw_emul_sample, NULL);
+  ilps28qsw_emul_reset(data);
+  return 0;
+}
+
+#define ILPS28QSW_EMUL(n)                                                                                              \
+  static struct ilps28qsw_emul_data ilps28qsw_emul_data_##n;                                                           \
+  static const struct ilps28qsw_emul_cfg ilps28qsw_emul_cfg_##n = {                                                    \
+      .drdy = EMUL_LINE(gpio_ext_ilps28qsw_int),                                                                       \
+  };                                                                                                                   \
+  EMUL_DT_INST_DEFINE(n, ilps28qsw_emul_init, &ilps28qsw_emul_data_##n, &ilps28qsw_emul_cfg_##n, &ilps28qsw_emul_api,  \
+                      NULL)
+
+DT_INST_FOREACH_STATUS_OKAY(ILPS28QSW_EMUL)
@@ -0,0 +1,252 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: emul_ism330dhcx.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#define DT_DRV_COMPAT sensei_ism330dhcx
+
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/emul.h>
+#include <zephyr/drivers/i2c_emul.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+
+#include "emul_sensor.h"
+
+#define ISM330DHCX_EMUL_INT1_CTRL 0x0D
+#define ISM330DHCX_EMUL_WHO_AM_I 0x0F
+#define ISM330DHCX_EMUL_CTRL1_XL 0x10
+#define ISM330DHCX_EMUL_CTRL2_G 0x11
+#define ISM330DHCX_EMUL_CTRL3_C 0x12
+#define ISM330DHCX_EMUL_STATUS 0x1E
+#define ISM330DHCX_EMUL_OUT_TEMP_L 0x20
+#define ISM330DHCX_EMUL_OUTX_L_G 0x22
+#define ISM330DHCX_EMUL_OUTX_L_A 0x28
+#define ISM330DHCX_EMUL_OUTZ_H_A 0x2D
+
+#define ISM330DHCX_EMUL_ID 0x6B
+#define ISM330DHCX_EMUL_DRDY_XL BIT(0) // INT1_CTRL
+#define ISM330DHCX_EMUL_DRDY_G BIT(1)
+#define ISM330DHCX_EMUL_SW_RESET BIT(0) // CTRL3_C
+#define ISM330DHCX_EMUL_IF_INC BIT(2)
+#define ISM330DHCX_EMUL_BOOT BIT(7)
+#define ISM330DHCX_EMUL_XLDA BIT(0) // STATUS
+#define ISM330DHCX_EMUL_GDA BIT(1)
+#define ISM330DHCX_EMUL_TDA BIT(2)
+
+// Output data rates of CTRL1_XL and CTRL2_G ODR[7:4] in mHz, 0xB is the 1.6 Hz low-power rate of the accelerometer
+static const uint32_t ism330dhcx_emul_odr[] = {0,       12500,   26000,   52000,   104000,  208000,
+                                               416000,  833000,  1666000, 3332000, 6667000, 1600};
+
+// Sensitivities in mg and mdps per LSB, indexed by CTRL1_XL FS[3:2] and CTRL2_G FS[3:0]
+static const float ism330dhcx_emul_xl_sensitivity[] = {0.061f, 0.488f, 0.122f, 0.244f};
+static const float ism330dhcx_emul_g_sensitivity[] = {8.75f, 140.0f, 4.375f, 140.0f, 17.5f, 140.0f, 4.375f, 140.0f,
+                                                      35.0f, 140.0f, 4.375f, 140.0f, 70.0f, 140.0f, 4.375f, 140.0f};
+
+struct ism330dhcx_emul_data {
+  const struct emul *target;
+  struct k_timer xl_timer;
+  struct k_timer g_timer;
+  struct k_spinlock lock;
+  uint8_t regs[128];
+  uint32_t seed;
+};
+
+struct ism330dhcx_emul_cfg {
+  struct gpio_dt_spec int1;
+};
+
+static void ism330dhcx_emul_reset(struct ism330dhcx_emul_data *data) {
+  k_timer_stop(&data->xl_timer);
+  k_timer_stop(&data->g_timer);
+  memset(data->regs, 0, sizeof(data->regs));
+  data->regs[ISM330DHCX_EMUL_WHO_AM_I] = ISM330DHCX_EMUL_ID;
+  data->regs[ISM330DHCX_EMUL_CTRL3_C] = ISM330DHCX_EMUL_IF_INC;
+}
+
+/**
+ * @brief Updates INT1 from the data-ready flags routed to it, the line is latched until the outputs are read.
+ *
+ */
+static void ism330dhcx_emul_update_int1(const struct emul *target) {
+  const struct ism330dhcx_emul_cfg *cfg = target->cfg;
+  struct ism330dhcx_emul_data *data = target->data;
+  uint8_t route = data->regs[ISM330DHCX_EMUL_INT1_CTRL] & (ISM330DHCX_EMUL_DRDY_XL | ISM330DHCX_EMUL_DRDY_G);
+
+  emul_line_drive(&cfg->int1, data->regs[ISM330DHCX_EMUL_STATUS] & route);
+}
+
+static void ism330dhcx_emul_temperature(struct ism330dhcx_emul_data *data) {
+  float temperature = emul_wave(26.0f, 1.0f, 3600, 600) + emul_noise(&data->seed, 0.05f);
+
+  sys_put_le16((int16_t)((temperature - 25.0f) * 256.0f), &data->regs[ISM330DHCX_EMUL_OUT_TEMP_L]);
+  data->regs[ISM330DHCX_EMUL_STATUS] |= ISM330DHCX_EMUL_TDA;
+}
+
+/**
+ * @brief Latches a sample of the board lying flat, gravity on the z axis and a small tilt oscillation.
+ *
+ */
+static void ism330dhcx_emul_sample_xl(struct k_timer *timer) {
+  struct ism330dhcx_emul_data *data = CONTAINER_OF(timer, struct ism330dhcx_emul_data, xl_timer);
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+  float sensitivity = ism330dhcx_emul_xl_sensitivity[(data->regs[ISM330DHCX_EMUL_CTRL1_XL] >> 2) & 0x03];
+  float mg[3] = {emul_wave(0.0f, 20.0f, 60, 0), emul_wave(0.0f, 20.0f, 60, 15), 1000.0f};
+
+  for (int i = 0; i < 3; i++) {
+    float raw = (mg[i] + emul_noise(&data->seed, 2.0f)) / sensitivity;
+
+    sys_put_le16((int16_t)CLAMP(raw, INT16_MIN, INT16_MAX), &data->regs[ISM330DHCX_EMUL_OUTX_L_A + 2 * i]);
+  }
+  ism330dhcx_emul_temperature(data);
+  data->regs[ISM330DHCX_EMUL_STATUS] |= ISM330DHCX_EMUL_XLDA;
+  k_spin_unlock(&data->lock, key);
+
+  ism330dhcx_emul_update_int1(data->target);
+}
+
+static void ism330dhcx_emul_sample_g(struct k_timer *timer) {
+  struct ism330dhcx_emul_data *data = CONTAINER_OF(timer, struct ism330dhcx_emul_data, g_timer);
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+  float sensitivity = ism330dhcx_emul_g_sensitivity[data->regs[ISM330DHCX_EMUL_CTRL2_G] & 0x0F];
+
+  for (int i = 0; i < 3; i++) {
+    float raw = emul_noise(&data->seed, 50.0f) / sensitivity;
+
+    sys_put_le16((int16_t)raw, &data->regs[ISM330DHCX_EMUL_OUTX_L_G + 2 * i]);
+  }
+  ism330dhcx_emul_temperature(data);
+  data->regs[ISM330DHCX_EMUL_STATUS] |= ISM330DHCX_EMUL_GDA;
+  k_spin_unlock(&data->lock, key);
+
+  ism330dhcx_emul_update_int1(data->target);
+}
+
+static void ism330dhcx_emul_start(struct k_timer *timer, uint8_t ctrl) {
+  uint8_t odr = ctrl >> 4;
+  uint32_t period_us = odr < ARRAY_SIZE(ism330dhcx_emul_odr) ? emul_period_us(ism330dhcx_emul_odr[odr]) : 0;
+
+  if (period_us) {
+    k_timer_start(timer, K_USEC(period_us), K_USEC(period_us));
+  } else {
+    k_timer_stop(timer);
+  }
+}
+
+static uint8_t ism330dhcx_emul_read(const struct emul *target, uint8_t reg) {
+  struct ism330dhcx_emul_data *data = target->data;
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+  uint8_t value = data->regs[reg & 0x7F];
+
+  // Reading an output clears the data-ready flag of its sensor
+  if (reg >= ISM330DHCX_EMUL_OUTX_L_A && reg <= ISM330DHCX_EMUL_OUTZ_H_A) {
+    data->regs[ISM330DHCX_EMUL_STATUS] &= ~ISM330DHCX_EMUL_XLDA;
+  } else if (reg >= ISM330DHCX_EMUL_OUTX_L_G && reg < ISM330DHCX_EMUL_OUTX_L_A) {
+    data->regs[ISM330DHCX_EMUL_STATUS] &= ~ISM330DHCX_EMUL_GDA;
+  } else if (reg >= ISM330DHCX_EMUL_OUT_TEMP_L && reg < ISM330DHCX_EMUL_OUTX_L_G) {
+    data->regs[ISM330DHCX_EMUL_STATUS] &= ~ISM330DHCX_EMUL_TDA;
+  }
+  k_spin_unlock(&data->lock, key);
+
+  if (reg >= ISM330DHCX_EMUL_OUTX_L_G && reg <= ISM330DHCX_EMUL_OUTZ_H_A) {
+    ism330dhcx_emul_update_int1(target);
+  }
+  return value;
+}
+
+static void ism330dhcx_emul_write(const struct emul *target, uint8_t reg, uint8_t value) {
+  struct ism330dhcx_emul_data *data = target->data;
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+  reg &= 0x7F;
+  switch (reg) {
+  case ISM330DHCX_EMUL_CTRL1_XL:
+    data->regs[reg] = value;
+    ism330dhcx_emul_start(&data->xl_timer, value);
+    break;
+  case ISM330DHCX_EMUL_CTRL2_G:
+    data->regs[reg] = value;
+    ism330dhcx_emul_start(&data->g_timer, value);
+    break;
+  case ISM330DHCX_EMUL_CTRL3_C:
+    // SW_RESET and BOOT complete immediately and read back as zero
+    if (value & (ISM330DHCX_EMUL_SW_RESET | ISM330DHCX_EMUL_BOOT)) {
+      ism330dhcx_emul_reset(data);
+      break;
+    }
+    data->regs[reg] = value;
+    break;
+  default:
+    // WHO_AM_I, STATUS and the outputs are read only
+    if (reg != ISM330DHCX_EMUL_WHO_AM_I && reg != ISM330DHCX_EMUL_STATUS &&
+        (reg < ISM330DHCX_EMUL_OUT_TEMP_L || reg > ISM330DHCX_EMUL_OUTZ_H_A)) {
+      data->regs[reg] = value;
+    }
+    break;
+  }
+  k_spin_unlock(&data->lock, key);
+
+  if (reg == ISM330DHCX_EMUL_INT1_CTRL || reg == ISM330DHCX_EMUL_CTRL3_C) {
+    ism330dhcx_emul_update_int1(target);
+  }
+}
+
+static const emul_regmap_api_t ism330dhcx_emul_regmap = {
+    .read = ism330dhcx_emul_read,
+    .write = ism330dhcx_emul_write,
+};
+
+static int ism330dhcx_emul_transfer(const struct emul *target, struct i2c_msg *msgs, int num_msgs, int addr) {
+  return emul_regmap_transfer(target, &ism330dhcx_emul_regmap, msgs, num_msgs);
+}
+
+static const struct i2c_emul_api ism330dhcx_emul_api = {
+    .transfer = ism330dhcx_emul_transfer,
+};
+
+static int ism330dhcx_emul_init(const struct emul *target, const struct device *parent) {
+  struct ism330dhcx_emul_data *data = target->data;
+
+  data->target = target;
+  data->seed = 0x330D;
+  k_timer_init(&data->xl_timer, ism330dhcx_emul_sample_xl, NULL);
+  k_timer_init(&data->g_timer, ism330dhcx_emul_sample_g, NULL);
+  ism330dhcx_emul_reset(data);
+  return 0;
+}
+
+#define ISM330DHCX_EMUL(n)                                                                                             \
+  static struct ism330dhcx_emul_data ism330dhcx_emul_data_##n;                                                         \
+  static const struct ism330dhcx_emul_cfg ism330dhcx_emul_cfg_##n = {                                                  \
+      .int1 = EMUL_LINE(gpio_ism330dhcx_int1),                                                                         \
+  };                                                                                                                   \
+  EMUL_DT_INST_DEFINE(n, ism330dhcx_emul_init, &ism330dhcx_emul_data_##n, &ism330dhcx_emul_cfg_##n,                    \
+                      &ism330dhcx_emul_api, NULL)
+
+DT_INST_FOREACH_STATUS_OKAY(ISM330DHCX_EMUL)
@@ -0,0 +1,194 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: emul_lis2duxs12.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#define DT_DRV_COMPAT sensei_lis2duxs12
+
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/emul.h>
+#include <zephyr/drivers/i2c_emul.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+
+#include "emul_sensor.h"
+
+#define LIS2DUXS12_EMUL_WHO_AM_I 0x0F
+#define LIS2DUXS12_EMUL_CTRL1 0x10
+#define LIS2DUXS12_EMUL_CTRL2 0x11
+#define LIS2DUXS12_EMUL_CTRL5 0x14
+#define LIS2DUXS12_EMUL_STATUS 0x25
+#define LIS2DUXS12_EMUL_OUT_X_L 0x28
+#define LIS2DUXS12_EMUL_OUT_T_L 0x2E
+#define LIS2DUXS12_EMUL_OUT_T_H 0x2F
+
+#define LIS2DUXS12_EMUL_ID 0x47
+#define LIS2DUXS12_EMUL_IF_ADD_INC BIT(4) // CTRL1
+#define LIS2DUXS12_EMUL_SW_RESET BIT(5)
+#define LIS2DUXS12_EMUL_INT1_DRDY BIT(0) // CTRL2
+#define LIS2DUXS12_EMUL_DRDY BIT(0)      // STATUS
+
+// Output data rates of CTRL5 ODR[7:4] in mHz, 1 - 3 are the ultra-low-power rates
+static const uint32_t lis2duxs12_emul_odr[] = {0,     1600,  3000,   25000,  6000,   12500,
+                                               25000, 50000, 100000, 200000, 400000, 800000};
+
+struct lis2duxs12_emul_data {
+  const struct emul *target;
+  struct k_timer timer;
+  struct k_spinlock lock;
+  uint8_t regs[128];
+  uint32_t seed;
+};
+
+struct lis2duxs12_emul_cfg {
+  struct gpio_dt_spec int1;
+};
+
+static void lis2duxs12_emul_reset(struct lis2duxs12_emul_data *data) {
+  k_timer_stop(&data->timer);
+  memset(data->regs, 0, sizeof(data->regs));
+  data->regs[LIS2DUXS12_EMUL_WHO_AM_I] = LIS2DUXS12_EMUL_ID;
+  data->regs[LIS2DUXS12_EMUL_CTRL1] = LIS2DUXS12_EMUL_IF_ADD_INC | 0x07;
+}
+
+/**
+ * @brief Latches a sample of the board lying flat and raises INT1 if data-ready is routed to it.
+ *
+ */
+static void lis2duxs12_emul_sample(struct k_timer *timer) {
+  struct lis2duxs12_emul_data *data = CONTAINER_OF(timer, struct lis2duxs12_emul_data, timer);
+  const struct lis2duxs12_emul_cfg *cfg = data->target->cfg;
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+  float sensitivity = 0.061f * (1U << (data->regs[LIS2DUXS12_EMUL_CTRL5] & 0x03));
+  float mg[3] = {emul_wave(0.0f, 20.0f, 60, 0), emul_wave(0.0f, 20.0f, 60, 15), 1000.0f};
+  float temperature = emul_wave(26.0f, 1.0f, 3600, 600) + emul_noise(&data->seed, 0.05f);
+
+  for (int i = 0; i < 3; i++) {
+    float raw = (mg[i] + emul_noise(&data->seed, 4.0f)) / sensitivity;
+
+    sys_put_le16((int16_t)CLAMP(raw, INT16_MIN, INT16_MAX), &data->regs[LIS2DUXS12_EMUL_OUT_X_L + 2 * i]);
+  }
+  sys_put_le16((int16_t)((temperature - 25.0f) * 355.5f), &data->regs[LIS2DUXS12_EMUL_OUT_T_L]);
+  data->regs[LIS2DUXS12_EMUL_STATUS] |= LIS2DUXS12_EMUL_DRDY;
+  bool route = data->regs[LIS2DUXS12_EMUL_CTRL2] & LIS2DUXS12_EMUL_INT1_DRDY;
+  k_spin_unlock(&data->lock, key);
+
+  if (route) {
+    emul_line_drive(&cfg->int1, true);
+  }
+}
+
+static uint8_t lis2duxs12_emul_read(const struct emul *target, uint8_t reg) {
+  const struct lis2duxs12_emul_cfg *cfg = target->cfg;
+  struct lis2duxs12_emul_data *data = target->data;
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+  uint8_t value = data->regs[reg & 0x7F];
+  bool clear = reg >= LIS2DUXS12_EMUL_OUT_X_L && reg <= LIS2DUXS12_EMUL_OUT_T_H;
+
+  // Reading the outputs clears the data-ready flag and the latched INT1 line
+  if (clear) {
+    data->regs[LIS2DUXS12_EMUL_STATUS] &= ~LIS2DUXS12_EMUL_DRDY;
+  }
+  k_spin_unlock(&data->lock, key);
+
+  if (clear) {
+    emul_line_drive(&cfg->int1, false);
+  }
+  return value;
+}
+
+static void lis2duxs12_emul_write(const struct emul *target, uint8_t reg, uint8_t value) {
+  struct lis2duxs12_emul_data *data = target->data;
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+  reg &= 0x7F;
+  switch (reg) {
+  case LIS2DUXS12_EMUL_CTRL1:
+    // The software reset completes immediately and reads back as zero
+    if (value & LIS2DUXS12_EMUL_SW_RESET) {
+      lis2duxs12_emul_reset(data);
+      break;
+    }
+    data->regs[reg] = value;
+    break;
+  case LIS2DUXS12_EMUL_CTRL5: {
+    uint8_t odr = value >> 4;
+    uint32_t period_us = odr < ARRAY_SIZE(lis2duxs12_emul_odr) ? emul_period_us(lis2duxs12_emul_odr[odr]) : 0;
+
+    data->regs[reg] = value;
+    if (period_us) {
+      k_timer_start(&data->timer, K_USEC(period_us), K_USEC(period_us));
+    } else {
+      k_timer_stop(&data->timer);
+    }
+    break;
+  }
+  default:
+    // WHO_AM_I, STATUS and the outputs are read only
+    if (reg != LIS2DUXS12_EMUL_WHO_AM_I && reg != LIS2DUXS12_EMUL_STATUS &&
+        (reg < LIS2DUXS12_EMUL_OUT_X_L || reg > LIS2DUXS12_EMUL_OUT_T_H)) {
+      data->regs[reg] = value;
+    }
+    break;
+  }
+  k_spin_unlock(&data->lock, key);
+}
+
+static const emul_regmap_api_t lis2duxs12_emul_regmap = {
+    .read = lis2duxs12_emul_read,
+    .write = lis2duxs12_emul_write,
+};
+
+static int lis2duxs12_emul_transfer(const struct emul *target, struct i2c_msg *msgs, int num_msgs, int addr) {
+  return emul_regmap_transfer(target, &lis2duxs12_emul_regmap, msgs, num_msgs);
+}
+
+static const struct i2c_emul_api lis2duxs12_emul_api = {
+    .transfer = lis2duxs12_emul_transfer,
+};
+
+static int lis2duxs12_emul_init(const struct emul *target, const struct device *parent) {
+  struct lis2duxs12_emul_data *data = target->data;
+
+  data->target = target;
+  data->seed = 0x2D5;
+  k_timer_init(&data->timer, lis2duxs12_emul_sample, NULL);
+  lis2duxs12_emul_reset(data);
+  return 0;
+}
+
+#define LIS2DUXS12_EMUL(n)                                                                                             \
+  static struct lis2duxs12_emul_data lis2duxs12_emul_data_##n;                                                         \
+  static const struct lis2duxs12_emul_cfg lis2duxs12_emul_cfg_##n = {                                                  \
+      .int1 = EMUL_LINE(gpio_lis2duxs12_int1),                                                                         \
+  };                                                                                                                   \
+  EMUL_DT_INST_DEFINE(n, lis2duxs12_emul_init, &lis2duxs12_emul_data_##n, &lis2duxs12_emul_cfg_##n,                    \
+                      &lis2duxs12_emul_api, NULL)
+
+DT_INST_FOREACH_STATUS_OKAY(LIS2DUXS12_EMUL)
@@ -0,0 +1,203 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: emul_max77654.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#define DT_DRV_COMPAT sensei_max77654
+
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/emul.h>
+#include <zephyr/drivers/i2c_emul.h>
+#include <zephyr/kernel.h>
+
+#include "emul_max77654.h"
+#include "emul_sensor.h"
+
+#define MAX77654_EMUL_CHIP_ID 0x01
+
+// Battery model in µV and µA
+#define MAX77654_EMUL_VBAT_FULL 4150000
+#define MAX77654_EMUL_VBAT_EMPTY 3500000
+#define MAX77654_EMUL_VBAT_SLOPE 20 // per second
+#define MAX77654_EMUL_VSYS_DROP 30000
+#define MAX77654_EMUL_I_BASE 3000 // MCU, always powered sensors and regulators
+#define MAX77654_EMUL_I_SCD41 3500
+#define MAX77654_EMUL_I_SGP41 3000
+
+// Full scale of the discharge current in µA, indexed by CNFG_CHG_I IMON_DISCHG_SCALE[7:4]
+static const uint32_t max77654_emul_discharge_scale[] = {8200,   40500,  72300,  103400, 134100, 164100,
+                                                         193700, 222700, 251200, 279300, 300000};
+
+struct max77654_emul_data {
+  struct k_spinlock lock;
+  uint8_t regs[MAX77654_EMUL_REGS];
+  uint32_t seed;
+};
+
+struct max77654_emul_cfg {
+  struct gpio_dt_spec scd41_pwr;
+  struct gpio_dt_spec sgp41_pwr;
+};
+
+/**
+ * @brief Returns the input that drives AMUX to its full scale, in thousandths of the unit of the channel.
+ *
+ * @param mux_sel Channel, see MAX77654_EMUL_MUX_*
+ * @param discharge_scale IMON_DISCHG_SCALE of the discharge current channel
+ * @return µV, µA or 0.001 % of the fast-charge current, 0 for a channel without full scale
+ */
+uint32_t emul_max77654_full_scale(uint8_t mux_sel, uint8_t discharge_scale) {
+  switch (mux_sel) {
+  case MAX77654_EMUL_MUX_CHGIN_V:
+    return 7500000;
+  case MAX77654_EMUL_MUX_CHGIN_I:
+    return 475000;
+  case MAX77654_EMUL_MUX_BATT_V:
+    return 4600000;
+  case MAX77654_EMUL_MUX_BATT_I_CHG:
+    return 100000;
+  case MAX77654_EMUL_MUX_BATT_I_DISCHG:
+    return max77654_emul_discharge_scale[MIN(discharge_scale, ARRAY_SIZE(max77654_emul_discharge_scale) - 1)];
+  case MAX77654_EMUL_MUX_VSYS:
+    return 6250000;
+  case MAX77654_EMUL_MUX_THM:
+  case MAX77654_EMUL_MUX_TBIAS:
+  case MAX77654_EMUL_MUX_AGND:
+    return MAX77654_EMUL_AMUX_FULL_SCALE * 1000;
+  default:
+    return 0;
+  }
+}
+
+/**
+ * @brief Returns the voltage on AMUX for the channel selected in CNFG_CHG_I.
+ *
+ */
+uint32_t emul_max77654_amux_mv(const struct emul *target) {
+  const struct max77654_emul_cfg *cfg = target->cfg;
+  struct max77654_emul_data *data = target->data;
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+  uint8_t cnfg = data->regs[MAX77654_EMUL_CNFG_CHG_I];
+  uint8_t mux_sel = cnfg & 0x0F;
+
+  float vbat = MAX(MAX77654_EMUL_VBAT_FULL - MAX77654_EMUL_VBAT_SLOPE * (k_uptime_get() / 1000.0f),
+                   MAX77654_EMUL_VBAT_EMPTY);
+  float discharge = MAX77654_EMUL_I_BASE + emul_noise(&data->seed, 100.0f);
+  float value;
+
+  if (emul_line_on(&cfg->scd41_pwr)) {
+    discharge += MAX77654_EMUL_I_SCD41;
+  }
+  if (emul_line_on(&cfg->sgp41_pwr)) {
+    discharge += MAX77654_EMUL_I_SGP41;
+  }
+
+  switch (mux_sel) {
+  case MAX77654_EMUL_MUX_BATT_V:
+    value = vbat;
+    break;
+  case MAX77654_EMUL_MUX_VSYS:
+    value = vbat - MAX77654_EMUL_VSYS_DROP;
+    break;
+  case MAX77654_EMUL_MUX_BATT_I_DISCHG:
+    value = discharge;
+    break;
+  case MAX77654_EMUL_MUX_THM:
+    value = MAX77654_EMUL_AMUX_FULL_SCALE * 500.0f; // 10k NTC at 25 °C
+    break;
+  case MAX77654_EMUL_MUX_TBIAS:
+    value = MAX77654_EMUL_AMUX_FULL_SCALE * 1000.0f;
+    break;
+  default:
+    // No charger input, AGND and the null channel
+    value = 0.0f;
+    break;
+  }
+  k_spin_unlock(&data->lock, key);
+
+  uint32_t full_scale = emul_max77654_full_scale(mux_sel, cnfg >> 4);
+  if (full_scale == 0) {
+    return 0;
+  }
+  return (uint32_t)CLAMP(value * MAX77654_EMUL_AMUX_FULL_SCALE / full_scale, 0.0f, MAX77654_EMUL_AMUX_FULL_SCALE);
+}
+
+static uint8_t max77654_emul_read(const struct emul *target, uint8_t reg) {
+  struct max77654_emul_data *data = target->data;
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+  uint8_t value = reg < MAX77654_EMUL_REGS ? data->regs[reg] : 0;
+
+  k_spin_unlock(&data->lock, key);
+  return value;
+}
+
+static void max77654_emul_write(const struct emul *target, uint8_t reg, uint8_t value) {
+  struct max77654_emul_data *data = target->data;
+  k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+  // Status and interrupt registers are not modelled, CID is read only
+  if (reg < MAX77654_EMUL_REGS && reg != MAX77654_EMUL_CID) {
+    data->regs[reg] = value;
+  }
+  k_spin_unlock(&data->lock, key);
+}
+
+static const emul_regmap_api_t max77654_emul_regmap = {
+    .read = max77654_emul_read,
+    .write = max77654_emul_write,
+};
+
+static int max77654_emul_transfer(const struct emul *target, struct i2c_msg *msgs, int num_msgs, int addr) {
+  return emul_regmap_transfer(target, &max77654_emul_regmap, msgs, num_msgs);
+}
+
+static const struct i2c_emul_api max77654_emul_api = {
+    .transfer = max77654_emul_transfer,
+};
+
+static int max77654_emul_init(const struct emul *target, const struct device *parent) {
+  struct max77654_emul_data *data = target->data;
+
+  memset(data->regs, 0, sizeof(data->regs));
+  data->regs[MAX77654_EMUL_CID] = MAX77654_EMUL_CHIP_ID;
+  data->seed = 0x77654;
+  return 0;
+}
+
+// The SDK drives the PMIC without a Zephyr device, the emulator is bound to a device without API
+#define MAX77654_EMUL(n)                                                                                               \
+  DEVICE_DT_INST_DEFINE(n, NULL, NULL, NULL, NULL, POST_KERNEL, CONFIG_APPLICATION_INIT_PRIORITY, NULL);               \
+  static struct max77654_emul_data max77654_emul_data_##n;                                                             \
+  static const struct max77654_emul_cfg max77654_emul_cfg_##n = {                                                      \
+      .scd41_pwr = EMUL_LINE(gpio_scd41_pwr),                                                                          \
+      .sgp41_pwr = EMUL_LINE(gpio_sgp41_pwr),                                                                          \
+  };                                                                                                                   \
+  EMUL_DT_INST_DEFINE(n, max77654_emul_init, &max77654_emul_data_##n, &max77654_emul_cfg_##n, &max77654_emul_api, NULL)
+
+DT_INST_FOREACH_STATUS_OKAY(MAX77654_EMUL)
@@ -0,0 +1,66 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: emul_max77654.h
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EMUL_MAX77654_H
+#define EMUL_MAX77654_H
+
+#include <stdint.h>
+
+#include <zephyr/drivers/emul.h>
+
+/*
+ * MAX77654 emulator
+ *
+ * The PMIC has no ADC, the SDK samples its AMUX pin with the SAADC of the nRF5340. The emulator models the register
+ * map and the voltage on AMUX for the channel selected in CNFG_CHG_I, max77654_sim.c converts it back with the full
+ * scale of the channel. The battery discharges slowly and its current follows the supplies of the SCD41 and SGP41.
+ */
+
+#define MAX77654_EMUL_CID 0x14
+#define MAX77654_EMUL_CNFG_CHG_I 0x28
+#define MAX77654_EMUL_CNFG_SBB0_A 0x29 // SBB0_A, SBB0_B, SBB1_A, ...
+#define MAX77654_EMUL_CNFG_LDO0_A 0x38 // LDO0_A, LDO0_B, LDO1_A, LDO1_B
+#define MAX77654_EMUL_REGS 0x3C
+
+// Analog multiplexer selection of CNFG_CHG_I MUX_SEL[3:0]
+#define MAX77654_EMUL_MUX_CHGIN_V 0x1
+#define MAX77654_EMUL_MUX_CHGIN_I 0x2
+#define MAX77654_EMUL_MUX_BATT_V 0x3
+#define MAX77654_EMUL_MUX_BATT_I_CHG 0x4
+#define MAX77654_EMUL_MUX_BATT_I_DISCHG 0x5
+#define MAX77654_EMUL_MUX_THM 0x7
+#define MAX77654_EMUL_MUX_TBIAS 0x8
+#define MAX77654_EMUL_MUX_AGND 0x9
+#define MAX77654_EMUL_MUX_VSYS 0xA
+
+#define MAX77654_EMUL_AMUX_FULL_SCALE 1250 // mV
+
+uint32_t emul_max77654_full_scale(uint8_t mux_sel, uint8_t discharge_scale);
+uint32_t emul_max77654_amux_mv(const struct emul *target);
+
+#endif /* EMUL_MAX77654_H */
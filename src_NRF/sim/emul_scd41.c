@@ -0,0 +1,316 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: emul_scd41.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#define DT_DRV_COMPAT sensei_scd41
+
+#include <errno.h>
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/emul.h>
+#include <zephyr/drivers/i2c_emul.h>
+#include <zephyr/kernel.h>
+
+#include "emul_sensor.h"
+
+#define SCD41_EMUL_INTERVAL 5000 // Periodic measurement interval and single-shot conversion time in ms
+#define SCD41_EMUL_BOOT_TIME 30  // From power-up or wake-up until the first command is accepted in ms
+
+typedef enum {
+  SCD41_EMUL_IDLE,
+  SCD41_EMUL_PERIODIC,
+  SCD41_EMUL_SLEEP,
+} scd41_emul_mode_t;
+
+struct scd41_emul_data {
+  emul_sensirion_t bus;
+  scd41_emul_mode_t mode;
+  bool powered;
+  int64_t started;   // Start of the periodic measurement in ms
+  int64_t read;      // Periodic samples read since the start
+  int64_t single_at; // Completion of the single-shot conversion not read yet, 0 if none
+  uint16_t temperature_offset;
+  uint16_t altitude;
+  uint16_t asc;
+  uint32_t seed;
+};
+
+struct scd41_emul_cfg {
+  struct gpio_dt_spec supply;
+  struct gpio_dt_spec bus;
+  uint16_t addr;
+};
+
+static struct scd41_emul_data *scd41_data(const struct emul *target) { return target->data; }
+
+static bool scd41_emul_ready(struct scd41_emul_data *data) {
+  int64_t now = k_uptime_get();
+
+  if (data->mode == SCD41_EMUL_PERIODIC) {
+    return (now - data->started) / SCD41_EMUL_INTERVAL > data->read;
+  }
+  return data->single_at != 0 && now >= data->single_at;
+}
+
+static int scd41_emul_idle(struct scd41_emul_data *data) { return data->mode == SCD41_EMUL_IDLE ? 0 : -EIO; }
+
+static int scd41_start_periodic(const struct emul *target, const uint16_t *args, uint16_t *response) {
+  struct scd41_emul_data *data = scd41_data(target);
+
+  if (scd41_emul_idle(data) != 0) {
+    return -EIO;
+  }
+  data->mode = SCD41_EMUL_PERIODIC;
+  data->started = k_uptime_get();
+  data->read = 0;
+  return 0;
+}
+
+static int scd41_stop_periodic(const struct emul *target, const uint16_t *args, uint16_t *response) {
+  struct scd41_emul_data *data = scd41_data(target);
+
+  if (data->mode == SCD41_EMUL_SLEEP) {
+    return -EIO;
+  }
+  data->mode = SCD41_EMUL_IDLE;
+  return 0;
+}
+
+static int scd41_read_measurement(const struct emul *target, const uint16_t *args, uint16_t *response) {
+  struct scd41_emul_data *data = scd41_data(target);
+
+  if (data->mode == SCD41_EMUL_SLEEP) {
+    return -EIO;
+  }
+  // Without new data the response is not acknowledged
+  if (!scd41_emul_ready(data)) {
+    return 0;
+  }
+  if (data->mode == SCD41_EMUL_PERIODIC) {
+    data->read = (k_uptime_get() - data->started) / SCD41_EMUL_INTERVAL;
+  }
+  data->single_at = 0;
+
+  float co2 = emul_wave(650.0f, 200.0f, 1800, 0) + emul_noise(&data->seed, 5.0f);
+  float temperature = emul_wave(23.5f, 1.5f, 3600, 900) + emul_noise(&data->seed, 0.05f);
+  float humidity = emul_wave(45.0f, 5.0f, 3600, 0) + emul_noise(&data->seed, 0.2f);
+
+  response[0] = (uint16_t)co2;
+  response[1] = (uint16_t)((temperature + 45.0f) * 65535.0f / 175.0f);
+  response[2] = (uint16_t)(humidity * 65535.0f / 100.0f);
+  return 3;
+}
+
+static int scd41_get_data_ready(const struct emul *target, const uint16_t *args, uint16_t *response) {
+  struct scd41_emul_data *data = scd41_data(target);
+
+  if (data->mode == SCD41_EMUL_SLEEP) {
+    return -EIO;
+  }
+  // The lower 11 bits are non-zero if data is ready
+  response[0] = scd41_emul_ready(data) ? 0x8006 : 0x8000;
+  return 1;
+}
+
+static int scd41_measure_single_shot(const struct emul *target, const uint16_t *args, uint16_t *response) {
+  struct scd41_emul_data *data = scd41_data(target);
+
+  if (scd41_emul_idle(data) != 0) {
+    return -EIO;
+  }
+  data->single_at = k_uptime_get() + SCD41_EMUL_INTERVAL;
+  return 0;
+}
+
+static int scd41_power_down(const struct emul *target, const uint16_t *args, uint16_t *response) {
+  struct scd41_emul_data *data = scd41_data(target);
+
+  if (scd41_emul_idle(data) != 0) {
+    return -EIO;
+  }
+  data->mode = SCD41_EMUL_SLEEP;
+  return 0;
+}
+
+static int scd41_wake_up(const struct emul *target, const uint16_t *args, uint16_t *response) {
+  struct scd41_emul_data *data = scd41_data(target);
+
+  if (data->mode == SCD41_EMUL_SLEEP) {
+    data->mode = SCD41_EMUL_IDLE;
+    data->bus.busy_until = k_uptime_get() + SCD41_EMUL_BOOT_TIME;
+  }
+  // The command is executed but not acknowledged
+  return -EIO;
+}
+
+static int scd41_get_serial_number(const struct emul *target, const uint16_t *args, uint16_t *response) {
+  if (scd41_emul_idle(scd41_data(target)) != 0) {
+    return -EIO;
+  }
+  response[0] = 0x5CD4;
+  response[1] = 0x1000;
+  response[2] = ((const struct scd41_emul_cfg *)target->cfg)->addr;
+  return 3;
+}
+
+static int scd41_idle_command(const struct emul *target, const uint16_t *args, uint16_t *response) {
+  return scd41_emul_idle(scd41_data(target));
+}
+
+static int scd41_self_test(const struct emul *target, const uint16_t *args, uint16_t *response) {
+  if (scd41_emul_idle(scd41_data(target)) != 0) {
+    return -EIO;
+  }
+  response[0] = 0; // No malfunction
+  return 1;
+}
+
+static int scd41_set_temperature_offset(const struct emul *target, const uint16_t *args, uint16_t *response) {
+  if (scd41_emul_idle(scd41_data(target)) != 0) {
+    return -EIO;
+  }
+  scd41_data(target)->temperature_offset = args[0];
+  return 0;
+}
+
+static int scd41_get_temperature_offset(const struct emul *target, const uint16_t *args, uint16_t *response) {
+  if (scd41_emul_idle(scd41_data(target)) != 0) {
+    return -EIO;
+  }
+  response[0] = scd41_data(target)->temperature_offset;
+  return 1;
+}
+
+static int scd41_set_altitude(const struct emul *target, const uint16_t *args, uint16_t *response) {
+  if (scd41_emul_idle(scd41_data(target)) != 0) {
+    return -EIO;
+  }
+  scd41_data(target)->altitude = args[0];
+  return 0;
+}
+
+static int scd41_get_altitude(const struct emul *target, const uint16_t *args, uint16_t *response) {
+  if (scd41_emul_idle(scd41_data(target)) != 0) {
+    return -EIO;
+  }
+  response[0] = scd41_data(target)->altitude;
+  return 1;
+}
+
+static int scd41_set_ambient_pressure(const struct emul *target, const uint16_t *args, uint16_t *response) {
+  return scd41_data(target)->mode == SCD41_EMUL_SLEEP ? -EIO : 0;
+}
+
+static int scd41_set_asc(const struct emul *target, const uint16_t *args, uint16_t *response) {
+  if (scd41_emul_idle(scd41_data(target)) != 0) {
+    return -EIO;
+  }
+  scd41_data(target)->asc = args[0];
+  return 0;
+}
+
+static int scd41_get_asc(const struct emul *target, const uint16_t *args, uint16_t *response) {
+  if (scd41_emul_idle(scd41_data(target)) != 0) {
+    return -EIO;
+  }
+  response[0] = scd41_data(target)->asc;
+  return 1;
+}
+
+static const emul_sensirion_cmd_t scd41_cmds[] = {
+    {0x21B1, 0, 0, scd41_start_periodic},
+    {0xEC05, 0, 1, scd41_read_measurement},
+    {0x3F86, 0, 500, scd41_stop_periodic},
+    {0xE4B8, 0, 1, scd41_get_data_ready},
+    {0x219D, 0, SCD41_EMUL_INTERVAL, scd41_measure_single_shot},
+    {0x36E0, 0, 1, scd41_power_down},
+    {0x36F6, 0, 30, scd41_wake_up},
+    {0x3682, 0, 1, scd41_get_serial_number},
+    {0x3639, 0, 10000, scd41_self_test},
+    {0x3646, 0, 30, scd41_idle_command},   // reinit
+    {0x3632, 0, 1200, scd41_idle_command}, // perform_factory_reset
+    {0x3615, 0, 800, scd41_idle_command},  // persist_settings
+    {0x241D, 1, 1, scd41_set_temperature_offset},
+    {0x2318, 0, 1, scd41_get_temperature_offset},
+    {0x2427, 1, 1, scd41_set_altitude},
+    {0x2322, 0, 1, scd41_get_altitude},
+    {0xE000, 1, 1, scd41_set_ambient_pressure},
+    {0x2416, 1, 1, scd41_set_asc},
+    {0x2313, 0, 1, scd41_get_asc},
+};
+
+/**
+ * @brief Acknowledges only with supply and bus switch on, a part powered up again starts idle.
+ *
+ */
+static bool scd41_emul_present(const struct emul *target) {
+  const struct scd41_emul_cfg *cfg = target->cfg;
+  struct scd41_emul_data *data = target->data;
+
+  if (!emul_line_on(&cfg->supply)) {
+    data->powered = false;
+    return false;
+  }
+  if (!data->powered) {
+    data->powered = true;
+    data->mode = SCD41_EMUL_IDLE;
+    data->single_at = 0;
+    emul_sensirion_reset(&data->bus);
+    data->bus.busy_until = k_uptime_get() + SCD41_EMUL_BOOT_TIME;
+  }
+  return emul_line_on(&cfg->bus);
+}
+
+static int scd41_emul_transfer(const struct emul *target, struct i2c_msg *msgs, int num_msgs, int addr) {
+  return emul_sensirion_transfer(target, &scd41_data(target)->bus, msgs, num_msgs);
+}
+
+static const struct i2c_emul_api scd41_emul_api = {
+    .transfer = scd41_emul_transfer,
+};
+
+static int scd41_emul_init(const struct emul *target, const struct device *parent) {
+  struct scd41_emul_data *data = target->data;
+
+  data->bus.cmds = scd41_cmds;
+  data->bus.count = ARRAY_SIZE(scd41_cmds);
+  data->bus.present = scd41_emul_present;
+  data->seed = 0x5CD41;
+  return 0;
+}
+
+#define SCD41_EMUL(n)                                                                                                  \
+  static struct scd41_emul_data scd41_emul_data_##n;                                                                   \
+  static const struct scd41_emul_cfg scd41_emul_cfg_##n = {                                                            \
+      .supply = EMUL_LINE(gpio_scd41_pwr),                                                                             \
+      .bus = EMUL_LINE(gpio_ext_i2c_scd41_en),                                                                         \
+      .addr = DT_INST_REG_ADDR(n),                                                                                     \
+  };                                                                                                                   \
+  EMUL_DT_INST_DEFINE(n, scd41_emul_init, &scd41_emul_data_##n, &scd41_emul_cfg_##n, &scd41_emul_api, NULL)
+
+DT_INST_FOREACH_STATUS_OKAY(SCD41_EMUL)
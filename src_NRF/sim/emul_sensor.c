@@ -0,0 +1,299 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: emul_sensor.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <errno.h>
+#include <math.h>
+#include <string.h>
+
+#include <zephyr/drivers/gpio/gpio_emul.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/crc.h>
+
+#include "emul_sensor.h"
+
+#define SENSIRION_CRC_POLY 0x31
+#define SENSIRION_CRC_INIT 0xFF
+
+// Parts are registered on their first transfer, the table is read by the benchmark, see bench.h
+static emul_i2c_stats_t emul_i2c_table[EMUL_I2C_MAX_TARGETS];
+static size_t emul_i2c_count = 0;
+static struct k_spinlock emul_i2c_lock;
+
+static uint8_t sensirion_crc(const uint8_t *data) {
+  return crc8(data, 2, SENSIRION_CRC_POLY, SENSIRION_CRC_INIT, false);
+}
+
+/**
+ * @brief Accounts a transfer to the statistics of its part, a NACKed transfer moves no payload.
+ *
+ * @return The result of the transfer
+ */
+static int emul_i2c_account(const struct emul *target, const struct i2c_msg *msgs, int num_msgs, int rc) {
+  emul_i2c_stats_t *stats = NULL;
+
+  k_spinlock_key_t key = k_spin_lock(&emul_i2c_lock);
+  for (size_t i = 0; i < emul_i2c_count; i++) {
+    if (emul_i2c_table[i].target == target) {
+      stats = &emul_i2c_table[i];
+      break;
+    }
+  }
+  if (stats == NULL && emul_i2c_count < ARRAY_SIZE(emul_i2c_table)) {
+    stats = &emul_i2c_table[emul_i2c_count++];
+    stats->target = target;
+  }
+  if (stats != NULL) {
+    stats->transfers++;
+    if (rc < 0) {
+      stats->nacks++;
+    } else {
+      for (int i = 0; i < num_msgs; i++) {
+        if (msgs[i].flags & I2C_MSG_READ) {
+          stats->bytes_read += msgs[i].len;
+        } else {
+          stats->bytes_written += msgs[i].len;
+        }
+      }
+    }
+  }
+  k_spin_unlock(&emul_i2c_lock, key);
+  return rc;
+}
+
+/**
+ * @brief Returns the bus statistics of the parts that were addressed since the last reset.
+ *
+ * @param count Number of entries
+ */
+const emul_i2c_stats_t *emul_i2c_stats(size_t *count) {
+  *count = emul_i2c_count;
+  return emul_i2c_table;
+}
+
+/**
+ * @brief Clears the counters, the parts stay registered.
+ *
+ */
+void emul_i2c_stats_reset(void) {
+  k_spinlock_key_t key = k_spin_lock(&emul_i2c_lock);
+  for (size_t i = 0; i < emul_i2c_count; i++) {
+    const struct emul *target = emul_i2c_table[i].target;
+
+    memset(&emul_i2c_table[i], 0, sizeof(emul_i2c_table[i]));
+    emul_i2c_table[i].target = target;
+  }
+  k_spin_unlock(&emul_i2c_lock, key);
+}
+
+/**
+ * @brief Runs a transfer on a part with a register pointer.
+ *
+ * The first byte written sets the pointer, every further byte written or read accesses the register under the pointer
+ * and increments it, also across the messages of the transfer.
+ *
+ * @return 0 on success, -EIO if the part does not acknowledge
+ */
+static int regmap_transfer(const struct emul *target, const emul_regmap_api_t *api, struct i2c_msg *msgs,
+                           int num_msgs) {
+  bool pointer_set = false;
+  uint8_t reg = 0;
+
+  if (api->present && !api->present(target)) {
+    return -EIO;
+  }
+
+  for (int i = 0; i < num_msgs; i++) {
+    struct i2c_msg *msg = &msgs[i];
+
+    for (uint32_t j = 0; j < msg->len; j++) {
+      if (msg->flags & I2C_MSG_READ) {
+        msg->buf[j] = api->read(target, reg++);
+      } else if (!pointer_set) {
+        reg = api->pointer ? api->pointer(target, msg->buf[j]) : msg->buf[j];
+        pointer_set = true;
+      } else {
+        api->write(target, reg++, msg->buf[j]);
+      }
+    }
+  }
+  return 0;
+}
+
+/**
+ * @brief Runs a transfer on a Sensirion part.
+ *
+ * A write is a 16 bit command followed by its argument words, each protected by a CRC. The response of the last
+ * command can be read once its execution time has passed, until then the part acknowledges neither reads nor commands.
+ *
+ * @return 0 on success, -EIO if the part does not acknowledge
+ */
+static int sensirion_transfer(const struct emul *target, emul_sensirion_t *state, struct i2c_msg *msgs, int num_msgs) {
+  int64_t now = k_uptime_get();
+
+  if (state->present && !state->present(target)) {
+    return -EIO;
+  }
+
+  for (int i = 0; i < num_msgs; i++) {
+    struct i2c_msg *msg = &msgs[i];
+
+    if (now < state->busy_until) {
+      return -EIO;
+    }
+
+    if (msg->flags & I2C_MSG_READ) {
+      if ((msg->len % 3) != 0 || msg->len > state->words * 3U) {
+        return -EIO;
+      }
+      for (uint32_t w = 0; w < msg->len / 3; w++) {
+        sys_put_be16(state->response[w], &msg->buf[3 * w]);
+        msg->buf[3 * w + 2] = sensirion_crc(&msg->buf[3 * w]);
+      }
+      state->words = 0;
+      continue;
+    }
+
+    if (msg->len < 2) {
+      return -EIO;
+    }
+
+    uint16_t code = sys_get_be16(msg->buf);
+    const emul_sensirion_cmd_t *cmd = NULL;
+
+    for (size_t c = 0; c < state->count; c++) {
+      if (state->cmds[c].code == code) {
+        cmd = &state->cmds[c];
+        break;
+      }
+    }
+    if (cmd == NULL || msg->len != 2U + 3U * cmd->args) {
+      return -EIO;
+    }
+
+    uint16_t args[EMUL_SENSIRION_MAX_WORDS];
+
+    for (uint8_t a = 0; a < cmd->args; a++) {
+      const uint8_t *word = &msg->buf[2 + 3 * a];
+
+      if (sensirion_crc(word) != word[2]) {
+        return -EIO;
+      }
+      args[a] = sys_get_be16(word);
+    }
+
+    state->words = 0;
+    int rc = cmd->handler(target, args, state->response);
+    if (rc < 0) {
+      return rc;
+    }
+    state->words = rc;
+    state->busy_until = now + cmd->time_ms;
+  }
+  return 0;
+}
+
+// Transfer hooks of the emulators, every transfer is accounted to its part
+int emul_regmap_transfer(const struct emul *target, const emul_regmap_api_t *api, struct i2c_msg *msgs, int num_msgs) {
+  return emul_i2c_account(target, msgs, num_msgs, regmap_transfer(target, api, msgs, num_msgs));
+}
+
+int emul_sensirion_transfer(const struct emul *target, emul_sensirion_t *state, struct i2c_msg *msgs, int num_msgs) {
+  return emul_i2c_account(target, msgs, num_msgs, sensirion_transfer(target, state, msgs, num_msgs));
+}
+
+/**
+ * @brief Drops the pending response and the running command, as after a power cycle.
+ *
+ */
+void emul_sensirion_reset(emul_sensirion_t *state) {
+  state->busy_until = 0;
+  state->words = 0;
+}
+
+/**
+ * @brief Returns whether a supply or bus switch driven by the firmware is on.
+ *
+ * A line without node is always on, a pin that was not configured as output yet is off.
+ */
+bool emul_line_on(const struct gpio_dt_spec *spec) {
+  if (spec->port == NULL) {
+    return true;
+  }
+
+  int raw = gpio_emul_output_get(spec->port, spec->pin);
+  if (raw < 0) {
+    return false;
+  }
+  return (raw != 0) != ((spec->dt_flags & GPIO_ACTIVE_LOW) != 0);
+}
+
+/**
+ * @brief Drives an interrupt or data-ready line of a part, a line without node is ignored.
+ *
+ */
+void emul_line_drive(const struct gpio_dt_spec *spec, bool active) {
+  if (spec->port == NULL) {
+    return;
+  }
+
+  // Fails while the firmware has not configured the pin as input, the part then drives an unconnected line
+  (void)gpio_emul_input_set(spec->port, spec->pin, active != ((spec->dt_flags & GPIO_ACTIVE_LOW) != 0));
+}
+
+/**
+ * @brief Returns a value oscillating around the mean with the given period.
+ *
+ */
+float emul_wave(float mean, float amplitude, uint32_t period_s, uint32_t phase_s) {
+  float t = k_uptime_get() / 1000.0f + phase_s;
+
+  return mean + amplitude * sinf(2.0f * 3.14159265f * t / period_s);
+}
+
+/**
+ * @brief Returns uniform noise in [-amplitude, amplitude] from a xorshift generator.
+ *
+ * Every emulator has its own seed, so the sequence of a part does not depend on the traffic to the other parts.
+ */
+float emul_noise(uint32_t *seed, float amplitude) {
+  uint32_t x = *seed ? *seed : 0x2545F491;
+
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  *seed = x;
+  return amplitude * ((float)x / (float)UINT32_MAX * 2.0f - 1.0f);
+}
+
+/**
+ * @brief Returns the period of a rate given in mHz in us, 0 for a rate of 0.
+ *
+ */
+uint32_t emul_period_us(uint32_t millihertz) { return millihertz ? (uint32_t)(1000000000ULL / millihertz) : 0; }
@@ -0,0 +1,116 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: emul_sensor.h
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef EMUL_SENSOR_H
+#define EMUL_SENSOR_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/drivers/emul.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/i2c.h>
+
+/*
+ * I2C emulators of the shield
+ *
+ * The native_sim build replaces the parts of the SENSEI board and shield with Zephyr I2C emulators on two
+ * zephyr,i2c-emul-controller buses behind the i2ca and i2cb aliases, see boards/native_sim.overlay. The firmware runs
+ * unchanged on top of them: the wrappers in sensors/, the SDK drivers and the drivers in drivers/sensor/sensei talk to
+ * the same register maps and command sets as on the board.
+ *
+ * Every emulator models what the acquisition depends on:
+ *  - the register map or command set used by the drivers, with the reset values and the identification registers
+ *  - the conversion time of the configured mode, commands sent while a Sensirion part is busy are not acknowledged
+ *  - the data-ready flags and lines, driven on the GPIO emulator pins of drdy.c at the end of every conversion
+ *  - the supply and bus switches of pwr_bsp.c, a part behind an open switch does not acknowledge
+ *
+ * The measured values are slow waves with deterministic noise, so two runs of the same build see the same samples.
+ */
+
+#define EMUL_SENSIRION_MAX_WORDS 9
+#define EMUL_I2C_MAX_TARGETS 12
+
+// Bus traffic of a part, a transfer is one transaction from the start to the stop condition
+typedef struct {
+  const struct emul *target;
+  uint32_t transfers;
+  uint32_t nacks;
+  uint32_t bytes_written; // Payload bytes without the address byte
+  uint32_t bytes_read;
+} emul_i2c_stats_t;
+
+// Register access of a part with a register pointer, the pointer increments after every byte
+typedef struct {
+  // Maps the first byte of a write to the register pointer, NULL for parts addressed by register
+  uint8_t (*pointer)(const struct emul *target, uint8_t byte);
+  uint8_t (*read)(const struct emul *target, uint8_t reg);
+  void (*write)(const struct emul *target, uint8_t reg, uint8_t value);
+  // Whether the part acknowledges its address, NULL for an always powered part
+  bool (*present)(const struct emul *target);
+} emul_regmap_api_t;
+
+typedef struct emul_sensirion emul_sensirion_t;
+
+// Command of a Sensirion part, the handler returns the number of response words or a negative error to NACK
+typedef struct {
+  uint16_t code;
+  uint8_t args;
+  uint16_t time_ms; // Until the response can be read and the next command is accepted
+  int (*handler)(const struct emul *target, const uint16_t *args, uint16_t *response);
+} emul_sensirion_cmd_t;
+
+struct emul_sensirion {
+  const emul_sensirion_cmd_t *cmds;
+  size_t count;
+  bool (*present)(const struct emul *target);
+  int64_t busy_until;
+  uint16_t response[EMUL_SENSIRION_MAX_WORDS];
+  uint8_t words;
+};
+
+int emul_regmap_transfer(const struct emul *target, const emul_regmap_api_t *api, struct i2c_msg *msgs, int num_msgs);
+int emul_sensirion_transfer(const struct emul *target, emul_sensirion_t *state, struct i2c_msg *msgs, int num_msgs);
+void emul_sensirion_reset(emul_sensirion_t *state);
+
+const emul_i2c_stats_t *emul_i2c_stats(size_t *count);
+void emul_i2c_stats_reset(void);
+
+bool emul_line_on(const struct gpio_dt_spec *spec);
+void emul_line_drive(const struct gpio_dt_spec *spec, bool active);
+
+float emul_wave(float mean, float amplitude, uint32_t period_s, uint32_t phase_s);
+float emul_noise(uint32_t *seed, float amplitude);
+uint32_t emul_period_us(uint32_t millihertz);
+
+// Pins of the board, a missing node leaves the line unmodelled
+#define EMUL_LINE(label) GPIO_DT_SPEC_GET_OR(DT_NODELABEL(label), gpios, {0})
+
+#endif /* EMUL_SENSOR_H */
@@ -0,0 +1,164 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: emul_sgp41.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#define DT_DRV_COMPAT sensei_sgp41
+
+#include <errno.h>
+#include <math.h>
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/emul.h>
+#include <zephyr/drivers/i2c_emul.h>
+#include <zephyr/kernel.h>
+
+#include "emul_sensor.h"
+
+#define SGP41_EMUL_MEASURE_TIME 50     // Conditioning and raw signal measurement in ms
+#define SGP41_EMUL_BOOT_TIME 1         // From power-up until the first command is accepted in ms
+#define SGP41_EMUL_HEATER_TAU 3000.0f  // Time constant of the hotplate settling after it was switched on in ms
+#define SGP41_EMUL_COLD_OFFSET 6000.0f // Offset of the raw signals with a cold hotplate in ticks
+
+struct sgp41_emul_data {
+  emul_sensirion_t bus;
+  bool powered;
+  int64_t heater_on; // Start of the current heating period in ms, 0 with the heater off
+  uint32_t seed;
+};
+
+struct sgp41_emul_cfg {
+  struct gpio_dt_spec supply;
+  struct gpio_dt_spec bus;
+  uint16_t addr;
+};
+
+/**
+ * @brief Returns the offset of the raw signals while the hotplate settles after switching it on.
+ *
+ */
+static float sgp41_emul_heating(struct sgp41_emul_data *data) {
+  int64_t now = k_uptime_get();
+
+  if (data->heater_on == 0) {
+    data->heater_on = now;
+  }
+  return SGP41_EMUL_COLD_OFFSET * expf(-(now - data->heater_on) / SGP41_EMUL_HEATER_TAU);
+}
+
+static uint16_t sgp41_emul_voc(struct sgp41_emul_data *data) {
+  return (uint16_t)(emul_wave(27000.0f, 1500.0f, 1200, 0) + emul_noise(&data->seed, 40.0f) + sgp41_emul_heating(data));
+}
+
+static int sgp41_execute_conditioning(const struct emul *target, const uint16_t *args, uint16_t *response) {
+  response[0] = sgp41_emul_voc(target->data);
+  return 1;
+}
+
+static int sgp41_measure_raw_signals(const struct emul *target, const uint16_t *args, uint16_t *response) {
+  struct sgp41_emul_data *data = target->data;
+
+  response[0] = sgp41_emul_voc(data);
+  response[1] = (uint16_t)(emul_wave(16000.0f, 300.0f, 2400, 600) + emul_noise(&data->seed, 20.0f) +
+                           sgp41_emul_heating(data) / 2);
+  return 2;
+}
+
+static int sgp41_execute_self_test(const struct emul *target, const uint16_t *args, uint16_t *response) {
+  response[0] = 0xD400; // VOC and NOx pixel passed
+  return 1;
+}
+
+static int sgp41_turn_heater_off(const struct emul *target, const uint16_t *args, uint16_t *response) {
+  ((struct sgp41_emul_data *)target->data)->heater_on = 0;
+  return 0;
+}
+
+static int sgp41_get_serial_number(const struct emul *target, const uint16_t *args, uint16_t *response) {
+  response[0] = 0x5690;
+  response[1] = 0x4100;
+  response[2] = ((const struct sgp41_emul_cfg *)target->cfg)->addr;
+  return 3;
+}
+
+static const emul_sensirion_cmd_t sgp41_cmds[] = {
+    {0x2612, 2, SGP41_EMUL_MEASURE_TIME, sgp41_execute_conditioning},
+    {0x2619, 2, SGP41_EMUL_MEASURE_TIME, sgp41_measure_raw_signals},
+    {0x280E, 0, 320, sgp41_execute_self_test},
+    {0x3615, 0, 1, sgp41_turn_heater_off},
+    {0x3682, 0, 1, sgp41_get_serial_number},
+};
+
+/**
+ * @brief Acknowledges only with supply and bus switch on, a part powered up again has a cold hotplate.
+ *
+ */
+static bool sgp41_emul_present(const struct emul *target) {
+  const struct sgp41_emul_cfg *cfg = target->cfg;
+  struct sgp41_emul_data *data = target->data;
+
+  if (!emul_line_on(&cfg->supply)) {
+    data->powered = false;
+    return false;
+  }
+  if (!data->powered) {
+    data->powered = true;
+    data->heater_on = 0;
+    emul_sensirion_reset(&data->bus);
+    data->bus.busy_until = k_uptime_get() + SGP41_EMUL_BOOT_TIME;
+  }
+  return emul_line_on(&cfg->bus);
+}
+
+static int sgp41_emul_transfer(const struct emul *target, struct i2c_msg *msgs, int num_msgs, int addr) {
+  return emul_sensirion_transfer(target, &((struct sgp41_emul_data *)target->data)->bus, msgs, num_msgs);
+}
+
+static const struct i2c_emul_api sgp41_emul_api = {
+    .transfer = sgp41_emul_transfer,
+};
+
+static int sgp41_emul_init(const struct emul *target, const struct device *parent) {
+  struct sgp41_emul_data *data = target->data;
+
+  data->bus.cmds = sgp41_cmds;
+  data->bus.count = ARRAY_SIZE(sgp41_cmds);
+  data->bus.present = sgp41_emul_present;
+  data->seed = 0x59410;
+  return 0;
+}
+
+#define SGP41_EMUL(n)                                                                                                  \
+  static struct sgp41_emul_data sgp41_emul_data_##n;                                                                   \
+  static const struct sgp41_emul_cfg sgp41_emul_cfg_##n = {                                                            \
+      .supply = EMUL_LINE(gpio_sgp41_pwr),                                                                             \
+      .bus = EMUL_LINE(gpio_ext_i2c_sgp41_en),                                                                         \
+      .addr = DT_INST_REG_ADDR(n),                                                                                     \
+  };                                                                                                                   \
+  EMUL_DT_INST_DEFINE(n, sgp41_emul_init, &sgp41_emul_data_##n, &sgp41_emul_cfg_##n, &sgp41_emul_api, NULL)
+
+DT_INST_FOREACH_STATUS_OKAY(SGP41_EMUL)
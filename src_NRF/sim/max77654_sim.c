@@ -0,0 +1,168 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: max77654_sim.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/emul.h>
+#include <zephyr/drivers/i2c.h>
+
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_ctrl.h>
+
+#include "config.h"
+#include "max77654_sensor.h"
+
+#include "pwr/pwr_common.h"
+
+#include "emul_max77654.h"
+
+LOG_MODULE_DECLARE(sensors, LOG_LEVEL_INF);
+
+#define PMIC_NODE DT_INST(0, sensei_max77654)
+
+static const struct device *const i2c_a = DEVICE_DT_GET(DT_ALIAS(i2ca));
+static const struct emul *const pmic_emul = EMUL_DT_GET(PMIC_NODE);
+
+/**
+ * @brief Returns the CNFG_CHG_I setting of a channel of the SDK, or -EINVAL for an unknown channel.
+ *
+ */
+static int max77654_sim_channel(int index) {
+  if (index >= MAX77654_BATT_I_8MA2 && index <= MAX77654_BATT_I_300MA) {
+    return ((index - MAX77654_BATT_I_8MA2) << 4) | MAX77654_EMUL_MUX_BATT_I_DISCHG;
+  }
+
+  switch (index) {
+  case MAX77654_AGND:
+    return MAX77654_EMUL_MUX_AGND;
+  case MAX77654_VSYS:
+    return MAX77654_EMUL_MUX_VSYS;
+  case MAX77654_CHGIN_V:
+    return MAX77654_EMUL_MUX_CHGIN_V;
+  case MAX77654_CHGIN_I:
+    return MAX77654_EMUL_MUX_CHGIN_I;
+  case MAX77654_BATT_V:
+    return MAX77654_EMUL_MUX_BATT_V;
+  case MAX77654_BATT_I_CHG:
+    return MAX77654_EMUL_MUX_BATT_I_CHG;
+  case MAX77654_THM:
+    return MAX77654_EMUL_MUX_THM;
+  case MAX77654_TBIAS:
+    return MAX77654_EMUL_MUX_TBIAS;
+  default:
+    return -EINVAL;
+  }
+}
+
+/**
+ * @brief Measures a channel like max77654_measure() of the SDK.
+ *
+ * The multiplexer is selected over I2C, the AMUX voltage that the SAADC samples on the board is taken from the
+ * emulator and scaled with the full scale of the channel. Must be called with pwr_mutex held.
+ */
+static int max77654_sim_measure(int index, int *value) {
+  int cnfg = max77654_sim_channel(index);
+
+  if (cnfg < 0) {
+    return cnfg;
+  }
+
+  int rc = i2c_reg_write_byte(i2c_a, DT_REG_ADDR(PMIC_NODE), MAX77654_EMUL_CNFG_CHG_I, cnfg);
+  if (rc < 0) {
+    return rc;
+  }
+
+  uint64_t full_scale = emul_max77654_full_scale(cnfg & 0x0F, cnfg >> 4);
+  *value = (int)(emul_max77654_amux_mv(pmic_emul) * full_scale / MAX77654_EMUL_AMUX_FULL_SCALE / 1000);
+
+  return NO_ERROR;
+}
+
+void test_max77654() {
+  LOG_INF("Testing MAX77654 (PMIC, emulated)" SPACES);
+
+  k_mutex_lock(&pwr_mutex, K_FOREVER);
+
+  int value;
+
+  const struct {
+    const char *name;
+    const char *unit;
+    int index;
+  } value_names[] = {
+      {"AGND Voltage                        ", "mV", MAX77654_AGND},
+      {"VSYS Voltage                        ", "mV", MAX77654_VSYS},
+      {"CHGIN Voltage                       ", "mV", MAX77654_CHGIN_V},
+      {"CHGIN Current                       ", "mA", MAX77654_CHGIN_I},
+      {"Battery Voltage                     ", "mV", MAX77654_BATT_V},
+      {"Battery Current                     ", "%", MAX77654_BATT_I_CHG},
+      {"Battery Discharge Current           ", "mA", MAX77654_BATT_I_8MA2},
+      {"Thermistor Voltage                  ", "mV", MAX77654_THM},
+      {"Thermistor Bias                     ", "mV", MAX77654_TBIAS},
+  };
+
+  for (size_t i = 0; i < ARRAY_SIZE(value_names); i++) {
+    if (max77654_sim_measure(value_names[i].index, &value) != NO_ERROR) {
+      LOG_ERR(" * PMIC measure failed!");
+      k_mutex_unlock(&pwr_mutex);
+      return;
+    }
+    LOG_INF(" - %s: %i %s" SPACES, value_names[i].name, value, value_names[i].unit);
+  }
+
+  k_mutex_unlock(&pwr_mutex);
+}
+
+/**
+ * @brief Measures the supply and battery channels used by the energy meter, see max77654_sensor.c.
+ *
+ */
+int measure_max77654(int *vsys, int *vbat, int *charge, int *discharge, int discharge_range) {
+  const struct {
+    int index;
+    int *value;
+  } channels[] = {
+      {MAX77654_VSYS, vsys},
+      {MAX77654_BATT_V, vbat},
+      {MAX77654_BATT_I_CHG, charge},
+      {discharge_range, discharge},
+  };
+  int error = NO_ERROR;
+
+  k_mutex_lock(&pwr_mutex, K_FOREVER);
+  for (size_t i = 0; i < ARRAY_SIZE(channels); i++) {
+    if (max77654_sim_measure(channels[i].index, channels[i].value) != NO_ERROR) {
+      LOG_ERR(" * MAX77654 Error measuring channel %d", channels[i].index);
+      error = -EIO;
+      break;
+    }
+  }
+  k_mutex_unlock(&pwr_mutex);
+
+  return error;
+}
@@ -1,11 +1,11 @@
 /*
  * ----------------------------------------------------------------------
  *
- * File: util.c
+ * File: max_m10s_sim.c
  *
- * Last edited: 30.10.2025
+ * Last edited: 16.10.2026
  *
- * Copyright (c) 2024 ETH Zurich and University of Bologna
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
  *
  * Authors:
  * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
@@ -26,22 +26,16 @@
  * limitations under the License.
  */
 
-#include <zephyr/device.h>
-#include <zephyr/kernel.h>
 
-#include <zephyr/drivers/gpio.h>
+#include <zephyr/logging/log.h>
 
-#include "util.h"
+#include "config.h"
+#include "max_m10s_sensor.h"
 
-#define GPIO_NODE_debug_signal_2 DT_NODELABEL(gpio_debug_signal_2)
-static const struct gpio_dt_spec gpio_debug_2 = GPIO_DT_SPEC_GET(GPIO_NODE_debug_signal_2, gpios);
+LOG_MODULE_DECLARE(sensors, LOG_LEVEL_DBG);
 
-/**
- * @brief Sends a sync signal to the debug signal GPIO pin.
- *
- */
-void sync() {
-  gpio_pin_set_dt(&gpio_debug_2, 1);
-  k_msleep(1);
-  gpio_pin_set_dt(&gpio_debug_2, 0);
-}
+// The GNSS module is not emulated, ubxlib is disabled on native_sim
+
+void test_max_m10s() { LOG_INF("Testing MAX-M10S (GNSS Module) skipped, not emulated" SPACES); }
+
+void poweroff_max_m10s() { LOG_DBG("Power Off MAX-M10S (GNSS Module) skipped, not emulated" SPACES); }
@@ -0,0 +1,123 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: pwr_sim.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include "pwr/pwr.h"
+#include "pwr/pwr_common.h"
+
+#include "emul_max77654.h"
+
+// ======== Defines/Variables ======================================================================
+
+LOG_MODULE_REGISTER(pwr_sim, LOG_LEVEL_INF);
+
+K_MUTEX_DEFINE(pwr_mutex);
+
+static const struct device *pwr_i2c = DEVICE_DT_GET(DT_ALIAS(i2ca));
+
+#define PMIC_NODE DT_INST(0, sensei_max77654)
+#define PMIC_ADDR DT_REG_ADDR(PMIC_NODE)
+
+#define PWR_LINE(label, name) {name, GPIO_DT_SPEC_GET(DT_NODELABEL(label), gpios)}
+
+// Power gating pins of pwr_bsp.c, all switched off until a sensor is powered
+static const struct {
+  const char *name;
+  struct gpio_dt_spec spec;
+} pwr_lines[] = {
+    PWR_LINE(gpio_scd41_pwr, "SCD41 EN"),
+    PWR_LINE(gpio_sgp41_pwr, "SGP41 EN"),
+    PWR_LINE(gpio_ext_i2c_sgp41_en, "SGP41 I2C EN"),
+    PWR_LINE(gpio_ext_i2c_as7331_en, "AS7331 I2C EN"),
+    PWR_LINE(gpio_ext_i2c_scd41_en, "SCD41 I2C EN"),
+    PWR_LINE(gpio_ext_hm0360_clk_en, "HM0360 CLK EN"),
+    PWR_LINE(gpio_gap9_i2c_ctrl, "GAP9 I2C"),
+};
+
+// Regulator settings of pwr_bsp_start(), SBB in 50 mV and LDO in 25 mV steps above 800 mV, enabled in buck-boost
+// and LDO mode with 1 A peak current and without active discharge
+#define PMIC_SBB_MV(mv) (((mv) - 800) / 50)
+#define PMIC_LDO_MV(mv) (((mv) - 800) / 25)
+#define PMIC_REG_ON 0x06
+
+static const uint8_t pmic_conf[][2] = {
+    {MAX77654_EMUL_CNFG_SBB0_A, PMIC_SBB_MV(3300)}, {MAX77654_EMUL_CNFG_SBB0_A + 1, PMIC_REG_ON},
+    {MAX77654_EMUL_CNFG_SBB0_A + 2, PMIC_SBB_MV(2800)}, {MAX77654_EMUL_CNFG_SBB0_A + 3, PMIC_REG_ON},
+    {MAX77654_EMUL_CNFG_SBB0_A + 4, PMIC_SBB_MV(1200)}, {MAX77654_EMUL_CNFG_SBB0_A + 5, PMIC_REG_ON},
+    {MAX77654_EMUL_CNFG_LDO0_A, PMIC_LDO_MV(3300)}, {MAX77654_EMUL_CNFG_LDO0_A + 1, PMIC_REG_ON},
+};
+
+// ======== Functions ==============================================================================
+
+/**
+ * @brief Configures the power gating pins, the native_sim counterpart of the SDK pwr_init() and pwr_bsp_init().
+ *
+ */
+int pwr_init(void) {
+  for (size_t i = 0; i < ARRAY_SIZE(pwr_lines); i++) {
+    if (gpio_pin_configure_dt(&pwr_lines[i].spec, GPIO_OUTPUT_INACTIVE) < 0) {
+      LOG_ERR("%s GPIO init error", pwr_lines[i].name);
+      return -1;
+    }
+  }
+
+  if (!device_is_ready(pwr_i2c)) {
+    LOG_ERR("PWR I2C not ready!");
+    return -1;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Programs the regulators of the emulated PMIC like pwr_bsp_start().
+ *
+ */
+int pwr_start(void) {
+  int rc = 0;
+
+  k_mutex_lock(&pwr_mutex, K_FOREVER);
+  for (size_t i = 0; i < ARRAY_SIZE(pmic_conf) && rc == 0; i++) {
+    rc = i2c_reg_write_byte(pwr_i2c, PMIC_ADDR, pmic_conf[i][0], pmic_conf[i][1]);
+  }
+  k_mutex_unlock(&pwr_mutex);
+
+  if (rc < 0) {
+    LOG_ERR("PMIC configuration failed (%d)", rc);
+    return rc;
+  }
+
+  LOG_INF("PMIC configured for UT SensorShield (emulated)");
+
+  return 0;
+}
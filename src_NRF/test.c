@@ -26,6 +26,8 @@
  * limitations under the License.
  */
 
+#include <stdio.h>
+
 #include <zephyr/device.h>
 #include <zephyr/kernel.h>
 
@@ -35,6 +37,8 @@
 #include <zephyr/drivers/sensor.h>
 #include <zephyr/drivers/uart.h>
 
+#include <zephyr/timing/timing.h>
+
 #include <zephyr/logging/log.h>
 #include <zephyr/logging/log_ctrl.h>
 
@@ -46,20 +50,11 @@
 #include "pwr/thread_pwr.h"
 
 #include "config.h"
+#include "fmt.h"
 #include "i2c_helpers.h"
+#include "sensor.h"
 #include "test.h"
-#include "util.h"
-
-#include "as7331_sensor.h"
-#include "bh1730fvc_sensor.h"
-#include "bme688_sensor.h"
-#include "ilps28qsw_sensor.h"
-#include "ism330dhcx_sensor.h"
-#include "lis2duxs12_sensor.h"
-#include "max77654_sensor.h"
-#include "max_m10s_sensor.h"
-#include "scd41_sensor.h"
-#include "sgp41_sensor.h"
+#include "trace.h"
 
 #define GPIO_NODE_debug_signal_1 DT_NODELABEL(gpio_debug_signal_1)
 static const struct gpio_dt_spec gpio_debug_1 = GPIO_DT_SPEC_GET(GPIO_NODE_debug_signal_1, gpios);
@@ -127,64 +122,105 @@ void test_sensors(void) {
   printf("\r\n");
 #endif
 
-  sync();
-  gpio_pin_set_dt(&gpio_debug_1, 1);
-  poweron_as7331();
-  test_as7331();
-  poweroff_as7331();
-  gpio_pin_set_dt(&gpio_debug_1, 0);
-
-  sync();
-  gpio_pin_set_dt(&gpio_debug_1, 1);
-  poweron_bh1730();
-  test_bh1730fvc();
-  poweroff_bh1730();
-  gpio_pin_set_dt(&gpio_debug_1, 0);
-
-  sync();
-  gpio_pin_set_dt(&gpio_debug_1, 1);
-  test_ism330dhcx();
-  gpio_pin_set_dt(&gpio_debug_1, 0);
-
-  sync();
-  gpio_pin_set_dt(&gpio_debug_1, 1);
-  test_lis2duxs12();
-  gpio_pin_set_dt(&gpio_debug_1, 0);
-
-  sync();
-  gpio_pin_set_dt(&gpio_debug_1, 1);
-  test_bme688();
-  gpio_pin_set_dt(&gpio_debug_1, 0);
-
-  sync();
-  gpio_pin_set_dt(&gpio_debug_1, 1);
-  test_ilpS28qsw();
-  gpio_pin_set_dt(&gpio_debug_1, 0);
-
-  sync();
-  gpio_pin_set_dt(&gpio_debug_1, 1);
-  poweron_scd41();
-  test_scd41();
-  poweroff_scd41();
-  gpio_pin_set_dt(&gpio_debug_1, 0);
-
-  sync();
-  gpio_pin_set_dt(&gpio_debug_1, 1);
-  poweron_sgp41();
-  test_sgp41();
-  poweroff_sgp41();
-  gpio_pin_set_dt(&gpio_debug_1, 0);
-
-  sync();
-  gpio_pin_set_dt(&gpio_debug_1, 1);
-  test_max77654();
-  gpio_pin_set_dt(&gpio_debug_1, 0);
-
-  sync();
-  poweroff_max_m10s();
-  // gpio_pin_set_dt(&gpio_debug_1, 1);
-  // test_max_m10s();
-  // gpio_pin_set_dt(&gpio_debug_1, 0);
-
-  sync();
-}
\ No newline at end of file
+  // Every part is powered on for its self-test and powered off again, the acquisition powers them on itself
+  for (size_t i = 0; i < SENSOR_COUNT; i++) {
+    const sensor_driver_t *driver = &sensor_registry[i];
+
+    TRACE_INSTANT(TEST, i + 1);
+    gpio_pin_set_dt(&gpio_debug_1, 1);
+    sensor_power_up(BIT(i));
+    if (driver->test) {
+      driver->test();
+    }
+    if (driver->power_off) {
+      driver->power_off();
+    }
+    gpio_pin_set_dt(&gpio_debug_1, 0);
+  }
+  TRACE_INSTANT(TEST, SENSOR_COUNT + 1);
+}
+
+#if FMT_BENCHMARK
+static uint64_t test_fmt_cycles(int (*format)(char *buf, const sensor_values_t *record), char *buf,
+                                const sensor_values_t *record, int *len) {
+  uint64_t best = UINT64_MAX;
+
+  // The minimum over several runs excludes interrupts and cache effects
+  for (int i = 0; i < FMT_BENCHMARK_RUNS; i++) {
+    timing_t start = timing_counter_get();
+    *len = format(buf, record);
+    timing_t end = timing_counter_get();
+
+    best = MIN(best, timing_cycles_get(&start, &end));
+  }
+  return best;
+}
+
+static int test_fmt_printf(char *buf, const sensor_values_t *r) { return fmt_record_printf(buf, FMT_CSV_MAX_LINE, r); }
+
+static int test_fmt_fixed(char *buf, const sensor_values_t *r) { return fmt_record_csv(buf, r); }
+#endif
+
+/**
+ * @brief Compares the cycles per record of the printf and the fixed-point CSV formatter.
+ *
+ * Needs CONFIG_SENSOR_HUB_FLOAT_PRINTF. The code size difference is visible in the ROM report
+ * (west build -t rom_report) with the option enabled and disabled.
+ */
+void test_fmt(void) {
+#if FMT_BENCHMARK
+  // Typical record of the sensorhub
+  static const sensor_values_t record = {
+      .timestamp = 3605000,
+#if SCD41_ENABLED
+      .scd41_co2 = 612,
+      .scd41_temperature = 23.456f,
+      .scd41_humidity = 41.234f,
+#endif
+#if SGP41_ENABLED
+      .sgp41_voc = 30512,
+      .sgp41_nox = 16384,
+#endif
+#if ILPS28QSW_ENABLED
+      .ilps28qsw_pressure = 968.4321f,
+      .ilps28qsw_temperature = 24.12f,
+#endif
+#if BME688_ENABLED
+      .bme688_temperature = 24.51f,
+      .bme688_pressure = 96.843f,
+      .bme688_humidity = 40.125f,
+      .bme688_gas_resistance = 123456.0f,
+#endif
+#if BH1730FVC_ENABLED
+      .bh1730_visible = 1234,
+      .bh1730_ir = 321,
+      .bh1730_lux = 456,
+#endif
+#if AS7331_ENABLED
+      .as7331_temp = 25.35f,
+      .as7331_uva = 120,
+      .as7331_uvb = 45,
+      .as7331_uvc = 3,
+#endif
+#if ENERGY_ENABLED
+      .max77654_vsys = 3912,
+      .max77654_vbat = 3874,
+      .max77654_charge = 6120,
+      .max77654_energy = 23705,
+#endif
+  };
+  char line[FMT_CSV_MAX_LINE];
+  int printf_len, fixed_len;
+
+  timing_init();
+  timing_start();
+
+  uint64_t printf_cycles = test_fmt_cycles(test_fmt_printf, line, &record, &printf_len);
+  LOG_INF(" - printf      : %llu cycles, %d bytes", printf_cycles, printf_len);
+
+  uint64_t fixed_cycles = test_fmt_cycles(test_fmt_fixed, line, &record, &fixed_len);
+  LOG_INF(" - fixed-point : %llu cycles, %d bytes", fixed_cycles, fixed_len);
+
+  timing_stop();
+#endif
+}
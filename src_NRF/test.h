@@ -32,5 +32,6 @@
 #include <stdint.h>
 
 void test_sensors(void);
+void test_fmt(void);
 
 #endif /* UTIL_H */
\ No newline at end of file
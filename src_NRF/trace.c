@@ -0,0 +1,157 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: trace.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/printk.h>
+
+#include <zephyr/drivers/gpio.h>
+
+#if defined(CONFIG_CPU_CORTEX_M_HAS_DWT)
+#include <cmsis_core.h>
+#endif
+
+#include "trace.h"
+
+#if TRACE_ENABLED
+
+BUILD_ASSERT(IS_POWER_OF_TWO(TRACE_BUFFER_SIZE), "TRACE_BUFFER_SIZE must be a power of two");
+
+#define TRACE_EVENT_NAME(name) #name,
+static const char *const trace_names[] = {TRACE_EVENTS(TRACE_EVENT_NAME)};
+#undef TRACE_EVENT_NAME
+
+static trace_entry_t trace_buf[TRACE_BUFFER_SIZE];
+static atomic_t trace_head = ATOMIC_INIT(0);
+static uint32_t trace_tail = 0;
+
+// Serializes the dumps of the output thread and the shell
+static K_MUTEX_DEFINE(trace_dump_lock);
+
+#if TRACE_GPIO
+#define GPIO_NODE_debug_signal_2 DT_NODELABEL(gpio_debug_signal_2)
+static const struct gpio_dt_spec gpio_debug_2 = GPIO_DT_SPEC_GET(GPIO_NODE_debug_signal_2, gpios);
+#endif
+
+static inline uint32_t trace_cycles(void) {
+#if defined(CONFIG_CPU_CORTEX_M_HAS_DWT)
+  return DWT->CYCCNT;
+#else
+  return k_cycle_get_32();
+#endif
+}
+
+static inline uint32_t trace_clock_hz(void) {
+#if defined(CONFIG_CPU_CORTEX_M_HAS_DWT)
+  // DWT counts CPU cycles
+  return SystemCoreClock;
+#else
+  return sys_clock_hw_cycles_per_sec();
+#endif
+}
+
+/**
+ * @brief Starts the cycle counter.
+ *
+ */
+void trace_init(void) {
+#if defined(CONFIG_CPU_CORTEX_M_HAS_DWT)
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+}
+
+/**
+ * @brief Records an event, safe to call from any thread and from interrupts.
+ *
+ * The oldest entries are overwritten when the ring is full.
+ */
+void trace_event(trace_event_t event, trace_phase_t phase, uint16_t arg) {
+  uint32_t idx = atomic_inc(&trace_head);
+  trace_entry_t *entry = &trace_buf[idx & (TRACE_BUFFER_SIZE - 1)];
+
+  entry->cycles = trace_cycles();
+  entry->event = event;
+  entry->phase = phase;
+  entry->arg = arg;
+
+#if TRACE_GPIO
+  // Keeps the event visible on a logic analyzer, a toggle needs no delay
+  gpio_pin_toggle_dt(&gpio_debug_2);
+#endif
+}
+
+/**
+ * @brief Prints and removes all recorded entries.
+ *
+ * Entries recorded while dumping are kept for the next dump, the buffer must not span more than one wrap of the cycle
+ * counter. The format is read by scripts/trace2perfetto.py. Prints up to TRACE_BUFFER_SIZE lines, so it must not be
+ * called from a traced task, see output_send_trace().
+ */
+void trace_dump(void) {
+  k_mutex_lock(&trace_dump_lock, K_FOREVER);
+
+  uint32_t head = atomic_get(&trace_head);
+  uint32_t lost = 0;
+
+  if (head - trace_tail > TRACE_BUFFER_SIZE) {
+    lost = head - trace_tail - TRACE_BUFFER_SIZE;
+    trace_tail = head - TRACE_BUFFER_SIZE;
+  }
+
+  // The current cycles and uptime anchor the entries, the cycle counter wraps within a minute
+  printk("TRACE_DUMP %u %u %u %u %u\n", trace_clock_hz(), head - trace_tail, lost, trace_cycles(), k_uptime_get_32());
+  for (size_t i = 0; i < ARRAY_SIZE(trace_names); i++) {
+    printk("TRACE_NAME %u %s\n", i, trace_names[i]);
+  }
+  for (; trace_tail != head; trace_tail++) {
+    trace_entry_t entry = trace_buf[trace_tail & (TRACE_BUFFER_SIZE - 1)];
+
+    printk("TRACE %u %u %u %u\n", entry.cycles, entry.event, entry.phase, entry.arg);
+  }
+  printk("TRACE_DUMP_END\n");
+  k_mutex_unlock(&trace_dump_lock);
+}
+
+#if defined(CONFIG_SHELL)
+static int cmd_trace(const struct shell *sh, size_t argc, char **argv) {
+  ARG_UNUSED(sh);
+  ARG_UNUSED(argc);
+  ARG_UNUSED(argv);
+
+  trace_dump();
+  return 0;
+}
+
+SHELL_CMD_REGISTER(trace, NULL, "Print and clear the recorded tracepoints", cmd_trace);
+#endif
+
+#endif
@@ -0,0 +1,101 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: trace.h
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+
+#include "config.h"
+
+/*
+ * Tracepoints
+ *
+ * Every tracepoint stores the cycle counter, an event id and a 16 bit argument into a RAM ring, which costs a few
+ * cycles and does not sleep. trace_dump() prints the ring as text, scripts/trace2perfetto.py converts a captured dump
+ * into a trace for https://ui.perfetto.dev. With TRACE_ENABLED set to 0 all tracepoints compile to nothing.
+ *
+ * Events with the same id are shown on one track, TRACE_BEGIN/TRACE_END pairs become slices and TRACE_INSTANT a
+ * marker.
+ */
+
+#define TRACE_EVENTS(X)                                                                                                \
+  X(SCD41)                                                                                                             \
+  X(SGP41)                                                                                                             \
+  X(ILPS28QSW)                                                                                                         \
+  X(BME688)                                                                                                            \
+  X(BH1730FVC)                                                                                                         \
+  X(AS7331)                                                                                                            \
+  X(RECORD)                                                                                                            \
+  X(OUTPUT)                                                                                                            \
+  X(FLOG)                                                                                                              \
+  X(DRDY)                                                                                                              \
+  X(TEST)
+
+#define TRACE_EVENT_ID(name) TRACE_##name,
+typedef enum { TRACE_EVENTS(TRACE_EVENT_ID) TRACE_EVENT_COUNT } trace_event_t;
+#undef TRACE_EVENT_ID
+
+typedef enum {
+  TRACE_PHASE_INSTANT,
+  TRACE_PHASE_BEGIN,
+  TRACE_PHASE_END,
+} trace_phase_t;
+
+typedef struct {
+  uint32_t cycles;
+  uint8_t event;
+  uint8_t phase;
+  uint16_t arg;
+} trace_entry_t;
+
+#if TRACE_ENABLED
+void trace_init(void);
+void trace_event(trace_event_t event, trace_phase_t phase, uint16_t arg);
+void trace_dump(void);
+
+#define TRACE_INSTANT(event, arg) trace_event(TRACE_##event, TRACE_PHASE_INSTANT, (arg))
+#define TRACE_BEGIN(event, arg) trace_event(TRACE_##event, TRACE_PHASE_BEGIN, (arg))
+#define TRACE_END(event, arg) trace_event(TRACE_##event, TRACE_PHASE_END, (arg))
+#define TRACE_ID_INSTANT(id, arg) trace_event((id), TRACE_PHASE_INSTANT, (arg))
+#define TRACE_ID_BEGIN(id, arg) trace_event((id), TRACE_PHASE_BEGIN, (arg))
+#define TRACE_ID_END(id, arg) trace_event((id), TRACE_PHASE_END, (arg))
+#else
+static inline void trace_init(void) {}
+static inline void trace_dump(void) {}
+
+#define TRACE_INSTANT(event, arg)
+#define TRACE_BEGIN(event, arg)
+#define TRACE_END(event, arg)
+#define TRACE_ID_INSTANT(id, arg)
+#define TRACE_ID_BEGIN(id, arg)
+#define TRACE_ID_END(id, arg)
+#endif
+
+#endif /* TRACE_H */
@@ -0,0 +1,364 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: tscodec.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+
+#include "tscodec.h"
+
+// ----------------- Bit stream ----------------------------------------------------------------------------------------
+static void bits_put(tscodec_bits_t *bits, uint32_t value, uint8_t n) {
+  while (n--) {
+    uint8_t *byte = &bits->buf[bits->bit >> 3];
+    uint8_t mask = 0x80 >> (bits->bit & 7);
+
+    if (value & BIT(n)) {
+      *byte |= mask;
+    } else {
+      *byte &= ~mask;
+    }
+    bits->bit++;
+  }
+}
+
+static uint32_t bits_get(tscodec_bits_t *bits, uint8_t n) {
+  uint32_t value = 0;
+
+  if (bits->bit + n > bits->size * 8) {
+    bits->overflow = true;
+    return 0;
+  }
+  while (n--) {
+    value = (value << 1) | ((bits->buf[bits->bit >> 3] >> (7 - (bits->bit & 7))) & 1);
+    bits->bit++;
+  }
+  return value;
+}
+
+static void bits_put_varint(tscodec_bits_t *bits, uint32_t value) {
+  while (value >= 0x80) {
+    bits_put(bits, 0x80 | (value & 0x7F), 8);
+    value >>= 7;
+  }
+  bits_put(bits, value, 8);
+}
+
+static uint32_t bits_get_varint(tscodec_bits_t *bits) {
+  uint32_t value = 0;
+
+  for (uint8_t shift = 0; shift < 35; shift += 7) {
+    uint32_t group = bits_get(bits, 8);
+
+    value |= (group & 0x7F) << shift;
+    if (!(group & 0x80)) {
+      break;
+    }
+  }
+  return value;
+}
+
+static inline uint32_t zigzag_encode(int32_t value) { return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31); }
+
+static inline int32_t zigzag_decode(uint32_t value) { return (int32_t)(value >> 1) ^ -(int32_t)(value & 1); }
+
+// ----------------- Channels ------------------------------------------------------------------------------------------
+static uint32_t channel_get(const sensor_values_t *record, const record_channel_t *ch) {
+  const uint8_t *field = (const uint8_t *)record + ch->offset;
+  uint16_t u16;
+  uint32_t u32;
+
+  if (ch->type == RECORD_U16) {
+    memcpy(&u16, field, sizeof(u16));
+    return u16;
+  }
+  // Floats are handled as their bit pattern
+  memcpy(&u32, field, sizeof(u32));
+  return u32;
+}
+
+static void channel_set(sensor_values_t *record, const record_channel_t *ch, uint32_t value) {
+  uint8_t *field = (uint8_t *)record + ch->offset;
+  uint16_t u16 = value;
+
+  if (ch->type == RECORD_U16) {
+    memcpy(field, &u16, sizeof(u16));
+  } else {
+    memcpy(field, &value, sizeof(value));
+  }
+}
+
+static void encode_timestamp(tscodec_t *enc, uint32_t timestamp) {
+  tscodec_state_t *s = &enc->state;
+  int32_t delta = (int32_t)(timestamp - s->timestamp);
+
+  // The first record is the reference, the second one sets the initial delta
+  if (enc->count == 0) {
+    bits_put(&enc->bits, timestamp, 32);
+  } else if (enc->count == 1) {
+    bits_put_varint(&enc->bits, zigzag_encode(delta));
+  } else {
+    uint32_t dod = zigzag_encode(delta - s->delta);
+
+    if (dod == 0) {
+      bits_put(&enc->bits, 0b0, 1);
+    } else if (dod < BIT(7)) {
+      bits_put(&enc->bits, 0b10, 2);
+      bits_put(&enc->bits, dod, 7);
+    } else if (dod < BIT(9)) {
+      bits_put(&enc->bits, 0b110, 3);
+      bits_put(&enc->bits, dod, 9);
+    } else if (dod < BIT(12)) {
+      bits_put(&enc->bits, 0b1110, 4);
+      bits_put(&enc->bits, dod, 12);
+    } else {
+      bits_put(&enc->bits, 0b1111, 4);
+      bits_put(&enc->bits, dod, 32);
+    }
+  }
+  s->delta = delta;
+  s->timestamp = timestamp;
+}
+
+static uint32_t decode_timestamp(tscodec_t *dec, uint16_t index) {
+  tscodec_state_t *s = &dec->state;
+  int32_t delta;
+
+  if (index == 0) {
+    s->timestamp = bits_get(&dec->bits, 32);
+    s->delta = 0;
+    return s->timestamp;
+  }
+
+  if (index == 1) {
+    delta = zigzag_decode(bits_get_varint(&dec->bits));
+  } else {
+    uint32_t dod;
+
+    if (bits_get(&dec->bits, 1) == 0) {
+      dod = 0;
+    } else if (bits_get(&dec->bits, 1) == 0) {
+      dod = bits_get(&dec->bits, 7);
+    } else if (bits_get(&dec->bits, 1) == 0) {
+      dod = bits_get(&dec->bits, 9);
+    } else if (bits_get(&dec->bits, 1) == 0) {
+      dod = bits_get(&dec->bits, 12);
+    } else {
+      dod = bits_get(&dec->bits, 32);
+    }
+    delta = s->delta + zigzag_decode(dod);
+  }
+  s->delta = delta;
+  s->timestamp += delta;
+  return s->timestamp;
+}
+
+static void encode_float(tscodec_t *enc, uint8_t index, uint32_t value) {
+  tscodec_state_t *s = &enc->state;
+  uint32_t xor = value ^ s->floats[index];
+
+  s->floats[index] = value;
+  if (xor == 0) {
+    bits_put(&enc->bits, 0b0, 1);
+    return;
+  }
+
+  uint8_t leading = MIN(__builtin_clz(xor), 31);
+  uint8_t trailing = __builtin_ctz(xor);
+
+  if (s->leading[index] + s->trailing[index] > 0 && leading >= s->leading[index] && trailing >= s->trailing[index]) {
+    // Meaningful bits fit into the window of the previous value
+    bits_put(&enc->bits, 0b10, 2);
+    bits_put(&enc->bits, xor >> s->trailing[index], 32 - s->leading[index] - s->trailing[index]);
+    return;
+  }
+
+  uint8_t length = 32 - leading - trailing;
+
+  bits_put(&enc->bits, 0b11, 2);
+  bits_put(&enc->bits, leading, 5);
+  bits_put(&enc->bits, length - 1, 5);
+  bits_put(&enc->bits, xor >> trailing, length);
+  s->leading[index] = leading;
+  s->trailing[index] = trailing;
+}
+
+static uint32_t decode_float(tscodec_t *dec, uint8_t index) {
+  tscodec_state_t *s = &dec->state;
+
+  if (bits_get(&dec->bits, 1) == 0) {
+    return s->floats[index];
+  }
+  if (bits_get(&dec->bits, 1) == 1) {
+    uint8_t leading = bits_get(&dec->bits, 5);
+    uint8_t length = bits_get(&dec->bits, 5) + 1;
+
+    s->leading[index] = leading;
+    s->trailing[index] = 32 - leading - length;
+  }
+
+  uint8_t length = 32 - s->leading[index] - s->trailing[index];
+
+  s->floats[index] ^= bits_get(&dec->bits, length) << s->trailing[index];
+  return s->floats[index];
+}
+
+static void encode_int(tscodec_t *enc, uint8_t index, uint32_t value) {
+  tscodec_state_t *s = &enc->state;
+  int32_t delta = (int32_t)(value - s->ints[index]);
+
+  s->ints[index] = value;
+  if (delta == 0) {
+    bits_put(&enc->bits, 0b0, 1);
+    return;
+  }
+  bits_put(&enc->bits, 0b1, 1);
+  bits_put_varint(&enc->bits, zigzag_encode(delta));
+}
+
+static uint32_t decode_int(tscodec_t *dec, uint8_t index) {
+  tscodec_state_t *s = &dec->state;
+
+  if (bits_get(&dec->bits, 1) == 1) {
+    s->ints[index] += zigzag_decode(bits_get_varint(&dec->bits));
+  }
+  return s->ints[index];
+}
+
+// ----------------- Encoder -------------------------------------------------------------------------------------------
+/**
+ * @brief Starts a new block.
+ *
+ * @param enc Encoder
+ * @param buf Block buffer, must be larger than TSCODEC_HEADER_SIZE + TSCODEC_MAX_RECORD_SIZE
+ * @param size Size of the block buffer
+ */
+void tscodec_init(tscodec_t *enc, uint8_t *buf, size_t size) {
+  memset(enc, 0, sizeof(*enc));
+  enc->bits.buf = buf;
+  enc->bits.size = size;
+  enc->bits.bit = TSCODEC_HEADER_SIZE * 8;
+}
+
+/**
+ * @brief Appends a record to the block.
+ *
+ * @return 0 on success, -ENOSPC if the block is full and must be finished first
+ */
+int tscodec_encode(tscodec_t *enc, const sensor_values_t *record) {
+  if (enc->count == UINT16_MAX || enc->bits.size < DIV_ROUND_UP(enc->bits.bit, 8) + TSCODEC_MAX_RECORD_SIZE) {
+    return -ENOSPC;
+  }
+
+  uint8_t ints = 0, floats = 0;
+
+  encode_timestamp(enc, record->timestamp);
+  // The timestamp is the first channel
+  for (size_t i = 1; i < RECORD_CHANNEL_COUNT; i++) {
+    const record_channel_t *ch = &record_channels[i];
+
+    if (ch->type == RECORD_F32) {
+      encode_float(enc, floats++, channel_get(record, ch));
+    } else {
+      encode_int(enc, ints++, channel_get(record, ch));
+    }
+  }
+  enc->count++;
+  return 0;
+}
+
+/**
+ * @brief Completes the block header and pads the last byte.
+ *
+ * The encoder must be initialized again before the next block.
+ *
+ * @return Size of the block in bytes
+ */
+size_t tscodec_finish(tscodec_t *enc) {
+  sys_put_le16(enc->count, enc->bits.buf);
+  if (enc->bits.bit & 7) {
+    bits_put(&enc->bits, 0, 8 - (enc->bits.bit & 7));
+  }
+  return enc->bits.bit / 8;
+}
+
+// ----------------- Decoder -------------------------------------------------------------------------------------------
+/**
+ * @brief Starts decoding a block.
+ *
+ * @return 0 on success, -EINVAL if the block is too short
+ */
+int tscodec_decode_init(tscodec_t *dec, const uint8_t *buf, size_t len) {
+  if (len < TSCODEC_HEADER_SIZE) {
+    return -EINVAL;
+  }
+
+  memset(dec, 0, sizeof(*dec));
+  // The decoder only reads from the buffer
+  dec->bits.buf = (uint8_t *)buf;
+  dec->bits.size = len;
+  dec->bits.bit = TSCODEC_HEADER_SIZE * 8;
+  dec->total = sys_get_le16(buf);
+  return 0;
+}
+
+/**
+ * @brief Decodes the next record of the block.
+ *
+ * @return 0 on success, -ENODATA at the end of the block, -EINVAL if the block is truncated
+ */
+int tscodec_decode(tscodec_t *dec, sensor_values_t *record) {
+  if (dec->count == dec->total) {
+    return -ENODATA;
+  }
+
+  uint8_t ints = 0, floats = 0;
+
+  memset(record, 0, sizeof(*record));
+  record->timestamp = decode_timestamp(dec, dec->count);
+  for (size_t i = 1; i < RECORD_CHANNEL_COUNT; i++) {
+    const record_channel_t *ch = &record_channels[i];
+
+    if (ch->type == RECORD_F32) {
+      channel_set(record, ch, decode_float(dec, floats++));
+    } else {
+      channel_set(record, ch, decode_int(dec, ints++));
+    }
+  }
+
+  if (dec->bits.overflow) {
+    return -EINVAL;
+  }
+  dec->count++;
+  return 0;
+}
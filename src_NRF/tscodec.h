@@ -0,0 +1,99 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: tscodec.h
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef TSCODEC_H
+#define TSCODEC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "record.h"
+
+/*
+ * Time-series compression of records
+ *
+ * Records are compressed into self-contained blocks, so every block can be decoded on its own, e.g. after older flash
+ * sectors were erased. A block is a u16 little-endian record count followed by an MSB-first bit stream. The first
+ * record of a block is the reference for the following ones:
+ *
+ *   timestamp   32 raw bits, then the first delta as a zig-zag varint, then delta-of-delta:
+ *               '0' (unchanged), '10' + 7 bits, '110' + 9 bits, '1110' + 12 bits or '1111' + 32 bits (zig-zag)
+ *   integers    '0' if unchanged, else '1' + zig-zag varint of the delta (7 bits per group, MSB is continuation)
+ *   floats      Gorilla XOR with the previous value: '0' if equal, '10' + meaningful bits in the previous window,
+ *               '11' + 5 bits leading zeros + 5 bits length - 1 + meaningful bits
+ *
+ * The first value of every integer and float channel is encoded against 0. Channels are encoded in the declaration
+ * order of sensor_values_t, so the decoder must be built with the same enabled sensors, see channels.h.
+ */
+
+#define TSCODEC_HEADER_SIZE 2
+
+// Channels besides the timestamp, 13 integers and 9 floats with all sensors enabled
+#define TSCODEC_IS_FLOAT_u16 0
+#define TSCODEC_IS_FLOAT_u32 0
+#define TSCODEC_IS_FLOAT_f32 1
+#define TSCODEC_COUNT_FLOAT(field, type, column, unit, decimals) +TSCODEC_IS_FLOAT_##type
+#define TSCODEC_FLOAT_CHANNELS (0 RECORD_CHANNELS(TSCODEC_COUNT_FLOAT))
+#define TSCODEC_INT_CHANNELS (RECORD_CHANNEL_COUNT - 1 - TSCODEC_FLOAT_CHANNELS)
+
+// Worst case of one record: 40 bits timestamp, integers with 41 bits and floats with 44 bits
+#define TSCODEC_MAX_RECORD_SIZE ((40 + 41 * TSCODEC_INT_CHANNELS + 44 * TSCODEC_FLOAT_CHANNELS + 7) / 8)
+
+typedef struct {
+  uint8_t *buf;
+  size_t size;
+  size_t bit;
+  bool overflow; // Read past the end of a truncated block
+} tscodec_bits_t;
+
+typedef struct {
+  uint32_t timestamp;
+  int32_t delta;
+  uint32_t ints[TSCODEC_INT_CHANNELS];
+  uint32_t floats[TSCODEC_FLOAT_CHANNELS];
+  uint8_t leading[TSCODEC_FLOAT_CHANNELS];
+  uint8_t trailing[TSCODEC_FLOAT_CHANNELS];
+} tscodec_state_t;
+
+typedef struct {
+  tscodec_bits_t bits;
+  tscodec_state_t state;
+  uint16_t count; // Records encoded or decoded so far
+  uint16_t total; // Records in the block, decoder only
+} tscodec_t;
+
+void tscodec_init(tscodec_t *enc, uint8_t *buf, size_t size);
+int tscodec_encode(tscodec_t *enc, const sensor_values_t *record);
+size_t tscodec_finish(tscodec_t *enc);
+
+int tscodec_decode_init(tscodec_t *dec, const uint8_t *buf, size_t len);
+int tscodec_decode(tscodec_t *dec, sensor_values_t *record);
+
+#endif /* TSCODEC_H */
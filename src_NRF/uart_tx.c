@@ -0,0 +1,226 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: uart_tx.c
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <errno.h>
+
+#include <zephyr/device.h>
+#include <zephyr/kernel.h>
+
+#include <zephyr/drivers/uart.h>
+
+#include <zephyr/logging/log.h>
+
+#include "config.h"
+#include "uart_tx.h"
+
+LOG_MODULE_REGISTER(uart_tx, LOG_LEVEL_INF);
+
+/*
+ * Interrupt-driven transmit queue
+ *
+ * Submitted buffers are not copied, the interrupt callback fills the driver FIFO directly from the buffer of the
+ * caller. The buffer therefore has to stay valid until its completion callback ran. Received bytes are handed to the
+ * callback set with uart_tx_set_rx().
+ */
+
+typedef struct {
+  const uint8_t *buf;
+  size_t len;
+  uart_tx_cb_t cb;
+  void *user_data;
+} uart_tx_req_t;
+
+static const struct device *uart_tx_dev;
+static uart_rx_cb_t uart_rx_cb;
+
+static uart_tx_req_t uart_tx_queue[UART_TX_QUEUE_DEPTH];
+static uint32_t uart_tx_head = 0; // Next free slot
+static uint32_t uart_tx_tail = 0; // Request being transmitted
+static size_t uart_tx_offset = 0; // Bytes of the tail request already in the FIFO
+static size_t uart_tx_queued = 0; // Bytes not yet in the FIFO
+static struct k_spinlock uart_tx_lock;
+
+static uart_tx_stats_t uart_tx_stat;
+
+static void uart_tx_isr(const struct device *dev, void *user_data) {
+  ARG_UNUSED(user_data);
+
+  if (!uart_irq_update(dev)) {
+    return;
+  }
+
+  if (uart_irq_rx_ready(dev)) {
+    uint8_t buf[16];
+    int len;
+
+    while ((len = uart_fifo_read(dev, buf, sizeof(buf))) > 0) {
+      if (uart_rx_cb) {
+        uart_rx_cb(buf, len);
+      }
+    }
+  }
+
+  if (!uart_irq_tx_ready(dev)) {
+    return;
+  }
+
+  k_spinlock_key_t key = k_spin_lock(&uart_tx_lock);
+
+  while (uart_tx_tail != uart_tx_head) {
+    uart_tx_req_t *req = &uart_tx_queue[uart_tx_tail % UART_TX_QUEUE_DEPTH];
+    int filled = uart_fifo_fill(dev, req->buf + uart_tx_offset, req->len - uart_tx_offset);
+
+    if (filled <= 0) {
+      // FIFO full, continue on the next interrupt
+      break;
+    }
+    uart_tx_offset += filled;
+    uart_tx_queued -= filled;
+    uart_tx_stat.bytes += filled;
+
+    if (uart_tx_offset < req->len) {
+      break;
+    }
+
+    uart_tx_req_t done = *req;
+
+    uart_tx_tail++;
+    uart_tx_offset = 0;
+    uart_tx_stat.completed++;
+
+    // The slot is free again, the callback may submit the next buffer
+    k_spin_unlock(&uart_tx_lock, key);
+    if (done.cb) {
+      done.cb(done.buf, done.len, done.user_data);
+    }
+    key = k_spin_lock(&uart_tx_lock);
+  }
+
+  if (uart_tx_tail == uart_tx_head) {
+    uart_irq_tx_disable(dev);
+  }
+  k_spin_unlock(&uart_tx_lock, key);
+}
+
+/**
+ * @brief Installs the interrupt callback on the UART.
+ *
+ */
+int uart_tx_init(const struct device *dev) {
+  int rc;
+
+  if (!device_is_ready(dev)) {
+    return -ENODEV;
+  }
+
+  rc = uart_irq_callback_user_data_set(dev, uart_tx_isr, NULL);
+  if (rc) {
+    LOG_ERR("UART does not support interrupt-driven transmission (%d)", rc);
+    return rc;
+  }
+  uart_tx_dev = dev;
+  return 0;
+}
+
+/**
+ * @brief Queues a buffer for transmission without copying it.
+ *
+ * @param buf Data to transmit, must stay valid until cb is called
+ * @param len Length of the data
+ * @param cb Completion callback, may be NULL
+ * @param user_data Passed to the callback
+ * @return 0 on success, -EBUSY if the queue is full, -ENODEV if not initialized
+ */
+int uart_tx_submit(const uint8_t *buf, size_t len, uart_tx_cb_t cb, void *user_data) {
+  if (!uart_tx_dev) {
+    return -ENODEV;
+  }
+  if (len == 0) {
+    if (cb) {
+      cb(buf, len, user_data);
+    }
+    return 0;
+  }
+
+  k_spinlock_key_t key = k_spin_lock(&uart_tx_lock);
+
+  if (uart_tx_head - uart_tx_tail >= UART_TX_QUEUE_DEPTH) {
+    uart_tx_stat.rejected++;
+    k_spin_unlock(&uart_tx_lock, key);
+    return -EBUSY;
+  }
+
+  uart_tx_queue[uart_tx_head % UART_TX_QUEUE_DEPTH] = (uart_tx_req_t){
+      .buf = buf,
+      .len = len,
+      .cb = cb,
+      .user_data = user_data,
+  };
+  uart_tx_head++;
+  uart_tx_queued += len;
+  uart_tx_stat.submitted++;
+
+  k_spin_unlock(&uart_tx_lock, key);
+
+  // Enabling the interrupt triggers the callback as soon as the FIFO has space
+  uart_irq_tx_enable(uart_tx_dev);
+  return 0;
+}
+
+/**
+ * @brief Enables reception, cb is called from the interrupt callback with the received bytes.
+ *
+ */
+void uart_tx_set_rx(uart_rx_cb_t cb) {
+  uart_rx_cb = cb;
+  if (uart_tx_dev) {
+    uart_irq_rx_enable(uart_tx_dev);
+  }
+}
+
+/**
+ * @brief Returns whether a transmission is in progress.
+ *
+ */
+bool uart_tx_busy(void) { return uart_tx_head != uart_tx_tail; }
+
+/**
+ * @brief Returns the number of submitted bytes not yet handed to the driver.
+ *
+ * A growing value indicates that the host does not read fast enough.
+ */
+size_t uart_tx_pending(void) { return uart_tx_queued; }
+
+/**
+ * @brief Returns the number of free queue slots.
+ *
+ */
+uint32_t uart_tx_free(void) { return UART_TX_QUEUE_DEPTH - (uart_tx_head - uart_tx_tail); }
+
+const uart_tx_stats_t *uart_tx_stats(void) { return &uart_tx_stat; }
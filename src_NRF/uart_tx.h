@@ -0,0 +1,70 @@
+/*
+ * ----------------------------------------------------------------------
+ *
+ * File: uart_tx.h
+ *
+ * Last edited: 16.10.2026
+ *
+ * Copyright (c) 2026 ETH Zurich and University of Bologna
+ *
+ * Authors:
+ * - Philip Wiese (wiesep@iis.ee.ethz.ch), ETH Zurich
+ *
+ * ----------------------------------------------------------------------
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef UART_TX_H
+#define UART_TX_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <zephyr/device.h>
+
+/**
+ * @brief Called once a buffer was completely handed to the UART driver.
+ *
+ * Runs in the UART interrupt callback and must not block. Afterwards the buffer may be reused.
+ */
+typedef void (*uart_tx_cb_t)(const uint8_t *buf, size_t len, void *user_data);
+
+/**
+ * @brief Called with the bytes received from the host.
+ *
+ * Runs in the UART interrupt callback and must not block.
+ */
+typedef void (*uart_rx_cb_t)(const uint8_t *buf, size_t len);
+
+typedef struct {
+  uint32_t submitted; // Buffers accepted by uart_tx_submit
+  uint32_t completed; // Buffers completely transmitted
+  uint32_t rejected;  // Buffers rejected because the queue was full
+  uint32_t bytes;     // Bytes transmitted
+} uart_tx_stats_t;
+
+int uart_tx_init(const struct device *dev);
+int uart_tx_submit(const uint8_t *buf, size_t len, uart_tx_cb_t cb, void *user_data);
+void uart_tx_set_rx(uart_rx_cb_t cb);
+
+bool uart_tx_busy(void);
+size_t uart_tx_pending(void);
+uint32_t uart_tx_free(void);
+
+const uart_tx_stats_t *uart_tx_stats(void);
+
+#endif /* UART_TX_H */